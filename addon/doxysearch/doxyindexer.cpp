@@ -22,17 +22,32 @@
 #include <fstream>
 #include <iterator>
 #include <regex>
+#include <chrono>
+#include <algorithm>
 
 #include <sys/stat.h>
 
+#if USE_XAPIAN
 // Xapian include
 #include <xapian.h>
+#else
+#include "searchengine.h"
+#endif
 
 #include "version.h"
 #include "xml.h"
 
 #define MAX_TERM_LENGTH 245
 
+#if !USE_XAPIAN
+// the built-in engine mirrors the part of the Xapian API used below
+namespace Xapian
+{
+  using Document = SearchDocument;
+  using WritableDatabase = SearchIndexWriter;
+}
+#endif
+
 #if defined(_WIN32) && !defined(__CYGWIN__)
 static char pathSep = '\\';
 #else
@@ -87,6 +102,10 @@ static std::string reduce(const std::string& str,
 /** Adds all words in \a s to document \a doc with weight \a wfd */
 static void addWords(const std::string &s,Xapian::Document &doc,int wfd)
 {
+#if !USE_XAPIAN
+  // terms are case insensitive for the built-in engine
+  searchTokenize(s,[&doc,wfd](const std::string &word) { safeAddTerm(word,doc,wfd); });
+#else
   std::istringstream iss(s);
   std::istream_iterator<std::string> begin(iss),end,it;
   for (it=begin;it!=end;++it)
@@ -99,12 +118,13 @@ static void addWords(const std::string &s,Xapian::Document &doc,int wfd)
       safeAddTerm(lword,doc,wfd);
     }
   }
+#endif
 }
 
 /** Adds all identifiers in \a s to document \a doc with weight \a wfd */
 static void addIdentifiers(const std::string &s,Xapian::Document &doc,int wfd)
 {
-  std::regex id_re("[A-Z_a-z][A-Z_a-z0-9]*");
+  static const std::regex id_re("[A-Z_a-z][A-Z_a-z0-9]*");
   auto id_begin = std::sregex_iterator(s.begin(), s.end(), id_re);
   auto id_end   = std::sregex_iterator();
 
@@ -146,20 +166,32 @@ class XMLContentHandler
   public:
     /** Handler for parsing XML data */
     XMLContentHandler(const std::string &path)
+#if USE_XAPIAN
       : m_db(path+"doxysearch.db",Xapian::DB_CREATE_OR_OVERWRITE),
         m_stemmer("english")
+#else
+      : m_db(path+"doxysearch.db")
+#endif
     {
       m_curFieldName = UnknownField;
+#if USE_XAPIAN
       m_indexer.set_stemmer(m_stemmer);
       m_indexer.set_document(m_doc);
+#endif
     }
 
-    /** Free data handler */
-   ~XMLContentHandler()
+    /** Writes the index */
+    void commit()
     {
       m_db.commit();
     }
 
+    /** Returns the number of documents added so far */
+    size_t numDocuments() const
+    {
+      return m_numDocs;
+    }
+
     enum FieldNames
     {
       UnknownField = 0,
@@ -221,6 +253,7 @@ class XMLContentHandler
           }
         }
         m_db.add_document(m_doc);
+        m_numDocs++;
         m_doc.clear_values();
         m_doc.clear_terms();
       }
@@ -274,15 +307,19 @@ class XMLContentHandler
     // internal state
     Xapian::WritableDatabase m_db;
     Xapian::Document m_doc;
+#if USE_XAPIAN
     Xapian::TermGenerator m_indexer;
     Xapian::Stem m_stemmer;
+#endif
     std::string m_data;
     FieldNames m_curFieldName;
+    size_t m_numDocs = 0;
 };
 
 static void usage(const char *name, int exitVal = 1)
 {
-  std::cerr << "Usage: " << name << " [-o output_dir] searchdata.xml [searchdata2.xml ...]" << std::endl;
+  std::cerr << "Usage: " << name << " [-t] [-o output_dir] searchdata.xml [searchdata2.xml ...]" << std::endl;
+  std::cerr << "       -t  report the indexing throughput" << std::endl;
   exit(exitVal);
 }
 
@@ -313,6 +350,7 @@ int main(int argc,const char **argv)
     usage(argv[0]);
   }
   std::string outputDir;
+  bool timing=false;
   for (int i=1;i<argc;i++)
   {
     if (std::string(argv[i])=="-o")
@@ -333,6 +371,10 @@ int main(int argc,const char **argv)
         }
       }
     }
+    else if (std::string(argv[i])=="-t")
+    {
+      timing=true;
+    }
     else if (std::string(argv[i])=="-h" || std::string(argv[i])=="--help")
     {
       usage(argv[0],0);
@@ -356,25 +398,48 @@ int main(int argc,const char **argv)
     handlers.endElement   = [&contentHandler](const std::string &name)                                       { contentHandler.endElement(name);           };
     handlers.characters   = [&contentHandler](const std::string &chars)                                      { contentHandler.characters(chars);          };
     handlers.error        = [&contentHandler](const std::string &fileName,int lineNr,const std::string &msg) { contentHandler.error(fileName,lineNr,msg); };
+    auto startTime = std::chrono::steady_clock::now();
+    size_t inputSize = 0;
     for (int i=1;i<argc;i++)
     {
       if (std::string(argv[i])=="-o")
       {
         i++;
       }
+      else if (std::string(argv[i])=="-t")
+      {
+      }
       else
       {
         std::cout << "Processing " << argv[i] << "..." << std::endl;
         std::string inputStr = fileToString(argv[i]);
+        inputSize += inputStr.length();
         XMLParser parser(handlers);
         parser.parse(argv[i],inputStr.c_str(),false,[](){},[](){});
       }
     }
+    contentHandler.commit();
+    if (timing)
+    {
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-startTime;
+      double secs = std::max(elapsed.count(),1e-9);
+      std::cout << "Indexed " << contentHandler.numDocuments() << " documents ("
+                << inputSize/1024 << " KB) in " << secs << " seconds: "
+                << static_cast<double>(contentHandler.numDocuments())/secs << " documents/s, "
+                << static_cast<double>(inputSize)/(1024.0*1024.0)/secs << " MB/s" << std::endl;
+    }
   }
+#if USE_XAPIAN
   catch(const Xapian::Error &e)
   {
     std::cerr << "Caught exception: " << e.get_description() << std::endl;
   }
+#else
+  catch(const SearchError &e)
+  {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+  }
+#endif
   catch(...)
   {
     std::cerr << "Caught an unknown exception" << std::endl;
@@ -23,9 +23,14 @@
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <chrono>
 
+#if USE_XAPIAN
 // Xapian includes
 #include <xapian.h>
+#else
+#include "searchengine.h"
+#endif
 
 #include "version.h"
 
@@ -312,9 +317,77 @@ static void usage(const char *name, int exitVal = 1)
 {
   std::cerr << "Usage: " << name << "[query_string]" << std::endl;
   std::cerr << "       " << "alternatively the query string can be given by the environment variable QUERY_STRING" << std::endl;
+#if !USE_XAPIAN
+  std::cerr << "       " << name << " --benchmark query_file [repeat]" << std::endl;
+  std::cerr << "       " << "runs each line of query_file as a query and reports the query throughput" << std::endl;
+#endif
   exit(exitVal);
 }
 
+#if !USE_XAPIAN
+/** Runs the queries found in \a queryFile \a repeat times against the index in the
+ *  index directory \a indexDir and reports the throughput.
+ */
+static int benchmark(const std::string &indexDir,const std::string &queryFile,int repeat)
+{
+  std::vector<std::string> queries;
+  std::ifstream f(queryFile);
+  if (!f.is_open())
+  {
+    std::cerr << "Error: cannot open query file " << queryFile << std::endl;
+    return 1;
+  }
+  std::string line;
+  while (getline(f,line))
+  {
+    if (!line.empty()) queries.push_back(line);
+  }
+  if (queries.empty())
+  {
+    std::cerr << "Error: no queries found in " << queryFile << std::endl;
+    return 1;
+  }
+
+  auto openStart = std::chrono::steady_clock::now();
+  SearchIndexReader db(indexDir);
+  std::chrono::duration<double> openTime = std::chrono::steady_clock::now()-openStart;
+
+  std::vector<double> latencies;
+  std::vector<SearchMatch> matches;
+  size_t totalHits=0;
+  size_t valueBytes=0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r=0;r<repeat;r++)
+  {
+    for (const auto &query : queries)
+    {
+      auto qs = std::chrono::steady_clock::now();
+      totalHits += db.search(query,0,20,matches);
+      // fetch the stored values as a real request would do
+      for (const auto &m : matches)
+      {
+        valueBytes += db.value(m.docId,FIELD_NAME).length()+db.value(m.docId,FIELD_DOC).length();
+      }
+      std::chrono::duration<double> qt = std::chrono::steady_clock::now()-qs;
+      latencies.push_back(qt.count());
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start;
+  std::sort(latencies.begin(),latencies.end());
+  double secs = std::max(elapsed.count(),1e-9);
+  auto percentile = [&latencies](double pct) { return latencies[static_cast<size_t>(pct*(latencies.size()-1))]*1000.0; };
+  std::cout << "Index: " << db.numDocuments() << " documents, " << db.numTerms() << " terms, opened in "
+            << openTime.count()*1000.0 << " ms" << std::endl;
+  std::cout << "Ran " << latencies.size() << " queries in " << secs << " seconds: "
+            << static_cast<double>(latencies.size())/secs << " queries/s" << std::endl;
+  std::cout << "Latency: median " << percentile(0.5) << " ms, 99th percentile " << percentile(0.99)
+            << " ms, max " << latencies.back()*1000.0 << " ms" << std::endl;
+  std::cout << "Average hits per query: " << static_cast<double>(totalHits)/static_cast<double>(latencies.size())
+            << ", stored data fetched: " << valueBytes/1024 << " KB" << std::endl;
+  return 0;
+}
+#endif
+
 /** Main routine */
 int main(int argc,char **argv)
 {
@@ -351,6 +424,13 @@ int main(int argc,char **argv)
         queryString = argv[1];
       }
     }
+#if !USE_XAPIAN
+    else if ((argc == 3 || argc == 4) && std::string(argv[1])=="--benchmark")
+    {
+      int repeat = argc==4 ? fromString<int>(argv[3]) : 1;
+      return benchmark("doxysearch.db",argv[2],std::max(repeat,1));
+    }
+#endif
     else
     {
       usage(argv[0]);
@@ -390,11 +470,12 @@ int main(int argc,char **argv)
       exit(0);
     }
 
+    std::vector<std::string> words = split(searchFor,' ');
+#if USE_XAPIAN
     // create query
     Xapian::Database db(indexDir);
     Xapian::Enquire enquire(db);
 
-    std::vector<std::string> words = split(searchFor,' ');
     Xapian::QueryParser parser;
     parser.set_database(db);
     parser.set_default_op(Xapian::Query::OP_AND);
@@ -416,6 +497,11 @@ int main(int argc,char **argv)
     // get results
     Xapian::MSet matches = enquire.get_mset(page*num,num);
     unsigned int hits    = matches.get_matches_estimated();
+#else
+    SearchIndexReader db(indexDir);
+    std::vector<SearchMatch> matches;
+    unsigned int hits    = static_cast<unsigned int>(db.search(searchFor,page*num,num,matches));
+#endif
     unsigned int offset  = page*num;
     unsigned int pages   = num>0 ? (hits+num-1)/num : 0;
     if (offset>hits)     offset=hits;
@@ -433,15 +519,22 @@ int main(int argc,char **argv)
               << "  \"items\":[" << std::endl;
     // foreach search result
     unsigned int o = offset;
+#if USE_XAPIAN
     for (Xapian::MSetIterator i = matches.begin(); i != matches.end(); ++i,++o)
     {
-      std::vector<Fragment> hl;
       Xapian::Document doc = i.get_document();
-      highlighter(doc.get_value(FIELD_DOC),words,hl);
-      std::cout << "  {\"type\": \"" << doc.get_value(FIELD_TYPE) << "\"," << std::endl
-                << "   \"name\": \"" << doc.get_value(FIELD_NAME) << escapeString(doc.get_value(FIELD_ARGS)) << "\"," << std::endl
-                << "   \"tag\": \""  << doc.get_value(FIELD_TAG) << "\"," << std::endl
-                << "   \"url\": \""  << doc.get_value(FIELD_URL) << "\"," << std::endl;
+      auto value = [&doc](int field) { return doc.get_value(field); };
+#else
+    for (auto i = matches.begin(); i != matches.end(); ++i,++o)
+    {
+      auto value = [&db,&i](int field) { return db.value(i->docId,field); };
+#endif
+      std::vector<Fragment> hl;
+      highlighter(value(FIELD_DOC),words,hl);
+      std::cout << "  {\"type\": \"" << value(FIELD_TYPE) << "\"," << std::endl
+                << "   \"name\": \"" << value(FIELD_NAME) << escapeString(value(FIELD_ARGS)) << "\"," << std::endl
+                << "   \"tag\": \""  << value(FIELD_TAG) << "\"," << std::endl
+                << "   \"url\": \""  << value(FIELD_URL) << "\"," << std::endl;
       std::cout << "   \"fragments\":[" << std::endl;
       int c=0;
       bool first=true;
@@ -459,10 +552,17 @@ int main(int argc,char **argv)
     }
     std::cout << " ]" << std::endl << "})" << std::endl;
   }
+#if USE_XAPIAN
   catch (const Xapian::Error &e) // Xapian exception
   {
     showError(callback,e.get_description());
   }
+#else
+  catch (const SearchError &e) // search index exception
+  {
+    showError(callback,e.what());
+  }
+#endif
   catch (...) // Any other exception
   {
     showError(callback,"Unknown Exception!");
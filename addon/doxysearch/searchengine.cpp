@@ -0,0 +1,685 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "searchengine.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//---------------------------------------------------------------------------------------------
+// segment file layout
+
+static const char   g_segmentMagic[8] = { 'D','X','S','E','G','\0','\0','\1' };
+static const uint32_t g_byteOrderMark = 0x01020304;
+static const uint32_t g_segmentVersion = 1;
+
+/** Header at the start of the segment file, all offsets are relative to the start of the file. */
+struct SegmentHeader
+{
+  char     magic[8];
+  uint32_t byteOrder;
+  uint32_t version;
+  uint32_t numDocs;
+  uint32_t numTerms;
+  uint64_t totalDocLength;
+  uint64_t termsOffset;     // SegmentTerm[numTerms], sorted on term
+  uint64_t stringsOffset;   // characters of the terms
+  uint64_t postingsOffset;  // SegmentPosting[], one list per term, sorted on document id
+  uint64_t docsOffset;      // SegmentDoc[numDocs]
+  uint64_t valuesOffset;    // stored values: per value a uint32_t length followed by the data
+  uint64_t fileSize;
+};
+
+/** Entry in the term dictionary */
+struct SegmentTerm
+{
+  uint64_t postings;        // index of the first posting
+  uint32_t string;          // offset of the term in the string area
+  uint32_t length;          // length of the term
+  uint32_t docFreq;         // number of postings
+  uint32_t reserved;
+};
+
+/** Entry in a posting list */
+struct SegmentPosting
+{
+  uint32_t docId;
+  uint32_t wdf;
+};
+
+/** Entry in the document table */
+struct SegmentDoc
+{
+  uint64_t values;          // offset of the first value in the value area
+  uint32_t length;          // sum of the wdf of all terms of the document
+  uint32_t numValues;
+};
+
+static uint64_t alignOffset(uint64_t offset)
+{
+  return (offset+7)&~static_cast<uint64_t>(7);
+}
+
+//---------------------------------------------------------------------------------------------
+// tokenizer
+
+static inline bool isWordChar(unsigned char c)
+{
+  return (c>='a' && c<='z') || (c>='A' && c<='Z') || (c>='0' && c<='9') || c=='_' || c>=0x80;
+}
+
+static inline char toLowerAscii(char c)
+{
+  return (c>='A' && c<='Z') ? static_cast<char>(c+'a'-'A') : c;
+}
+
+std::string searchToLower(const std::string &s)
+{
+  std::string result(s);
+  for (char &c : result) c = toLowerAscii(c);
+  return result;
+}
+
+void searchTokenize(const std::string &s,const std::function<void(const std::string &)> &func)
+{
+  size_t len = s.length();
+  size_t i=0;
+  std::string word;
+  while (i<len)
+  {
+    while (i<len && !isWordChar(static_cast<unsigned char>(s[i]))) i++;
+    word.clear();
+    while (i<len && isWordChar(static_cast<unsigned char>(s[i])))
+    {
+      word+=toLowerAscii(s[i]);
+      i++;
+    }
+    if (!word.empty())
+    {
+      func(word);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------------------------
+// SearchDocument
+
+void SearchDocument::add_value(int slot,const std::string &value)
+{
+  if (slot<0) return;
+  if (static_cast<size_t>(slot)>=m_values.size())
+  {
+    m_values.resize(slot+1);
+  }
+  m_values[slot] = value;
+}
+
+std::string SearchDocument::get_value(int slot) const
+{
+  return slot>=0 && static_cast<size_t>(slot)<m_values.size() ? m_values[slot] : std::string();
+}
+
+void SearchDocument::add_term(const std::string &term,int wdf)
+{
+  if (term.empty() || term.length()>SEARCH_MAX_TERM_LENGTH || wdf<=0) return;
+  m_terms[searchToLower(term)] += static_cast<uint32_t>(wdf);
+}
+
+//---------------------------------------------------------------------------------------------
+// SearchIndexWriter
+
+struct SearchIndexWriter::Private
+{
+  std::string dbDir;
+  std::unordered_map<std::string,uint32_t> termIds;
+  std::vector<std::vector<SegmentPosting>> postings; // indexed by term id
+  std::vector<SegmentDoc> docs;
+  std::string values;
+  uint64_t totalDocLength = 0;
+};
+
+static void makeDir(const std::string &dir)
+{
+#ifdef _WIN32
+  _mkdir(dir.c_str());
+#else
+  mkdir(dir.c_str(),0755);
+#endif
+}
+
+SearchIndexWriter::SearchIndexWriter(const std::string &dbDir) : p(std::make_unique<Private>())
+{
+  p->dbDir = dbDir;
+  makeDir(dbDir);
+}
+
+SearchIndexWriter::~SearchIndexWriter() = default;
+
+size_t SearchIndexWriter::numDocuments() const
+{
+  return p->docs.size();
+}
+
+size_t SearchIndexWriter::numTerms() const
+{
+  return p->termIds.size();
+}
+
+void SearchIndexWriter::add_document(const SearchDocument &doc)
+{
+  uint32_t docId = static_cast<uint32_t>(p->docs.size());
+  SegmentDoc sd;
+  sd.values    = p->values.size();
+  sd.length    = 0;
+  sd.numValues = static_cast<uint32_t>(doc.values().size());
+  for (const auto &v : doc.values())
+  {
+    uint32_t len = static_cast<uint32_t>(v.length());
+    p->values.append(reinterpret_cast<const char*>(&len),sizeof(len));
+    p->values.append(v);
+  }
+  for (const auto &kv : doc.terms())
+  {
+    auto it = p->termIds.find(kv.first);
+    uint32_t termId = 0;
+    if (it==p->termIds.end())
+    {
+      termId = static_cast<uint32_t>(p->postings.size());
+      p->termIds.emplace(kv.first,termId);
+      p->postings.emplace_back();
+    }
+    else
+    {
+      termId = it->second;
+    }
+    p->postings[termId].push_back(SegmentPosting{docId,kv.second});
+    sd.length += kv.second;
+  }
+  p->totalDocLength += sd.length;
+  p->docs.push_back(sd);
+}
+
+void SearchIndexWriter::commit()
+{
+  // sort the dictionary so the reader can do binary and prefix searches
+  std::vector<const std::pair<const std::string,uint32_t>*> sortedTerms;
+  sortedTerms.reserve(p->termIds.size());
+  for (const auto &kv : p->termIds) sortedTerms.push_back(&kv);
+  std::sort(sortedTerms.begin(),sortedTerms.end(),
+            [](const auto *t1,const auto *t2) { return t1->first < t2->first; });
+
+  SegmentHeader header;
+  memcpy(header.magic,g_segmentMagic,sizeof(header.magic));
+  header.byteOrder      = g_byteOrderMark;
+  header.version        = g_segmentVersion;
+  header.numDocs        = static_cast<uint32_t>(p->docs.size());
+  header.numTerms       = static_cast<uint32_t>(sortedTerms.size());
+  header.totalDocLength = p->totalDocLength;
+
+  std::vector<SegmentTerm> terms;
+  terms.reserve(sortedTerms.size());
+  std::string strings;
+  uint64_t numPostings=0;
+  for (const auto *kv : sortedTerms)
+  {
+    SegmentTerm st;
+    st.postings = numPostings;
+    st.string   = static_cast<uint32_t>(strings.size());
+    st.length   = static_cast<uint32_t>(kv->first.length());
+    st.docFreq  = static_cast<uint32_t>(p->postings[kv->second].size());
+    st.reserved = 0;
+    strings+=kv->first;
+    numPostings+=st.docFreq;
+    terms.push_back(st);
+  }
+
+  header.termsOffset    = alignOffset(sizeof(SegmentHeader));
+  header.stringsOffset  = alignOffset(header.termsOffset+terms.size()*sizeof(SegmentTerm));
+  header.postingsOffset = alignOffset(header.stringsOffset+strings.size());
+  header.docsOffset     = alignOffset(header.postingsOffset+numPostings*sizeof(SegmentPosting));
+  header.valuesOffset   = alignOffset(header.docsOffset+p->docs.size()*sizeof(SegmentDoc));
+  header.fileSize       = header.valuesOffset+p->values.size();
+
+  std::string fileName = p->dbDir+"/" SEARCH_SEGMENT_NAME;
+  std::string tmpName  = fileName+".tmp";
+  {
+    std::ofstream f(tmpName,std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!f.is_open())
+    {
+      throw SearchError("cannot open "+tmpName+" for writing");
+    }
+    uint64_t pos = 0;
+    auto write = [&f,&pos](const void *data,size_t size)
+    {
+      f.write(static_cast<const char*>(data),static_cast<std::streamsize>(size));
+      pos+=size;
+    };
+    auto pad = [&f,&pos](uint64_t offset)
+    {
+      static const char zeros[8] = {};
+      f.write(zeros,static_cast<std::streamsize>(offset-pos));
+      pos=offset;
+    };
+    write(&header,sizeof(header));
+    pad(header.termsOffset);
+    write(terms.data(),terms.size()*sizeof(SegmentTerm));
+    pad(header.stringsOffset);
+    write(strings.data(),strings.size());
+    pad(header.postingsOffset);
+    for (const auto *kv : sortedTerms)
+    {
+      const auto &pl = p->postings[kv->second];
+      write(pl.data(),pl.size()*sizeof(SegmentPosting));
+    }
+    pad(header.docsOffset);
+    write(p->docs.data(),p->docs.size()*sizeof(SegmentDoc));
+    pad(header.valuesOffset);
+    write(p->values.data(),p->values.size());
+    if (!f.good())
+    {
+      throw SearchError("error writing "+tmpName);
+    }
+  }
+#ifdef _WIN32
+  if (!MoveFileExA(tmpName.c_str(),fileName.c_str(),MOVEFILE_REPLACE_EXISTING))
+#else
+  if (rename(tmpName.c_str(),fileName.c_str())!=0)
+#endif
+  {
+    throw SearchError("cannot rename "+tmpName+" to "+fileName);
+  }
+}
+
+//---------------------------------------------------------------------------------------------
+// SearchIndexReader
+
+/** Read-only memory mapping of a file */
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string &fileName)
+    {
+#ifdef _WIN32
+      m_file = CreateFileA(fileName.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,
+                           OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+      if (m_file==INVALID_HANDLE_VALUE) throw SearchError("cannot open "+fileName);
+      LARGE_INTEGER size;
+      if (!GetFileSizeEx(m_file,&size)) throw SearchError("cannot determine size of "+fileName);
+      m_size = static_cast<size_t>(size.QuadPart);
+      if (m_size==0) return;
+      m_mapping = CreateFileMappingA(m_file,nullptr,PAGE_READONLY,0,0,nullptr);
+      if (m_mapping==nullptr) throw SearchError("cannot map "+fileName);
+      m_data = static_cast<const char *>(MapViewOfFile(m_mapping,FILE_MAP_READ,0,0,0));
+      if (m_data==nullptr) throw SearchError("cannot map "+fileName);
+#else
+      m_fd = open(fileName.c_str(),O_RDONLY);
+      if (m_fd==-1) throw SearchError("cannot open "+fileName);
+      struct stat st = {};
+      if (fstat(m_fd,&st)!=0) throw SearchError("cannot determine size of "+fileName);
+      m_size = static_cast<size_t>(st.st_size);
+      if (m_size==0) return;
+      void *data = mmap(nullptr,m_size,PROT_READ,MAP_SHARED,m_fd,0);
+      if (data==MAP_FAILED) throw SearchError("cannot map "+fileName);
+      m_data = static_cast<const char *>(data);
+#endif
+    }
+   ~MappedFile()
+    {
+#ifdef _WIN32
+      if (m_data)    UnmapViewOfFile(m_data);
+      if (m_mapping) CloseHandle(m_mapping);
+      if (m_file!=INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+      if (m_data)    munmap(const_cast<char*>(m_data),m_size);
+      if (m_fd!=-1)  close(m_fd);
+#endif
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+  private:
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+/** Maximum number of terms a prefix is expanded to, the most frequent ones are kept. */
+static const size_t g_maxPrefixExpansion = 100;
+
+// BM25 parameters
+static const double g_bm25_k1 = 1.2;
+static const double g_bm25_b  = 0.75;
+
+struct SearchIndexReader::Private
+{
+  explicit Private(const std::string &fileName) : file(fileName) {}
+  MappedFile file;
+  SegmentHeader header;
+  const SegmentTerm    *terms    = nullptr;
+  const char           *strings  = nullptr;
+  const SegmentPosting *postings = nullptr;
+  const SegmentDoc     *docs     = nullptr;
+  const char           *values   = nullptr;
+  uint64_t stringsSize = 0;
+  uint64_t numPostings = 0;
+  uint64_t valuesSize  = 0;
+  double avgDocLength = 1.0;
+
+  /** Returns term \a index after checking that its string and posting list are inside the file */
+  const SegmentTerm &term(uint32_t index) const
+  {
+    const SegmentTerm &t = terms[index];
+    if (static_cast<uint64_t>(t.string)+t.length>stringsSize ||
+        t.postings>numPostings || t.docFreq>numPostings-t.postings)
+    {
+      throw SearchError("search index is corrupt: term "+std::to_string(index)+" is out of range");
+    }
+    return t;
+  }
+
+  std::string termString(uint32_t index) const
+  {
+    const SegmentTerm &t = term(index);
+    return std::string(strings+t.string,t.length);
+  }
+
+  int compareTerm(uint32_t index,const std::string &word,bool prefix) const
+  {
+    const SegmentTerm &t = term(index);
+    size_t wl = word.length();
+    size_t n  = prefix ? std::min<size_t>(t.length,wl) : t.length;
+    int r = memcmp(strings+t.string,word.data(),std::min<size_t>(n,wl));
+    if (r!=0 || prefix) return r;
+    return t.length<wl ? -1 : t.length>wl ? 1 : 0;
+  }
+
+  /** Returns the first term index that is not smaller than \a word */
+  uint32_t lowerBound(const std::string &word) const
+  {
+    uint32_t lo=0, hi=header.numTerms;
+    while (lo<hi)
+    {
+      uint32_t mid = lo+(hi-lo)/2;
+      if (compareTerm(mid,word,false)<0) lo=mid+1; else hi=mid;
+    }
+    return lo;
+  }
+
+  /** Collects the term indices matching \a word, either exactly or as a prefix */
+  void lookup(const std::string &word,bool prefix,std::vector<uint32_t> &result) const
+  {
+    uint32_t i = lowerBound(word);
+    if (!prefix)
+    {
+      if (i<header.numTerms && compareTerm(i,word,false)==0) result.push_back(i);
+      return;
+    }
+    for (;i<header.numTerms && terms[i].length>=word.length() && compareTerm(i,word,true)==0;i++)
+    {
+      result.push_back(i);
+    }
+    if (result.size()>g_maxPrefixExpansion)
+    {
+      std::partial_sort(result.begin(),result.begin()+g_maxPrefixExpansion,result.end(),
+          [this](uint32_t t1,uint32_t t2) { return terms[t1].docFreq>terms[t2].docFreq; });
+      result.resize(g_maxPrefixExpansion);
+    }
+  }
+
+  /** Returns the matches for a set of alternative terms, sorted on document id.
+   *  A document matching several alternatives gets the score of the best one.
+   */
+  std::vector<SearchMatch> scoreTerms(const std::vector<uint32_t> &termIndices) const
+  {
+    std::vector<SearchMatch> result;
+    double n = header.numDocs;
+    for (uint32_t ti : termIndices)
+    {
+      const SegmentTerm &t = term(ti);
+      double df  = t.docFreq;
+      double idf = std::log(1.0+(n-df+0.5)/(df+0.5));
+      const SegmentPosting *pl = postings+t.postings;
+      for (uint32_t i=0;i<t.docFreq;i++)
+      {
+        if (pl[i].docId>=header.numDocs)
+        {
+          throw SearchError("search index is corrupt: posting of term "+std::to_string(ti)+" is out of range");
+        }
+        double wdf = pl[i].wdf;
+        double dl  = docs[pl[i].docId].length;
+        double score = idf*wdf*(g_bm25_k1+1.0)/(wdf+g_bm25_k1*(1.0-g_bm25_b+g_bm25_b*dl/avgDocLength));
+        result.push_back(SearchMatch{pl[i].docId,score});
+      }
+    }
+    if (termIndices.size()>1)
+    {
+      std::sort(result.begin(),result.end(),
+                [](const SearchMatch &m1,const SearchMatch &m2) { return m1.docId<m2.docId; });
+      size_t j=0;
+      for (size_t i=0;i<result.size();i++)
+      {
+        if (j>0 && result[j-1].docId==result[i].docId)
+        {
+          result[j-1].score = std::max(result[j-1].score,result[i].score);
+        }
+        else
+        {
+          result[j++] = result[i];
+        }
+      }
+      result.resize(j);
+    }
+    return result;
+  }
+};
+
+SearchIndexReader::SearchIndexReader(const std::string &dbDir)
+  : p(std::make_unique<Private>(dbDir+"/" SEARCH_SEGMENT_NAME))
+{
+  const char *data = p->file.data();
+  size_t size = p->file.size();
+  if (data==nullptr || size<sizeof(SegmentHeader))
+  {
+    throw SearchError("search index "+dbDir+" is empty or truncated");
+  }
+  memcpy(&p->header,data,sizeof(SegmentHeader));
+  const SegmentHeader &h = p->header;
+  if (memcmp(h.magic,g_segmentMagic,sizeof(h.magic))!=0 || h.byteOrder!=g_byteOrderMark)
+  {
+    throw SearchError("search index "+dbDir+" has an unknown format");
+  }
+  if (h.version!=g_segmentVersion)
+  {
+    throw SearchError("search index "+dbDir+" has an unsupported version, please rerun doxyindexer");
+  }
+  if (h.fileSize!=size || h.valuesOffset>size)
+  {
+    throw SearchError("search index "+dbDir+" is truncated");
+  }
+  // the sections must be aligned, in order, and large enough for their tables;
+  // the individual entries are checked when they are used
+  auto aligned = [](uint64_t offset) { return offset==alignOffset(offset); };
+  if (!aligned(h.termsOffset) || !aligned(h.postingsOffset) || !aligned(h.docsOffset) ||
+      h.termsOffset<sizeof(SegmentHeader) ||
+      h.stringsOffset<h.termsOffset || h.postingsOffset<h.stringsOffset ||
+      h.docsOffset<h.postingsOffset || h.valuesOffset<h.docsOffset ||
+      (h.stringsOffset-h.termsOffset)/sizeof(SegmentTerm)<h.numTerms ||
+      (h.valuesOffset-h.docsOffset)/sizeof(SegmentDoc)<h.numDocs)
+  {
+    throw SearchError("search index "+dbDir+" is corrupt");
+  }
+  p->stringsSize = h.postingsOffset-h.stringsOffset;
+  p->numPostings = (h.docsOffset-h.postingsOffset)/sizeof(SegmentPosting);
+  p->valuesSize  = h.fileSize-h.valuesOffset;
+  p->terms    = reinterpret_cast<const SegmentTerm*>   (data+h.termsOffset);
+  p->strings  =                                          data+h.stringsOffset;
+  p->postings = reinterpret_cast<const SegmentPosting*>(data+h.postingsOffset);
+  p->docs     = reinterpret_cast<const SegmentDoc*>    (data+h.docsOffset);
+  p->values   =                                          data+h.valuesOffset;
+  if (h.numDocs>0)
+  {
+    p->avgDocLength = std::max(1.0,static_cast<double>(h.totalDocLength)/h.numDocs);
+  }
+}
+
+SearchIndexReader::~SearchIndexReader() = default;
+
+uint32_t SearchIndexReader::numDocuments() const
+{
+  return p->header.numDocs;
+}
+
+uint32_t SearchIndexReader::numTerms() const
+{
+  return p->header.numTerms;
+}
+
+std::string SearchIndexReader::term(uint32_t termIndex) const
+{
+  return termIndex<p->header.numTerms ? p->termString(termIndex) : std::string();
+}
+
+std::string SearchIndexReader::value(uint32_t docId,int slot) const
+{
+  if (docId>=p->header.numDocs || slot<0) return std::string();
+  const SegmentDoc &d = p->docs[docId];
+  if (static_cast<uint32_t>(slot)>=d.numValues) return std::string();
+  uint64_t pos = d.values;
+  for (int i=0;;i++)
+  {
+    uint32_t len = 0;
+    if (pos>p->valuesSize || sizeof(len)>p->valuesSize-pos)
+    {
+      throw SearchError("search index is corrupt: value of document "+std::to_string(docId)+" is out of range");
+    }
+    memcpy(&len,p->values+pos,sizeof(len));
+    pos+=sizeof(len);
+    if (len>p->valuesSize-pos)
+    {
+      throw SearchError("search index is corrupt: value of document "+std::to_string(docId)+" is out of range");
+    }
+    if (i==slot) return std::string(p->values+pos,len);
+    pos+=len;
+  }
+}
+
+size_t SearchIndexReader::search(const std::string &query,size_t offset,size_t count,
+                                 std::vector<SearchMatch> &matches) const
+{
+  matches.clear();
+
+  // split the query in words, each word becomes a clause that must match
+  struct Clause
+  {
+    std::string word;
+    bool prefix;
+  };
+  std::vector<Clause> clauses;
+  size_t i=0, len=query.length();
+  while (i<len)
+  {
+    while (i<len && isspace(static_cast<unsigned char>(query[i]))) i++;
+    size_t s=i;
+    while (i<len && !isspace(static_cast<unsigned char>(query[i]))) i++;
+    if (i>s)
+    {
+      std::string word = searchToLower(query.substr(s,i-s));
+      bool prefix = word.back()=='*';
+      if (prefix) word.pop_back();
+      // terms with punctuation, such as qualified names, are indexed as a whole
+      std::vector<uint32_t> exact;
+      p->lookup(word,false,exact);
+      if (!exact.empty() || word.empty())
+      {
+        if (!word.empty()) clauses.push_back(Clause{word,prefix});
+      }
+      else
+      {
+        searchTokenize(word,[&clauses](const std::string &w) { clauses.push_back(Clause{w,false}); });
+        if (prefix && !clauses.empty()) clauses.back().prefix=true;
+      }
+    }
+  }
+  if (clauses.empty()) return 0;
+  clauses.back().prefix = true; // search as you type
+
+  // score each clause and intersect the results
+  std::vector<SearchMatch> result;
+  bool first=true;
+  for (const auto &clause : clauses)
+  {
+    std::vector<uint32_t> termIndices;
+    p->lookup(clause.word,clause.prefix,termIndices);
+    std::vector<SearchMatch> clauseMatches = p->scoreTerms(termIndices);
+    if (first)
+    {
+      result = std::move(clauseMatches);
+      first = false;
+    }
+    else
+    {
+      std::vector<SearchMatch> merged;
+      auto it1 = result.begin();
+      auto it2 = clauseMatches.begin();
+      while (it1!=result.end() && it2!=clauseMatches.end())
+      {
+        if      (it1->docId<it2->docId) ++it1;
+        else if (it2->docId<it1->docId) ++it2;
+        else
+        {
+          merged.push_back(SearchMatch{it1->docId,it1->score+it2->score});
+          ++it1; ++it2;
+        }
+      }
+      result = std::move(merged);
+    }
+    if (result.empty()) return 0;
+  }
+
+  // rank
+  size_t hits = result.size();
+  size_t end  = std::min(hits,offset+count);
+  if (offset<end)
+  {
+    auto better = [](const SearchMatch &m1,const SearchMatch &m2)
+    {
+      return m1.score>m2.score || (m1.score==m2.score && m1.docId<m2.docId);
+    };
+    std::partial_sort(result.begin(),result.begin()+end,result.end(),better);
+    matches.assign(result.begin()+offset,result.begin()+end);
+  }
+  return hits;
+}
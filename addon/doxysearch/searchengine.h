@@ -0,0 +1,148 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef SEARCHENGINE_H
+#define SEARCHENGINE_H
+
+/** @file
+ *  @brief Built-in inverted index used by doxyindexer and doxysearch when
+ *  they are built without Xapian.
+ *
+ *  The index is a single segment file inside the `doxysearch.db` directory.
+ *  It holds a sorted term dictionary, the posting lists (document id and
+ *  within document frequency), and the stored field values of each document.
+ *  The reader memory-maps the segment, so a CGI invocation only touches the
+ *  pages needed for the query.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/** Name of the segment file inside the search database directory. */
+#define SEARCH_SEGMENT_NAME "index.seg"
+
+/** Maximum length of a term, longer terms are not indexed. */
+#define SEARCH_MAX_TERM_LENGTH 245
+
+/** Exception thrown when the index cannot be written or read. */
+class SearchError : public std::runtime_error
+{
+  public:
+    explicit SearchError(const std::string &msg) : std::runtime_error(msg) {}
+};
+
+/** Returns \a s with all ASCII characters converted to lower case.
+ *  Bytes belonging to multi-byte UTF-8 sequences are left untouched.
+ */
+std::string searchToLower(const std::string &s);
+
+/** Splits \a s into lower case words and calls \a func for each of them.
+ *  A word is a sequence of letters, digits, underscores and non-ASCII characters.
+ */
+void searchTokenize(const std::string &s,const std::function<void(const std::string &)> &func);
+
+/** A document to be added to the index.
+ *
+ *  The interface mirrors the subset of Xapian::Document used by doxyindexer,
+ *  so the indexer code is the same for both back-ends.
+ */
+class SearchDocument
+{
+  public:
+    /** Stores \a value in \a slot. Values are returned as-is for the search results. */
+    void add_value(int slot,const std::string &value);
+    /** Returns the value stored in \a slot or an empty string. */
+    std::string get_value(int slot) const;
+    /** Adds \a term with within document frequency \a wdf. Terms are case insensitive. */
+    void add_term(const std::string &term,int wdf);
+    void clear_values() { m_values.clear(); }
+    void clear_terms()  { m_terms.clear();  }
+
+    const std::vector<std::string> &values() const { return m_values; }
+    const std::unordered_map<std::string,uint32_t> &terms() const { return m_terms; }
+
+  private:
+    std::vector<std::string> m_values;
+    std::unordered_map<std::string,uint32_t> m_terms;
+};
+
+/** Collects documents in memory and writes them as a segment file on commit(). */
+class SearchIndexWriter
+{
+  public:
+    /** Creates a writer for the database directory \a dbDir. The directory is created if needed. */
+    explicit SearchIndexWriter(const std::string &dbDir);
+   ~SearchIndexWriter();
+    SearchIndexWriter(const SearchIndexWriter &) = delete;
+    SearchIndexWriter &operator=(const SearchIndexWriter &) = delete;
+
+    void add_document(const SearchDocument &doc);
+    /** Writes the segment file. The old index is replaced atomically. */
+    void commit();
+
+    size_t numDocuments() const;
+    size_t numTerms() const;
+
+  private:
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+/** A single match returned by SearchIndexReader::search() */
+struct SearchMatch
+{
+  uint32_t docId;
+  double   score;
+};
+
+/** Read-only view on a memory-mapped segment file. */
+class SearchIndexReader
+{
+  public:
+    /** Opens the index in database directory \a dbDir. Throws SearchError on failure. */
+    explicit SearchIndexReader(const std::string &dbDir);
+   ~SearchIndexReader();
+    SearchIndexReader(const SearchIndexReader &) = delete;
+    SearchIndexReader &operator=(const SearchIndexReader &) = delete;
+
+    /** Runs \a query and stores at most \a count matches starting at \a offset in \a matches,
+     *  best match first. Returns the total number of matching documents.
+     *
+     *  All words in the query must match (AND). A word ending with `*` matches all terms
+     *  starting with the word, and the last word is also matched as a prefix, so results
+     *  can be shown while the user is typing. Matches are ranked using BM25.
+     */
+    size_t search(const std::string &query,size_t offset,size_t count,
+                  std::vector<SearchMatch> &matches) const;
+
+    /** Returns the value stored in \a slot for document \a docId. */
+    std::string value(uint32_t docId,int slot) const;
+
+    uint32_t numDocuments() const;
+    uint32_t numTerms() const;
+    /** Returns the term with index \a termIndex in the sorted dictionary. */
+    std::string term(uint32_t termIndex) const;
+
+  private:
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
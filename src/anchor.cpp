@@ -22,6 +22,7 @@
 #include "containers.h"
 #include "utf8.h"
 #include "config.h"
+#include "shardmodel.h"
 
 struct AnchorGenerator::Private
 {
@@ -121,6 +122,7 @@ std::string AnchorGenerator::generate(const std::string &label)
   }
 
   p->anchorsUsed.insert(result);
+  ShardModel::instance().recordAnchor(label,result,false);
 
   return result;
 }
@@ -134,6 +136,7 @@ bool AnchorGenerator::isGenerated(const std::string &anchor) const
 int AnchorGenerator::reserve(const std::string &anchor)
 {
   std::lock_guard lock(p->mutex);
+  ShardModel::instance().recordAnchor(anchor,anchor,true);
   return p->idCount[anchor]++;
 }
 
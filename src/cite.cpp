@@ -27,6 +27,7 @@
 #include "growbuf.h"
 #include "entry.h"
 #include "commentscan.h"
+#include "shardmodel.h"
 
 #include <map>
 #include <unordered_map>
@@ -82,6 +83,7 @@ void CitationManager::insert(const QCString &label)
         label.str(),
         std::make_unique<CiteInfoImpl>(label)
       ));
+  ShardModel::instance().recordCitation(label);
 }
 
 const CiteInfo *CitationManager::find(const QCString &label) const
@@ -1,9 +1,11 @@
 #include "clangparser.h"
 #include "settings.h"
+#include "namedmutex.h"
 #include <cstdio>
 #include <cstdint>
 #include <vector>
 #include <mutex>
+#include <unordered_map>
 
 #if USE_LIBCLANG
 #include <clang-c/Index.h>
@@ -28,11 +30,11 @@
 
 //--------------------------------------------------------------------------
 
-static std::mutex g_clangMutex;
+static NamedMutex g_clangMutex("clangparser.cpp:g_clangMutex");
 
 ClangParser *ClangParser::instance()
 {
-  std::lock_guard<std::mutex> lock(g_clangMutex);
+  std::lock_guard<NamedMutex> lock(g_clangMutex);
   if (s_instance==nullptr) s_instance = new ClangParser;
   return s_instance;
 }
@@ -42,7 +44,7 @@ ClangParser *ClangParser::s_instance = nullptr;
 //--------------------------------------------------------------------------
 #if USE_LIBCLANG
 
-static std::mutex g_docCrossReferenceMutex;
+static NamedMutex g_docCrossReferenceMutex("clangparser.cpp:g_docCrossReferenceMutex");
 
 enum class DetectedLang { Cpp, ObjC, ObjCpp };
 
@@ -93,6 +95,30 @@ class ClangTUParser::Private
     bool              searchForBody=FALSE;
     bool              insideBody=FALSE;
     uint32_t          bracketCount=0;
+
+    /** Frees the translation unit and the unsaved file buffers passed to clang */
+    void dispose()
+    {
+      if (tu)
+      {
+        cursors.clear();
+        clang_disposeTokens(tu,tokens,numTokens);
+        clang_disposeTranslationUnit(tu);
+        clang_disposeIndex(index);
+        fileMapping.clear();
+        tokens    = nullptr;
+        numTokens = 0;
+        index     = nullptr;
+      }
+      for (size_t i=0;i<numFiles;i++)
+      {
+        delete[] ufs[i].Filename;
+      }
+      ufs.clear();
+      sources.clear();
+      numFiles  = 0;
+      tu        = nullptr;
+    }
 };
 
 ClangTUParser::ClangTUParser(const ClangParser &parser,const FileDef *fd)
@@ -109,7 +135,17 @@ StringVector ClangTUParser::filesInSameTU() const
 void ClangTUParser::parse()
 {
   //printf("ClangTUParser::parse() this=%p\n",this);
+  if (p->tu) // already parsed, e.g. a translation unit kept from the input parsing phase
+  {
+    // include files of the unit that were only found after it was parsed are not
+    // part of it, so in that case the unit is parsed again with the current set
+    StringVector files;
+    p->fileDef->getAllIncludeFilesRecursively(files);
+    if (files==p->filesInSameTU) return;
+    p->dispose();
+  }
   QCString fileName = p->fileDef->absFilePath();
+  p->filesInSameTU.clear();
   p->fileDef->getAllIncludeFilesRecursively(p->filesInSameTU);
   //printf("ClangTUParser::ClangTUParser(fileName=%s,#filesInSameTU=%d)\n",
   //    qPrint(fileName),(int)p->filesInSameTU.size());
@@ -289,24 +325,26 @@ ClangTUParser::~ClangTUParser()
   //printf("ClangTUParser::~ClangTUParser() this=%p\n",this);
   bool clangAssistedParsing = Config_getBool(CLANG_ASSISTED_PARSING);
   if (!clangAssistedParsing) return;
+  p->dispose();
+}
+
+size_t ClangTUParser::memoryUsage() const
+{
+  size_t size = 0;
   if (p->tu)
   {
-    p->cursors.clear();
-    clang_disposeTokens(p->tu,p->tokens,p->numTokens);
-    clang_disposeTranslationUnit(p->tu);
-    clang_disposeIndex(p->index);
-    p->fileMapping.clear();
-    p->tokens    = nullptr;
-    p->numTokens = 0;
+    CXTUResourceUsage usage = clang_getCXTUResourceUsage(p->tu);
+    for (unsigned int i=0;i<usage.numEntries;i++)
+    {
+      size += static_cast<size_t>(usage.entries[i].amount);
+    }
+    clang_disposeCXTUResourceUsage(usage);
   }
-  for (size_t i=0;i<p->numFiles;i++)
+  for (const auto &source : p->sources)
   {
-    delete[] p->ufs[i].Filename;
+    size += source.length();
   }
-  p->ufs.clear();
-  p->sources.clear();
-  p->numFiles  = 0;
-  p->tu        = nullptr;
+  return size;
 }
 
 void ClangTUParser::switchToFile(const FileDef *fd)
@@ -744,7 +782,7 @@ void ClangTUParser::linkIdentifier(OutputCodeList &ol,const FileDef *fd,
         p->currentMemberDef && d->definitionType()==Definition::TypeMember &&
         (p->currentMemberDef!=d || p->currentLine<line)) // avoid self-reference
     {
-      std::lock_guard<std::mutex> lock(g_docCrossReferenceMutex);
+      std::lock_guard<NamedMutex> lock(g_docCrossReferenceMutex);
       addDocCrossReference(p->currentMemberDef,toMemberDef(d));
     }
     writeMultiLineCodeLink(ol,fd,line,column,d,text);
@@ -928,6 +966,15 @@ class ClangParser::Private
     }
 
     std::unique_ptr<clang::tooling::CompilationDatabase> db;
+
+    struct KeptTU
+    {
+      size_t size;
+      std::unique_ptr<ClangTUParser> parser;
+    };
+    std::mutex keptTUsMutex;
+    std::unordered_map<std::string,KeptTU> keptTUs; // parsed translation units, keyed by source file
+    size_t keptTUsMemory = 0;
 };
 
 const clang::tooling::CompilationDatabase *ClangParser::database() const
@@ -946,9 +993,47 @@ ClangParser::~ClangParser()
 std::unique_ptr<ClangTUParser> ClangParser::createTUParser(const FileDef *fd) const
 {
   //printf("ClangParser::createTUParser()\n");
+  {
+    std::lock_guard<std::mutex> lock(p->keptTUsMutex);
+    auto it = p->keptTUs.find(fd->absFilePath().str());
+    if (it!=p->keptTUs.end())
+    {
+      auto parser = std::move(it->second.parser);
+      p->keptTUsMemory -= it->second.size;
+      p->keptTUs.erase(it);
+      return parser;
+    }
+  }
   return std::make_unique<ClangTUParser>(*this,fd);
 }
 
+void ClangParser::keepTUParser(std::unique_ptr<ClangTUParser> parser)
+{
+  if (parser==nullptr || parser->p->tu==nullptr) return;
+  // only useful if the sources will be processed again
+  if (!Config_getBool(SOURCE_BROWSER) && !Doxygen::parseSourcesNeeded) return;
+  size_t maxMemory = static_cast<size_t>(Config_getInt(CLANG_TU_CACHE_SIZE))*1024*1024;
+  size_t size = parser->memoryUsage();
+  std::string fileName = parser->p->fileDef->absFilePath().str();
+  std::lock_guard<std::mutex> lock(p->keptTUsMutex);
+  if (p->keptTUsMemory+size<=maxMemory && p->keptTUs.find(fileName)==p->keptTUs.end())
+  {
+    p->keptTUsMemory += size;
+    p->keptTUs.emplace(fileName,Private::KeptTU{ size, std::move(parser) });
+  }
+}
+
+void ClangParser::clearKeptTUParsers()
+{
+  std::unordered_map<std::string,Private::KeptTU> keptTUs;
+  {
+    std::lock_guard<std::mutex> lock(p->keptTUsMutex);
+    std::swap(keptTUs,p->keptTUs);
+    p->keptTUsMemory = 0;
+  }
+  // the translation units are disposed here, outside of the lock
+}
+
 
 //--------------------------------------------------------------------------
 #else // use stubbed functionality in case libclang support is disabled.
@@ -995,6 +1080,19 @@ std::unique_ptr<ClangTUParser> ClangParser::createTUParser(const FileDef *) cons
   return nullptr;
 }
 
+void ClangParser::keepTUParser(std::unique_ptr<ClangTUParser>)
+{
+}
+
+void ClangParser::clearKeptTUParsers()
+{
+}
+
+size_t ClangTUParser::memoryUsage() const
+{
+  return 0;
+}
+
 #endif
 //--------------------------------------------------------------------------
 
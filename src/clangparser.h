@@ -23,6 +23,7 @@ namespace clang { namespace tooling {
  */
 class ClangTUParser
 {
+    friend class ClangParser;
   public:
     ClangTUParser(const ClangParser &parser,const FileDef *fd);
     NON_COPYABLE(ClangTUParser)
@@ -30,6 +31,8 @@ class ClangTUParser
 
     /** Parse the file given at construction time as a translation unit
      *  This file should already be preprocessed by doxygen preprocessor at the time of calling.
+     *  Does nothing if the translation unit was already parsed with the current set of
+     *  include files, if files were added to it since, it is parsed again.
      */
     void parse();
 
@@ -71,6 +74,7 @@ class ClangTUParser
                    const char *text);
     void codeFolding(OutputCodeList &ol,const Definition *d,uint32_t line);
     void endCodeFold(OutputCodeList &ol,uint32_t line);
+    size_t memoryUsage() const;
     class Private;
     std::unique_ptr<Private> p;
 };
@@ -82,7 +86,18 @@ class ClangParser
   public:
     /** Returns the one and only instance of the class */
     static ClangParser *instance();
+    /** Returns a parser for the translation unit of \a fd. If a parsed
+     *  translation unit for the file was kept via keepTUParser() it is returned instead
+     *  of a new one.
+     */
     std::unique_ptr<ClangTUParser> createTUParser(const FileDef *fd) const;
+    /** Keeps the parsed translation unit of \a parser so it can be reused when the
+     *  sources are processed again, provided it fits in the memory budget set by
+     *  \c CLANG_TU_CACHE_SIZE. Otherwise the parser is discarded.
+     */
+    void keepTUParser(std::unique_ptr<ClangTUParser> parser);
+    /** Discards the translation units kept by keepTUParser() that were not reused. */
+    void clearKeptTUParsers();
 
   private:
     const clang::tooling::CompilationDatabase *database() const;
@@ -15,7 +15,7 @@
 
 #include "cmdmapper.h"
 
-static const CommandMap g_cmdMap =
+static constexpr StaticMapEntry<int> g_cmdEntries[] =
 {
   { "a",             CMD_EMPHASIS },
   { "addindex",      CMD_ADDINDEX },
@@ -160,7 +160,7 @@ static const CommandMap g_cmdMap =
 
 //----------------------------------------------------------------------------
 
-static const CommandMap g_htmlTagMap =
+static constexpr StaticMapEntry<int> g_htmlTagEntries[] =
 {
   { "strong",     HTML_BOLD },
   { "center",     HTML_CENTER },
@@ -237,38 +237,59 @@ static const CommandMap g_htmlTagMap =
   { "inheritdoc",   XML_INHERITDOC },
 };
 
+static constexpr auto g_cmdMap     = makeStaticMap(g_cmdEntries);
+static constexpr auto g_htmlTagMap = makeStaticMap(g_htmlTagEntries);
+
+// HTML tags are matched case insensitively, so they are converted to lower case first
+static constexpr size_t g_maxHtmlTagLength = maxStaticMapKeyLength(g_htmlTagEntries);
+
+static int lookupCmd(std::string_view name)     { return g_cmdMap.value(name,0);     }
+static int lookupHtmlTag(std::string_view name) { return g_htmlTagMap.value(name,0); }
+
 //----------------------------------------------------------------------------
 
-int Mapper::map(const QCString &n) const
+int Mapper::map(const QCString &name) const
 {
-  if (n.isEmpty()) return 0;
-  QCString name = n;
-  if (!m_cs) name=name.lower();
-  auto it = m_map.find(name.str());
-  return it!=m_map.end() ? it->second : 0;
+  std::string_view n = name.view();
+  if (n.empty()) return 0;
+  if (m_cs) return m_lookup(n);
+  for (char c : n)
+  {
+    if (static_cast<unsigned char>(c)>=0x80) // non-ASCII, use the full UTF-8 aware conversion
+    {
+      return m_lookup(name.lower().view());
+    }
+  }
+  if (n.length()>g_maxHtmlTagLength) return 0;
+  char lowerName[g_maxHtmlTagLength];
+  for (size_t i=0;i<n.length();i++)
+  {
+    char c = n[i];
+    lowerName[i] = c>='A' && c<='Z' ? static_cast<char>(c+'a'-'A') : c;
+  }
+  return m_lookup(std::string_view(lowerName,n.length()));
 }
 
 QCString Mapper::find(const int n) const
 {
-  for (const auto &[name,id] : m_map)
+  for (const StaticMapEntry<int> *e=m_first; e!=m_last; ++e)
   {
-    int curVal = id;
-    if (curVal == n || (curVal == (n | SIMPLESECT_BIT))) return name.c_str();
+    int curVal = e->value;
+    if (curVal == n || (curVal == (n | SIMPLESECT_BIT))) return QCString(e->key);
   }
   return QCString();
 }
 
-Mapper::Mapper(const CommandMap &cm,bool caseSensitive) : m_map(cm), m_cs(caseSensitive)
+Mapper::Mapper(LookupFunc lookup,const StaticMapEntry<int> *first,const StaticMapEntry<int> *last,bool caseSensitive) :
+  m_lookup(lookup), m_first(first), m_last(last), m_cs(caseSensitive)
 {
 }
 
-static Mapper g_cmdMapper(g_cmdMap,true);
-static Mapper g_htmlTagMapper(g_htmlTagMap,false);
+static Mapper g_cmdMapper(lookupCmd,g_cmdMap.begin(),g_cmdMap.end(),true);
+static Mapper g_htmlTagMapper(lookupHtmlTag,g_htmlTagMap.begin(),g_htmlTagMap.end(),false);
 
 namespace Mappers
 {
   const Mapper *cmdMapper     = &g_cmdMapper;
   const Mapper *htmlTagMapper = &g_htmlTagMapper;
 }
-
-
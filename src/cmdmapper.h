@@ -16,12 +16,11 @@
 #ifndef CMDMAPPER_H
 #define CMDMAPPER_H
 
-#include <unordered_map>
 #include <string>
+#include <string_view>
 #include <memory>
 #include "qcstring.h"
-
-using CommandMap = std::unordered_map< std::string, int >;
+#include "staticmap.h"
 
 const int SIMPLESECT_BIT = 0x1000;
 
@@ -239,11 +238,14 @@ enum HtmlTagType
 class Mapper
 {
   public:
+    using LookupFunc = int (*)(std::string_view name);
     int map(const QCString &n) const;
     QCString find(const int n) const;
-    Mapper(const CommandMap &cm,bool caseSensitive);
+    Mapper(LookupFunc lookup,const StaticMapEntry<int> *first,const StaticMapEntry<int> *last,bool caseSensitive);
   private:
-    const CommandMap &m_map;
+    LookupFunc m_lookup;
+    const StaticMapEntry<int> *m_first;
+    const StaticMapEntry<int> *m_last;
     bool m_cs;
 };
 
@@ -19,6 +19,7 @@
 #define COMMENTCNV_H
 
 #include <string>
+#include <string_view>
 
 /** @file
  *  @brief First pass comment processing.
@@ -34,7 +35,7 @@
  *  - conditional sections are processed.
  *  - aliases are expanded.
  */
-void convertCppComments(const std::string &inBuf,std::string &outBuf,
+void convertCppComments(std::string_view inBuf,std::string &outBuf,
                         const std::string &fn);
 
 #endif
@@ -0,0 +1,246 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <cinttypes>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "contentstore.h"
+#include "debug.h"
+#include "dir.h"
+#include "fileinfo.h"
+#include "message.h"
+
+struct ContentStoreItem
+{
+  int64_t  lastModified = 0;
+  size_t   fileSize     = 0;       // size of the file on disk, used to detect changes
+  std::string contents;            // only valid if inMemory is true
+  bool     inMemory     = false;
+  uint64_t spillPos     = 0;       // location of the contents in the spill file
+  size_t   spillSize    = 0;
+  bool     filtered     = false;
+  std::list<std::string>::iterator lruPos; // position in the LRU list if inMemory is true
+};
+
+struct ContentStore::Private
+{
+  std::mutex mutex;
+  std::unordered_map<std::string,ContentStoreItem> items;
+  std::list<std::string> lru; // keys of the items in memory, most recently used first
+  size_t memoryUsed = 0;
+  size_t maxMemory  = 0;
+  QCString spillFileName;
+  std::fstream spillFile;
+  uint64_t spillEnd = 0;
+  uint64_t hits     = 0;
+  uint64_t misses   = 0;
+  uint64_t spilled  = 0;
+
+  void removeFromMemory(ContentStoreItem &item)
+  {
+    memoryUsed -= item.contents.size();
+    lru.erase(item.lruPos);
+    item.contents.clear();
+    item.contents.shrink_to_fit();
+    item.inMemory = false;
+  }
+
+  bool spill(ContentStoreItem &item,const std::string &contents)
+  {
+    if (spillFileName.isEmpty()) return false;
+    if (!spillFile.is_open())
+    {
+      spillFile.open(spillFileName.str(),std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!spillFile.is_open())
+      {
+        err("Could not open file %s for storing filtered input\n",qPrint(spillFileName));
+        spillFileName.clear();
+        return false;
+      }
+    }
+    spillFile.seekp(static_cast<std::streamoff>(spillEnd));
+    spillFile.write(contents.data(),static_cast<std::streamsize>(contents.size()));
+    if (spillFile.fail())
+    {
+      spillFile.clear();
+      return false;
+    }
+    item.spillPos  = spillEnd;
+    item.spillSize = contents.size();
+    spillEnd += contents.size();
+    spilled++;
+    return true;
+  }
+
+  bool readSpilled(const ContentStoreItem &item,std::string &contents)
+  {
+    contents.resize(item.spillSize);
+    spillFile.seekg(static_cast<std::streamoff>(item.spillPos));
+    spillFile.read(&contents[0],static_cast<std::streamsize>(item.spillSize));
+    if (spillFile.fail())
+    {
+      spillFile.clear();
+      return false;
+    }
+    return true;
+  }
+
+  /** Removes the least recently used items until the memory budget is met.
+   *  Filtered contents are moved to the spill file.
+   */
+  void evict()
+  {
+    while (memoryUsed>maxMemory && !lru.empty())
+    {
+      auto it = items.find(lru.back());
+      ContentStoreItem &item = it->second;
+      bool keep = item.filtered && spill(item,item.contents);
+      removeFromMemory(item);
+      if (!keep)
+      {
+        items.erase(it);
+      }
+    }
+  }
+};
+
+ContentStore &ContentStore::instance()
+{
+  static ContentStore theInstance;
+  return theInstance;
+}
+
+ContentStore::ContentStore() : p(std::make_unique<Private>())
+{
+}
+
+ContentStore::~ContentStore()
+{
+  clear();
+}
+
+void ContentStore::init(const QCString &spillFileName,size_t maxMemory)
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->spillFileName = spillFileName;
+  p->maxMemory     = maxMemory;
+}
+
+static std::string storeKey(const QCString &fileName,const QCString &filterName)
+{
+  return filterName.isEmpty() ? fileName.str() : fileName.str()+'\n'+filterName.str();
+}
+
+bool ContentStore::find(const QCString &fileName,const QCString &filterName,std::string &contents)
+{
+  FileInfo fi(fileName.str());
+  int64_t lastModified = fi.lastModified();
+  size_t  fileSize     = fi.size();
+  std::lock_guard<std::mutex> lock(p->mutex);
+  auto it = p->items.find(storeKey(fileName,filterName));
+  if (it!=p->items.end())
+  {
+    ContentStoreItem &item = it->second;
+    if (item.lastModified==lastModified && item.fileSize==fileSize)
+    {
+      if (item.inMemory)
+      {
+        p->lru.splice(p->lru.begin(),p->lru,item.lruPos);
+        contents = item.contents;
+        p->hits++;
+        return true;
+      }
+      else if (p->readSpilled(item,contents))
+      {
+        Debug::print(Debug::FilterOutput,0,"Reusing filter result for %s from %s at offset=%" PRIu64 " size=%zu\n",
+            qPrint(fileName),qPrint(p->spillFileName),item.spillPos,item.spillSize);
+        p->hits++;
+        return true;
+      }
+    }
+    // file has changed since it was stored
+    if (item.inMemory) p->removeFromMemory(item);
+    p->items.erase(it);
+  }
+  p->misses++;
+  return false;
+}
+
+void ContentStore::insert(const QCString &fileName,const QCString &filterName,const std::string &contents)
+{
+  FileInfo fi(fileName.str());
+  ContentStoreItem newItem;
+  newItem.lastModified = fi.lastModified();
+  newItem.fileSize     = fi.size();
+  newItem.filtered     = !filterName.isEmpty();
+  std::string key = storeKey(fileName,filterName);
+  std::lock_guard<std::mutex> lock(p->mutex);
+  auto it = p->items.find(key);
+  if (it!=p->items.end()) // already stored by another thread
+  {
+    return;
+  }
+  if (contents.size()>p->maxMemory) // too large to keep in memory
+  {
+    if (newItem.filtered && p->spill(newItem,contents))
+    {
+      p->items.emplace(key,std::move(newItem));
+    }
+    return;
+  }
+  it = p->items.emplace(key,std::move(newItem)).first;
+  ContentStoreItem &item = it->second;
+  item.contents = contents;
+  item.inMemory = true;
+  p->lru.push_front(key);
+  item.lruPos   = p->lru.begin();
+  p->memoryUsed += contents.size();
+  p->evict();
+}
+
+void ContentStore::clear()
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->items.clear();
+  p->lru.clear();
+  p->memoryUsed = 0;
+  if (p->spillFile.is_open())
+  {
+    p->spillFile.close();
+    Dir().remove(p->spillFileName.str());
+  }
+  p->spillEnd = 0;
+}
+
+uint64_t ContentStore::hits() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->hits;
+}
+
+uint64_t ContentStore::misses() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->misses;
+}
+
+uint64_t ContentStore::spilled() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->spilled;
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef CONTENTSTORE_H
+#define CONTENTSTORE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "qcstring.h"
+#include "construct.h"
+
+/** @brief Store for the contents of the files read by readInputFile().
+ *
+ *  The contents are stored after filtering and conversion to UTF-8, keyed by the
+ *  file name and the input filter that was applied, so each file is read,
+ *  filtered and transcoded only once, even if it is needed again when generating
+ *  the source browser, a code fragment or a snippet.
+ *
+ *  The amount of memory used is bounded by \c INPUT_CACHE_SIZE. When the budget
+ *  is exceeded, the least recently used entries are removed. Entries produced by
+ *  an input filter are moved to a spill file on disk instead, so the filter never
+ *  needs to run twice for the same file. An entry is only used when the size and
+ *  modification time of the file are still the same as when it was read.
+ */
+class ContentStore
+{
+  public:
+    static ContentStore &instance();
+
+    /** Sets the name of the file used to store the filtered contents that
+     *  do not fit in memory and the memory budget in bytes.
+     */
+    void init(const QCString &spillFileName,size_t maxMemory);
+    /** Looks up the contents of \a fileName filtered with \a filterName
+     *  (empty if no filter is used). Returns TRUE and sets \a contents if found.
+     */
+    bool find(const QCString &fileName,const QCString &filterName,std::string &contents);
+    /** Stores \a contents as the result of reading \a fileName with filter \a filterName. */
+    void insert(const QCString &fileName,const QCString &filterName,const std::string &contents);
+    /** Removes all entries and the spill file. */
+    void clear();
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+    /** Returns the number of entries that were moved to the spill file. */
+    uint64_t spilled() const;
+
+  private:
+    ContentStore();
+   ~ContentStore();
+    NON_COPYABLE(ContentStore)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
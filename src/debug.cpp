@@ -48,6 +48,8 @@ static std::map< std::string, Debug::DebugMask > s_labels =
   { "entries",            Debug::Entries            },
   { "sections",           Debug::Sections           },
   { "stderr",             Debug::Stderr             },
+  { "memory",             Debug::Memory             },
+  { "locks",              Debug::Locks              },
   { "lex",                Debug::Lex                },
   { "lex:code",           Debug::Lex_code           },
   { "lex:commentcnv",     Debug::Lex_commentcnv     },
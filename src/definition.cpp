@@ -50,6 +50,7 @@
 #include "utf8.h"
 #include "indexlist.h"
 #include "fileinfo.h"
+#include "namedmutex.h"
 
 //-----------------------------------------------------------------------------------------
 
@@ -86,18 +87,38 @@ DeepCopyUniquePtr<T> make_DeepCopyUnique(Args&&... args)
 }
 
 /** Private data associated with a Symbol DefinitionImpl object. */
-class DefinitionImpl::IMPL
+class DefinitionImpl::IMPL : public MemoryCounted<MemoryCategory::DefinitionData,DefinitionImpl::IMPL>
 {
   public:
+    IMPL() : hidden(FALSE), isArtificial(FALSE), isAnonymous(FALSE), isExported(FALSE), isSymbol(FALSE) {}
     void init(const QCString &df, const QCString &n);
     void setDefFileName(const QCString &df);
 
-    Definition *def = nullptr;
+    /** Data that only a minority of the definitions have, allocated on first use */
+    struct RareData : public MemoryCounted<MemoryCategory::DefinitionData,RareData>
+    {
+      SectionRefs sectionRefs;
+      std::unordered_map<std::string,MemberDef *> sourceRefByDict;
+      std::unordered_map<std::string,MemberDef *> sourceRefsDict;
+      MemberVector referencesMembers;    // cache for getReferencesMembers()
+      MemberVector referencedByMembers;  // cache for getReferencedByMembers()
+      QCString ref;  // reference to external documentation
+      QCString id;   // clang unique id
+    };
+    const RareData &rare() const
+    {
+      static const RareData noRareData;
+      const RareData *rd = rareData.get();
+      return rd ? *rd : noRareData;
+    }
+    RareData &writableRare()
+    {
+      return rareData.getOrCreate();
+    }
 
-    SectionRefs sectionRefs;
+    Definition *def = nullptr;
 
-    std::unordered_map<std::string,MemberDef *> sourceRefByDict;
-    std::unordered_map<std::string,MemberDef *> sourceRefsDict;
+    RareDataPtr<RareData> rareData;
     RefItemVector xrefListItems;
     GroupList partOfGroups;
 
@@ -111,12 +132,13 @@ class DefinitionImpl::IMPL
     QCString localName;      // local (unqualified) name of the definition
                              // in the future m_name should become m_localName
     QCString qualifiedName;
-    QCString ref;   // reference to external documentation
 
-    bool hidden = FALSE;
-    bool isArtificial = FALSE;
-    bool isAnonymous = FALSE;
-    bool isExported = FALSE;
+    // flags
+    bool hidden : 1;
+    bool isArtificial : 1;
+    bool isAnonymous : 1;
+    bool isExported : 1;
+    bool isSymbol : 1;
 
     Definition *outerScope = nullptr;  // not owner
 
@@ -126,16 +148,10 @@ class DefinitionImpl::IMPL
 
     SrcLangExt lang = SrcLangExt::Unknown;
 
-    QCString id; // clang unique id
-
     QCString name;
-    bool isSymbol;
     QCString symbolName;
     int defLine;
     int defColumn;
-
-    MemberVector referencesMembers;    // cache for getReferencesMembers()
-    MemberVector referencedByMembers;  // cache for getReferencedByMembers()
 };
 
 
@@ -168,8 +184,11 @@ void DefinitionImpl::IMPL::init(const QCString &df, const QCString &n)
   details.reset();
   body.reset();
   inbodyDocs.reset();
-  sourceRefByDict.clear();
-  sourceRefsDict.clear();
+  if (rareData)
+  {
+    rareData->sourceRefByDict.clear();
+    rareData->sourceRefsDict.clear();
+  }
   outerScope      = Doxygen::globalScope;
   hidden          = FALSE;
   isArtificial    = FALSE;
@@ -308,7 +327,7 @@ void DefinitionImpl::setName(const QCString &name)
 void DefinitionImpl::setId(const QCString &id)
 {
   if (id.isEmpty()) return;
-  m_impl->id = id;
+  m_impl->writableRare().id = id;
   if (Doxygen::clangUsrMap)
   {
     //printf("DefinitionImpl::setId '%s'->'%s'\n",id,qPrint(m_impl->name));
@@ -318,7 +337,7 @@ void DefinitionImpl::setId(const QCString &id)
 
 QCString DefinitionImpl::id() const
 {
-  return m_impl->id;
+  return m_impl->rare().id;
 }
 
 void DefinitionImpl::addSectionsToDefinition(const std::vector<const SectionInfo*> &anchorList)
@@ -335,9 +354,9 @@ void DefinitionImpl::addSectionsToDefinition(const std::vector<const SectionInfo
     {
       gsi = sm.add(*si);
     }
-    if (m_impl->sectionRefs.find(gsi->label())==nullptr)
+    if (m_impl->rare().sectionRefs.find(gsi->label())==nullptr)
     {
-      m_impl->sectionRefs.add(gsi);
+      m_impl->writableRare().sectionRefs.add(gsi);
       gsi->setDefinition(m_impl->def);
     }
   }
@@ -346,9 +365,9 @@ void DefinitionImpl::addSectionsToDefinition(const std::vector<const SectionInfo
 bool DefinitionImpl::hasSections() const
 {
   //printf("DefinitionImpl::hasSections(%s) #sections=%d\n",qPrint(name()),
-  //    m_impl->sectionRefs.size());
-  if (m_impl->sectionRefs.empty()) return FALSE;
-  for (const SectionInfo *si : m_impl->sectionRefs)
+  //    m_impl->rare().sectionRefs.size());
+  if (m_impl->rare().sectionRefs.empty()) return FALSE;
+  for (const SectionInfo *si : m_impl->rare().sectionRefs)
   {
     if (si->type().isSection())
     {
@@ -360,10 +379,10 @@ bool DefinitionImpl::hasSections() const
 
 void DefinitionImpl::addSectionsToIndex()
 {
-  if (m_impl->sectionRefs.empty()) return;
+  if (m_impl->rare().sectionRefs.empty()) return;
   //printf("DefinitionImpl::addSectionsToIndex()\n");
   int level=1;
-  for (auto it = m_impl->sectionRefs.begin(); it!=m_impl->sectionRefs.end(); ++it)
+  for (auto it = m_impl->rare().sectionRefs.begin(); it!=m_impl->rare().sectionRefs.end(); ++it)
   {
     const SectionInfo *si = *it;
     SectionType type = si->type();
@@ -392,7 +411,7 @@ void DefinitionImpl::addSectionsToIndex()
       title = parseCommentAsText(scope,md,title,si->fileName(),si->lineNr());
       // determine if there is a next level inside this item, but be aware of the anchor and table section references.
       auto it_next = std::next(it);
-      bool isDir = (it_next!=m_impl->sectionRefs.end()) ?
+      bool isDir = (it_next!=m_impl->rare().sectionRefs.end()) ?
                        ((*it_next)->type().isSection() && (*it_next)->type().level() > nextLevel) : false;
       Doxygen::indexList->addContentsItem(isDir,title,
                                          getReference(),
@@ -412,10 +431,10 @@ void DefinitionImpl::addSectionsToIndex()
 
 void DefinitionImpl::writeDocAnchorsToTagFile(TextStream &tagFile) const
 {
-  if (!m_impl->sectionRefs.empty())
+  if (!m_impl->rare().sectionRefs.empty())
   {
     //printf("%s: writeDocAnchorsToTagFile(%d)\n",qPrint(name()),m_impl->sectionRef.size());
-    for (const SectionInfo *si : m_impl->sectionRefs)
+    for (const SectionInfo *si : m_impl->rare().sectionRefs)
     {
       if (!si->generated() && si->ref().isEmpty() && !AnchorGenerator::instance().isGenerated(si->label().str()))
       {
@@ -483,11 +502,11 @@ void DefinitionImpl::_setDocumentation(const QCString &d,const QCString &docFile
     }
     else if (atTop) // another detailed description, append it to the start
     {
-      m_impl->details->doc = doc+"\n\n"+m_impl->details->doc;
+      m_impl->details->doc = doc+"\n\n"+m_impl->details->doc.str();
     }
     else // another detailed description, append it to the end
     {
-      m_impl->details->doc += "\n\n"+doc;
+      m_impl->details->doc = m_impl->details->doc.str()+"\n\n"+doc;
     }
     if (docLine!=-1) // store location if valid
     {
@@ -584,7 +603,7 @@ void DefinitionImpl::_setInbodyDocumentation(const QCString &doc,const QCString
   }
   else // another inbody documentation fragment, append this to the end
   {
-    m_impl->inbodyDocs->doc += QCString("\n\n")+doc;
+    m_impl->inbodyDocs->doc = m_impl->inbodyDocs->doc.str()+"\n\n"+doc;
   }
 }
 
@@ -648,14 +667,11 @@ class FilterCache
       else // cache miss: filter active but file not previously processed
       {
         //printf("getFileContents(%s): cache miss\n",qPrint(fileName));
-        // filter file
-        QCString cmd=filter+" \""+fileName+"\"";
-        Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",qPrint(cmd));
-        FILE *f = Portable::popen(cmd,"r");
-        if (f==nullptr)
+        // get the filtered file, the filter only runs if the file was not read before
+        std::string contents;
+        if (!readInputFile(fileName,contents,TRUE,TRUE))
         {
-          // handle error
-          err("Error opening filter pipe command '%s'\n",qPrint(cmd));
+          err("Error filtering file '%s' with '%s'\n",qPrint(fileName),qPrint(filter));
           return false;
         }
         FILE *bf = Portable::fopen(Doxygen::filterDBFileName,"a+b");
@@ -665,29 +681,19 @@ class FilterCache
         {
           // handle error
           err("Error opening filter database file %s\n",qPrint(Doxygen::filterDBFileName));
-          Portable::pclose(f);
           return false;
         }
         // append the filtered output to the database file
-        size_t size=0;
-        while (!feof(f))
+        size_t size = fwrite(contents.data(),1,contents.size(),bf);
+        if (size!=contents.size())
         {
-          const int blockSize = 4096;
-          char buf[blockSize];
-          size_t bytesRead = fread(buf,1,blockSize,f);
-          size_t bytesWritten = fwrite(buf,1,bytesRead,bf);
-          if (bytesRead!=bytesWritten)
-          {
-            // handle error
-            err("Failed to write to filter database %s. Wrote %zu out of %zu bytes\n",
-                qPrint(Doxygen::filterDBFileName),bytesWritten,bytesRead);
-            Portable::pclose(f);
-            fclose(bf);
-            return false;
-          }
-          size+=bytesWritten;
-          str+=std::string_view(buf,bytesWritten);
+          // handle error
+          err("Failed to write to filter database %s. Wrote %zu out of %zu bytes\n",
+              qPrint(Doxygen::filterDBFileName),size,contents.size());
+          fclose(bf);
+          return false;
         }
+        str+=contents;
         item.fileSize = size;
         // add location entry to the dictionary
         m_cache.insert(std::make_pair(fileName.str(),item));
@@ -695,7 +701,6 @@ class FilterCache
                qPrint(fileName),qPrint(Doxygen::filterDBFileName),item.filePos,item.fileSize);
         // update end of file position
         m_endPos += size;
-        Portable::pclose(f);
         fclose(bf);
 
         // shrink buffer to [startLine..endLine] part
@@ -1201,22 +1206,22 @@ void DefinitionImpl::_writeSourceRefList(OutputList &ol,const QCString &scopeNam
 
 void DefinitionImpl::writeSourceReffedBy(OutputList &ol,const QCString &scopeName) const
 {
-  _writeSourceRefList(ol,scopeName,theTranslator->trReferencedBy(),m_impl->sourceRefByDict,FALSE);
+  _writeSourceRefList(ol,scopeName,theTranslator->trReferencedBy(),m_impl->rare().sourceRefByDict,FALSE);
 }
 
 void DefinitionImpl::writeSourceRefs(OutputList &ol,const QCString &scopeName) const
 {
-  _writeSourceRefList(ol,scopeName,theTranslator->trReferences(),m_impl->sourceRefsDict,TRUE);
+  _writeSourceRefList(ol,scopeName,theTranslator->trReferences(),m_impl->rare().sourceRefsDict,TRUE);
 }
 
 bool DefinitionImpl::hasSourceReffedBy() const
 {
-  return !m_impl->sourceRefByDict.empty();
+  return !m_impl->rare().sourceRefByDict.empty();
 }
 
 bool DefinitionImpl::hasSourceRefs() const
 {
-  return !m_impl->sourceRefsDict.empty();
+  return !m_impl->rare().sourceRefsDict.empty();
 }
 
 bool DefinitionImpl::hasDocumentation() const
@@ -1264,7 +1269,7 @@ void DefinitionImpl::addSourceReferencedBy(MemberDef *md)
       name.append(md->argsString());
     }
 
-    m_impl->sourceRefByDict.insert({name.str(),md});
+    m_impl->writableRare().sourceRefByDict.insert({name.str(),md});
   }
 }
 
@@ -1288,7 +1293,7 @@ void DefinitionImpl::addSourceReferences(MemberDef *md)
       name.append(md->argsString());
     }
 
-    m_impl->sourceRefsDict.insert({name.str(),md});
+    m_impl->writableRare().sourceRefsDict.insert({name.str(),md});
   }
 }
 
@@ -1302,11 +1307,11 @@ void DefinitionImpl::addInnerCompound(Definition *)
   err("DefinitionImpl::addInnerCompound() called\n");
 }
 
-static std::recursive_mutex g_qualifiedNameMutex;
+static NamedRecursiveMutex g_qualifiedNameMutex("definition.cpp:g_qualifiedNameMutex");
 
 QCString DefinitionImpl::qualifiedName() const
 {
-  std::lock_guard<std::recursive_mutex> lock(g_qualifiedNameMutex);
+  std::lock_guard<NamedRecursiveMutex> lock(g_qualifiedNameMutex);
   if (!m_impl->qualifiedName.isEmpty())
   {
     return m_impl->qualifiedName;
@@ -1342,7 +1347,7 @@ QCString DefinitionImpl::qualifiedName() const
 
 void DefinitionImpl::setOuterScope(Definition *d)
 {
-  std::lock_guard<std::recursive_mutex> lock(g_qualifiedNameMutex);
+  std::lock_guard<NamedRecursiveMutex> lock(g_qualifiedNameMutex);
   //printf("%s::setOuterScope(%s)\n",qPrint(name()),d?qPrint(d->name()):"<none>");
   Definition *p = m_impl->outerScope;
   bool found=false;
@@ -1531,15 +1536,15 @@ void DefinitionImpl::writeNavigationPath(OutputList &ol) const
 
 void DefinitionImpl::writeToc(OutputList &ol, const LocalToc &localToc) const
 {
-  if (m_impl->sectionRefs.empty()) return;
-  ol.writeLocalToc(m_impl->sectionRefs,localToc);
+  if (m_impl->rare().sectionRefs.empty()) return;
+  ol.writeLocalToc(m_impl->rare().sectionRefs,localToc);
 }
 
 //----------------------------------------------------------------------------------------
 
 const SectionRefs &DefinitionImpl::getSectionRefs() const
 {
-  return m_impl->sectionRefs;
+  return m_impl->rare().sectionRefs;
 }
 
 QCString DefinitionImpl::symbolName() const
@@ -1551,7 +1556,7 @@ QCString DefinitionImpl::symbolName() const
 
 QCString DefinitionImpl::documentation() const
 {
-  return m_impl->details ? m_impl->details->doc : QCString("");
+  return m_impl->details ? m_impl->details->doc.str() : QCString("");
 }
 
 int DefinitionImpl::docLine() const
@@ -1616,7 +1621,7 @@ QCString DefinitionImpl::briefDescription(bool abbr) const
 {
   //printf("%s::briefDescription(%d)='%s'\n",qPrint(name()),abbr,m_impl->brief?qPrint(m_impl->brief->doc):"<none>");
   return m_impl->brief ?
-         (abbr ? abbreviate(m_impl->brief->doc,m_impl->def->displayName()) : m_impl->brief->doc) :
+         (abbr ? abbreviate(m_impl->brief->doc.str(),m_impl->def->displayName()) : m_impl->brief->doc.str()) :
          QCString("");
 }
 
@@ -1627,7 +1632,7 @@ void DefinitionImpl::computeTooltip()
     const MemberDef *md = m_impl->def->definitionType()==Definition::TypeMember ? toMemberDef(m_impl->def) : nullptr;
     const Definition *scope = m_impl->def->definitionType()==Definition::TypeMember ? m_impl->def->getOuterScope() : m_impl->def;
     m_impl->brief->tooltip = parseCommentAsText(scope,md,
-                                m_impl->brief->doc, m_impl->brief->file, m_impl->brief->line);
+                                m_impl->brief->doc.str(), m_impl->brief->file, m_impl->brief->line);
   }
 }
 
@@ -1650,7 +1655,7 @@ QCString DefinitionImpl::briefFile() const
 
 QCString DefinitionImpl::inbodyDocumentation() const
 {
-  return m_impl->inbodyDocs ? m_impl->inbodyDocs->doc : QCString("");
+  return m_impl->inbodyDocs ? m_impl->inbodyDocs->doc.str() : QCString("");
 }
 
 int DefinitionImpl::inbodyLine() const
@@ -1703,12 +1708,12 @@ bool DefinitionImpl::isExported() const
 
 QCString DefinitionImpl::getReference() const
 {
-  return m_impl->ref;
+  return m_impl->rare().ref;
 }
 
 bool DefinitionImpl::isReference() const
 {
-  return !m_impl->ref.isEmpty();
+  return !m_impl->rare().ref.isEmpty();
 }
 
 int DefinitionImpl::getStartDefLine() const
@@ -1750,26 +1755,30 @@ Definition *DefinitionImpl::getOuterScope() const
   return m_impl->outerScope;
 }
 
-static std::mutex g_memberReferenceMutex;
+static NamedMutex g_memberReferenceMutex("definition.cpp:g_memberReferenceMutex");
 
 const MemberVector &DefinitionImpl::getReferencesMembers() const
 {
-  std::lock_guard<std::mutex> lock(g_memberReferenceMutex);
-  if (m_impl->referencesMembers.empty() && !m_impl->sourceRefsDict.empty())
+  std::lock_guard<NamedMutex> lock(g_memberReferenceMutex);
+  if (!m_impl->rareData) return m_impl->rare().referencesMembers;
+  IMPL::RareData &rd = *m_impl->rareData;
+  if (rd.referencesMembers.empty() && !rd.sourceRefsDict.empty())
   {
-    m_impl->referencesMembers = refMapToVector(m_impl->sourceRefsDict);
+    rd.referencesMembers = refMapToVector(rd.sourceRefsDict);
   }
-  return m_impl->referencesMembers;
+  return rd.referencesMembers;
 }
 
 const MemberVector &DefinitionImpl::getReferencedByMembers() const
 {
-  std::lock_guard<std::mutex> lock(g_memberReferenceMutex);
-  if (m_impl->referencedByMembers.empty() && !m_impl->sourceRefByDict.empty())
+  std::lock_guard<NamedMutex> lock(g_memberReferenceMutex);
+  if (!m_impl->rareData) return m_impl->rare().referencedByMembers;
+  IMPL::RareData &rd = *m_impl->rareData;
+  if (rd.referencedByMembers.empty() && !rd.sourceRefByDict.empty())
   {
-    m_impl->referencedByMembers = refMapToVector(m_impl->sourceRefByDict);
+    rd.referencedByMembers = refMapToVector(rd.sourceRefByDict);
   }
-  return m_impl->referencedByMembers;
+  return rd.referencedByMembers;
 }
 
 void DefinitionImpl::mergeReferences(const Definition *other)
@@ -1777,12 +1786,12 @@ void DefinitionImpl::mergeReferences(const Definition *other)
   const DefinitionImpl *defImpl = other->toDefinitionImpl_();
   if (defImpl)
   {
-    for (const auto &kv : defImpl->m_impl->sourceRefsDict)
+    for (const auto &kv : defImpl->m_impl->rare().sourceRefsDict)
     {
-      auto it = m_impl->sourceRefsDict.find(kv.first);
-      if (it != m_impl->sourceRefsDict.end())
+      auto it = m_impl->rare().sourceRefsDict.find(kv.first);
+      if (it != m_impl->rare().sourceRefsDict.end())
       {
-        m_impl->sourceRefsDict.insert(kv);
+        m_impl->writableRare().sourceRefsDict.insert(kv);
       }
     }
   }
@@ -1793,12 +1802,12 @@ void DefinitionImpl::mergeReferencedBy(const Definition *other)
   const DefinitionImpl *defImpl = other->toDefinitionImpl_();
   if (defImpl)
   {
-    for (const auto &kv : defImpl->m_impl->sourceRefByDict)
+    for (const auto &kv : defImpl->m_impl->rare().sourceRefByDict)
     {
-      auto it = m_impl->sourceRefByDict.find(kv.first);
-      if (it != m_impl->sourceRefByDict.end())
+      auto it = m_impl->rare().sourceRefByDict.find(kv.first);
+      if (it != m_impl->rare().sourceRefByDict.end())
       {
-        m_impl->sourceRefByDict.insert({kv.first,kv.second});
+        m_impl->writableRare().sourceRefByDict.insert({kv.first,kv.second});
       }
     }
   }
@@ -1807,7 +1816,7 @@ void DefinitionImpl::mergeReferencedBy(const Definition *other)
 
 void DefinitionImpl::setReference(const QCString &r)
 {
-  m_impl->ref=r;
+  if (!r.isEmpty() || m_impl->rareData) m_impl->writableRare().ref=r;
 }
 
 SrcLangExt DefinitionImpl::getLanguage() const
@@ -1931,7 +1940,7 @@ void DefinitionAliasImpl::deinit()
 
 void DefinitionAliasImpl::updateQualifiedName() const
 {
-  std::lock_guard<std::recursive_mutex> lock(g_qualifiedNameMutex);
+  std::lock_guard<NamedRecursiveMutex> lock(g_qualifiedNameMutex);
   if (m_qualifiedName.isEmpty())
   {
     //printf("start %s::qualifiedName() localName=%s\n",qPrint(name()),qPrint(m_impl->localName));
@@ -21,6 +21,7 @@
 #include "types.h"
 #include "reflist.h"
 #include "construct.h"
+#include "docstore.h"
 
 #ifdef _MSC_VER
 // To disable 'inherits via dominance' warnings with MSVC.
@@ -44,7 +45,7 @@ class TextStream;
 /** Data associated with a detailed description. */
 struct DocInfo
 {
-    QCString doc;
+    StoredString doc;
     int      line = -1;
     QCString file;
 };
@@ -52,7 +53,7 @@ struct DocInfo
 /** Data associated with a brief description. */
 struct BriefInfo
 {
-    QCString doc;
+    StoredString doc;
     QCString tooltip;
     int      line = -1;
     QCString file;
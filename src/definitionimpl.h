@@ -18,11 +18,60 @@
 #ifndef DEFINITIONIMPL_H
 #define DEFINITIONIMPL_H
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <type_traits>
 
 #include "definition.h"
+#include "memoryusage.h"
+
+/** @brief Owning pointer to the rarely used data of a definition.
+ *
+ *  The data is allocated on first use by getOrCreate(). Some of it, like the source
+ *  references and examples found by the code parsers, is added while several threads
+ *  generate output, so the pointer is published with a compare-and-swap and other
+ *  threads either see no data or fully constructed data. Access to the data itself
+ *  still has to be synchronized by the caller. Copying the pointer copies the data.
+ */
+template<class T>
+class RareDataPtr
+{
+  public:
+    RareDataPtr() = default;
+    RareDataPtr(const RareDataPtr &other) : m_ptr(other ? new T(*other) : nullptr) {}
+    RareDataPtr &operator=(const RareDataPtr &other)
+    {
+      if (this!=&other) delete m_ptr.exchange(other ? new T(*other) : nullptr);
+      return *this;
+    }
+   ~RareDataPtr() { delete m_ptr.load(); }
+
+    T *get() const               { return m_ptr.load(std::memory_order_acquire); }
+    T &operator*() const         { return *get(); }
+    T *operator->() const        { return get(); }
+    explicit operator bool() const { return get()!=nullptr; }
+
+    /** Returns the data, allocating it if this was not done yet */
+    T &getOrCreate()
+    {
+      T *p = get();
+      if (p==nullptr)
+      {
+        auto data = std::make_unique<T>();
+        if (m_ptr.compare_exchange_strong(p,data.get(),std::memory_order_acq_rel))
+        {
+          p = data.release();
+        }
+        // else another thread was first and p points to its data
+      }
+      return *p;
+    }
+
+  private:
+    std::atomic<T*> m_ptr { nullptr };
+};
 
 class DefinitionImpl
 {
@@ -144,8 +193,34 @@ class DefinitionImpl
     std::unique_ptr<IMPL> m_impl; // internal structure holding all private data
 };
 
+class MemberDefMutable;
+class ClassDefMutable;
+class NamespaceDefMutable;
+class ConceptDefMutable;
+class FileDef;
+class GroupDef;
+class PageDef;
+class DirDef;
+class ModuleDef;
+
+/** Returns the memory category in which definitions derived from \a Base are counted */
+template<class Base>
+constexpr MemoryCategory definitionMemoryCategory()
+{
+  if      constexpr (std::is_same_v<Base,ClassDefMutable>)     return MemoryCategory::ClassDefs;
+  else if constexpr (std::is_same_v<Base,MemberDefMutable>)    return MemoryCategory::MemberDefs;
+  else if constexpr (std::is_same_v<Base,FileDef>)             return MemoryCategory::FileDefs;
+  else if constexpr (std::is_same_v<Base,NamespaceDefMutable>) return MemoryCategory::NamespaceDefs;
+  else if constexpr (std::is_same_v<Base,GroupDef>)            return MemoryCategory::GroupDefs;
+  else if constexpr (std::is_same_v<Base,PageDef>)             return MemoryCategory::PageDefs;
+  else if constexpr (std::is_same_v<Base,DirDef>)              return MemoryCategory::DirDefs;
+  else if constexpr (std::is_same_v<Base,ConceptDefMutable>)   return MemoryCategory::ConceptDefs;
+  else if constexpr (std::is_same_v<Base,ModuleDef>)           return MemoryCategory::ModuleDefs;
+  else                                                         return MemoryCategory::DefinitionAliases;
+}
+
 template<class Base>
-class DefinitionMixin : public Base
+class DefinitionMixin : public Base, public MemoryTracked<definitionMemoryCategory<Base>()>
 {
   public:
     /*! Create a new definition */
@@ -321,7 +396,7 @@ class DefinitionAliasImpl
 };
 
 template<class Base>
-class DefinitionAliasMixin : public Base
+class DefinitionAliasMixin : public Base, public MemoryTracked<MemoryCategory::DefinitionAliases>
 {
   public:
     DefinitionAliasMixin(const Definition *scope,const Definition *alias)
@@ -19,6 +19,7 @@
 #include "message.h"
 #include "util.h"
 #include "dir.h"
+#include "outputarchive.h"
 
 
 static const int maxCmdLine = 40960;
@@ -77,6 +78,8 @@ void writeDiaGraphFromFile(const QCString &inFile,const QCString &outDir,
     }
   }
 
+  addDiskFileToOutputArchive(absOutFile+extension);
+
 error:
   Dir::setCurrent(oldDir);
 }
@@ -29,6 +29,7 @@
 #include "classlist.h"
 #include "textstream.h"
 #include "growbuf.h"
+#include "outputarchive.h"
 
 //-----------------------------------------------------------------------------
 
@@ -1390,6 +1391,7 @@ void ClassDiagram::writeImage(TextStream &t,const QCString &path,
 
 #define IMAGE_EXT ".png"
   image.save(QCString(path)+"/"+fileName+IMAGE_EXT);
+  addDiskFileToOutputArchive(QCString(path)+"/"+fileName+IMAGE_EXT);
   Doxygen::indexList->addImageFile(QCString(fileName)+IMAGE_EXT);
 }
 
@@ -19,9 +19,11 @@
 #include "entry.h"
 #include "message.h"
 #include "docgroup.h"
+#include "namedmutex.h"
+#include "shardmodel.h"
 
 static std::atomic_int g_groupId;
-static std::mutex g_memberGroupInfoMapMutex;
+static NamedMutex g_memberGroupInfoMapMutex("docgroup.cpp:g_memberGroupInfoMapMutex");
 
 void DocGroup::enterFile(const QCString &fileName,int)
 {
@@ -87,22 +89,24 @@ void DocGroup::leaveCompound(const QCString &,int,const QCString &/* name */)
   m_compoundName.clear();
 }
 
-int DocGroup::findExistingGroup(const MemberGroupInfo *info)
+int DocGroup::findOrAddMemberGroup(std::unique_ptr<MemberGroupInfo> info)
 {
-  std::lock_guard<std::mutex> lock(g_memberGroupInfoMapMutex);
-  //printf("findExistingGroup %s:%s\n",qPrint(info->header),qPrint(info->compoundName));
+  std::lock_guard<NamedMutex> lock(g_memberGroupInfoMapMutex);
+  //printf("findOrAddMemberGroup %s:%s\n",qPrint(info->header),qPrint(info->compoundName));
   for (const auto &[groupId,groupInfo] : Doxygen::memberGroupInfoMap)
   {
-    if (m_compoundName==groupInfo->compoundName &&  // same file or scope
-	!groupInfo->header.isEmpty() &&             // not a nameless group
-	qstricmp(groupInfo->header,info->header)==0  // same header name
+    if (info->compoundName==groupInfo->compoundName &&  // same file or scope
+	!groupInfo->header.isEmpty() &&                     // not a nameless group
+	qstricmp(groupInfo->header,info->header)==0         // same header name
        )
     {
       //printf("Found it!\n");
       return groupId; // put the item in this group
     }
   }
-  return ++g_groupId; // start new group
+  int groupId = ++g_groupId; // start new group
+  Doxygen::memberGroupInfoMap.insert(std::make_pair(groupId,std::move(info)));
+  return groupId;
 }
 
 void DocGroup::open(Entry *e,const QCString &,int, bool implicit)
@@ -122,16 +126,8 @@ void DocGroup::open(Entry *e,const QCString &,int, bool implicit)
       auto info = std::make_unique<MemberGroupInfo>();
       info->header = m_memberGroupHeader.stripWhiteSpace();
       info->compoundName = m_compoundName;
-      m_memberGroupId = findExistingGroup(info.get());
-      {
-        std::lock_guard<std::mutex> lock(g_memberGroupInfoMapMutex);
-        auto it = Doxygen::memberGroupInfoMap.find(m_memberGroupId);
-        if (it==Doxygen::memberGroupInfoMap.end())
-        {
-          //printf("    use membergroup %d\n",m_memberGroupId);
-          Doxygen::memberGroupInfoMap.insert(std::make_pair(m_memberGroupId,std::move(info)));
-        }
-      }
+      m_memberGroupId = findOrAddMemberGroup(std::move(info));
+      ShardModel::instance().recordMemberGroup(m_memberGroupId,m_memberGroupHeader.stripWhiteSpace(),m_compoundName);
       m_memberGroupRelates = e->relates;
       e->mGrpId = m_memberGroupId;
     }
@@ -156,7 +152,7 @@ void DocGroup::close(Entry *e,const QCString &fileName,int line,bool foundInline
   if (m_memberGroupId!=DOX_NOGROUP) // end of member group
   {
     {
-      std::lock_guard<std::mutex> lock(g_memberGroupInfoMapMutex);
+      std::lock_guard<NamedMutex> lock(g_memberGroupInfoMapMutex);
       auto it = Doxygen::memberGroupInfoMap.find(m_memberGroupId);
       if (it!=Doxygen::memberGroupInfoMap.end()) // known group
       {
@@ -164,6 +160,7 @@ void DocGroup::close(Entry *e,const QCString &fileName,int line,bool foundInline
         info->doc = m_memberGroupDocs;
         //info->docFile = fileName;
         //info->docLine = line;
+        ShardModel::instance().recordMemberGroupDoc(m_memberGroupId,info->doc);
       }
     }
     m_memberGroupId=DOX_NOGROUP;
@@ -210,7 +207,7 @@ void DocGroup::addDocs(Entry *e)
     }
     m_memberGroupDocs+=e->doc;
     {
-      std::lock_guard<std::mutex> lock(g_memberGroupInfoMapMutex);
+      std::lock_guard<NamedMutex> lock(g_memberGroupInfoMapMutex);
       auto it =Doxygen::memberGroupInfoMap.find(m_memberGroupId);
       if (it!=Doxygen::memberGroupInfoMap.end())
       {
@@ -219,6 +216,7 @@ void DocGroup::addDocs(Entry *e)
         info->docFile = e->docFile;
         info->docLine = e->docLine;
         info->setRefItems(e->sli);
+        ShardModel::instance().recordMemberGroupDocs(m_memberGroupId,info->doc,info->docFile,info->docLine,e->sli);
       }
     }
     e->doc.clear();
@@ -16,6 +16,7 @@
 #ifndef DOCGROUP_H
 #define DOCGROUP_H
 
+#include <memory>
 #include <vector>
 #include "membergroup.h"
 
@@ -38,9 +39,12 @@ class DocGroup
     void clearHeader();
     void appendHeader(const char);
     void addDocs(Entry *e);
+    /** Returns the id of the member group of \a info's compound that has the same header,
+     *  or adds \a info as a new group with a new id if there is no such group yet.
+     */
+    static int findOrAddMemberGroup(std::unique_ptr<MemberGroupInfo> info);
 
   private:
-    int findExistingGroup(const MemberGroupInfo *info);
     int              m_openCount = 0;
     QCString         m_memberGroupHeader;
     int              m_memberGroupId = 0;
@@ -39,7 +39,10 @@
 #include "anchor.h"
 #include "aliases.h"
 
-#if !ENABLE_DOCPARSER_TRACING
+#if ENABLE_DOCPARSER_TRACING
+#undef  TRACE_SUBSYSTEM
+#define TRACE_SUBSYSTEM Trace::DocParser
+#else
 #undef  AUTO_TRACE
 #undef  AUTO_TRACE_ADD
 #undef  AUTO_TRACE_EXIT
@@ -75,6 +78,13 @@ static const StringUnorderedSet g_plantumlEngine {
 
 //---------------------------------------------------------------------------
 
+// defined here rather than in the header, since counting the node needs the complete DocNodeVariant
+DocNode::DocNode(DocParser *parser,DocNodeVariant *parent) : m_parser(parser), m_parent(parent)
+{
+}
+
+//---------------------------------------------------------------------------
+
 // replaces { with < and } with > and also
 // replaces &gt; with < and &gt; with > within string s
 static void unescapeCRef(QCString &s)
@@ -31,6 +31,7 @@
 #include "growvector.h"
 #include "section.h"
 #include "construct.h"
+#include "memoryusage.h"
 
 class MemberDef;
 class Definition;
@@ -75,12 +76,16 @@ DOC_NODES
 #undef DN
 #undef DN_SEP
 
-/** Abstract node interface with type information. */
-class DocNode
+/** Abstract node interface with type information.
+ *
+ *  Every node is stored in a DocNodeVariant, so its memory is counted with the size
+ *  of the variant, i.e. that of the largest node type, rather than the size of DocNode.
+ */
+class DocNode : public MemoryCounted<MemoryCategory::DocAst,DocNodeVariant>
 {
   public:
     /*! Creates a new node */
-    DocNode(DocParser *parser,DocNodeVariant *parent) : m_parser(parser), m_parent(parent) {}
+    DocNode(DocParser *parser,DocNodeVariant *parent);
    ~DocNode() = default;
     ONLY_DEFAULT_MOVABLE(DocNode)
 
@@ -39,7 +39,10 @@
 #include "indexlist.h"
 #include "trace.h"
 
-#if !ENABLE_DOCPARSER_TRACING
+#if ENABLE_DOCPARSER_TRACING
+#undef  TRACE_SUBSYSTEM
+#define TRACE_SUBSYSTEM Trace::DocParser
+#else
 #undef  AUTO_TRACE
 #undef  AUTO_TRACE_ADD
 #undef  AUTO_TRACE_EXIT
@@ -53,7 +56,18 @@
 
 IDocParserPtr createDocParser()
 {
-  return std::make_unique<DocParser>();
+  bool reused = false;
+  auto parserIntf = ObjectPool<IDocParser>::acquire("doc",[]() { return std::make_unique<DocParser>(); },reused);
+  DocParser *parser = dynamic_cast<DocParser*>(parserIntf.get());
+  if (reused && parser) parser->reset();
+  return parserIntf;
+}
+
+void DocParser::reset()
+{
+  context      = DocParserContext();
+  contextStack = std::stack<DocParserContext>();
+  tokenizer.reset();
 }
 
 void DocParser::pushContext()
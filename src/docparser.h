@@ -22,6 +22,7 @@
 #include "qcstring.h"
 #include "growvector.h"
 #include "construct.h"
+#include "objectpool.h"
 
 class MemberDef;
 class Definition;
@@ -35,10 +36,10 @@ class IDocParser
     ABSTRACT_BASE_CLASS(IDocParser)
 };
 
-//! @brief pointer to parser interface
-using IDocParserPtr = std::unique_ptr<IDocParser>;
+//! @brief pointer to parser interface, returns the parser to a per thread pool when destroyed
+using IDocParserPtr = ObjectPool<IDocParser>::Ptr;
 
-//! @brief factory function to create a parser
+//! @brief factory function to create a parser, reuses a parser from the pool of the current thread if possible
 IDocParserPtr createDocParser();
 
 //---------------------------------------------------------------------------
@@ -94,6 +94,7 @@ struct DocParserContext
 class DocParser : public IDocParser
 {
   public:
+    void reset();
     void pushContext();
     void popContext();
     void handleImg(DocNodeVariant *parent,DocNodeList &children,const HtmlAttribList &tagHtmlAttribs);
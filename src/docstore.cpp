@@ -0,0 +1,157 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "docstore.h"
+#include "dir.h"
+#include "message.h"
+#include "portable.h"
+
+// The file is mapped in segments of this size. A segment is never moved or unmapped
+// while the store is open, so strings can be read from it without taking a lock.
+static const size_t kSegmentSize = 64*1024*1024;
+// maximum number of segments, i.e. the store can hold up to 256GB
+static const size_t kMaxSegments = 4096;
+
+struct DocStore::Private
+{
+  std::mutex mutex; // serializes open(), close() and append()
+  std::atomic<bool> isOpen { false };
+  QCString fileName;
+  std::array< std::atomic<char *>, kMaxSegments > segments {}; // mapped parts of the file
+  size_t   numSegments = 0;  // number of mapped segments
+  size_t   used        = 0;  // number of bytes used in the last segment
+  std::atomic<uint64_t> strings { 0 };
+  std::atomic<uint64_t> bytes   { 0 };
+
+  void unmap()
+  {
+    for (size_t i=0;i<numSegments;i++)
+    {
+      Portable::unmapFile(segments[i].exchange(nullptr),kSegmentSize);
+    }
+    numSegments = 0;
+    used        = 0;
+  }
+
+  // finds room for size bytes, mapping a new segment if needed, must be called with the lock held
+  bool reserve(size_t size,uint64_t &offset)
+  {
+    if (size>kSegmentSize) return false; // too large, kept in memory
+    if (numSegments==0 || used+size>kSegmentSize)
+    {
+      char *data = numSegments<kMaxSegments ?
+                   Portable::mapWritableFile(fileName,static_cast<uint64_t>(numSegments)*kSegmentSize,kSegmentSize) :
+                   nullptr;
+      if (data==nullptr)
+      {
+        // new strings are kept in memory from now on, the ones stored so far stay mapped
+        isOpen = false;
+        if (numSegments==0)
+        {
+          warn_uncond("Could not map file %s for storing documentation, keeping it in memory instead\n",qPrint(fileName));
+        }
+        else
+        {
+          warn_uncond("Could not extend file %s for storing documentation beyond %zu MB, keeping new documentation in memory\n",
+              qPrint(fileName),numSegments*(kSegmentSize/(1024*1024)));
+        }
+        return false;
+      }
+      segments[numSegments++].store(data,std::memory_order_release);
+      used = 0;
+    }
+    offset = static_cast<uint64_t>(numSegments-1)*kSegmentSize+used;
+    used += size;
+    return true;
+  }
+};
+
+DocStore &DocStore::instance()
+{
+  static DocStore theInstance;
+  return theInstance;
+}
+
+DocStore::DocStore() : p(std::make_unique<Private>())
+{
+}
+
+DocStore::~DocStore()
+{
+  close();
+}
+
+void DocStore::open(const QCString &fileName)
+{
+  close();
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->fileName = fileName;
+  p->isOpen   = true;
+}
+
+void DocStore::close()
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  if (p->fileName.isEmpty()) return;
+  p->unmap();
+  Dir thisDir;
+  thisDir.remove(p->fileName.str());
+  p->fileName.clear();
+  p->isOpen  = false;
+  p->strings = 0;
+  p->bytes   = 0;
+}
+
+bool DocStore::isOpen() const
+{
+  return p->isOpen.load(std::memory_order_relaxed);
+}
+
+bool DocStore::append(const QCString &text,uint64_t &offset)
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  if (!p->isOpen || !p->reserve(text.length(),offset)) return false;
+  char *data = p->segments[offset/kSegmentSize].load(std::memory_order_relaxed);
+  memcpy(data+offset%kSegmentSize,text.data(),text.length());
+  p->strings++;
+  p->bytes += text.length();
+  return true;
+}
+
+QCString DocStore::read(uint64_t offset,size_t length) const
+{
+  // no lock needed: offset was returned by append(), so its segment is mapped and filled
+  uint64_t index = offset/kSegmentSize;
+  size_t   start = static_cast<size_t>(offset%kSegmentSize);
+  const char *data = index<kMaxSegments ? p->segments[static_cast<size_t>(index)].load(std::memory_order_acquire) : nullptr;
+  if (data==nullptr || length>kSegmentSize-start) return QCString();
+  return QCString(std::string(data+start,length));
+}
+
+uint64_t DocStore::strings() const
+{
+  return p->strings;
+}
+
+uint64_t DocStore::bytes() const
+{
+  return p->bytes;
+}
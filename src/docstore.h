@@ -0,0 +1,98 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef DOCSTORE_H
+#define DOCSTORE_H
+
+#include <cstdint>
+#include <memory>
+
+#include "qcstring.h"
+#include "construct.h"
+
+/** @brief Store that keeps the documentation strings of the definitions on disk.
+ *
+ *  When enabled via \c DOC_STORE_ON_DISK, the strings are appended to a memory
+ *  mapped file in the output directory and the definitions only keep their location.
+ *  This leaves it to the operating system's page cache to decide which parts are kept
+ *  in memory. Strings are never changed or removed once stored, so a definition that
+ *  changes its documentation simply stores a new string. The file is mapped in fixed
+ *  segments that stay in place while the store is open, so reading a string does not
+ *  take a lock.
+ */
+class DocStore
+{
+  public:
+    static DocStore &instance();
+
+    /** Starts storing strings in file \a fileName. Any previously stored strings are discarded. */
+    void open(const QCString &fileName);
+    /** Removes the file and stops storing strings. */
+    void close();
+    bool isOpen() const;
+
+    /** Appends \a text to the store. Returns TRUE and sets \a offset on success. */
+    bool append(const QCString &text,uint64_t &offset);
+    /** Returns the \a length bytes stored at \a offset */
+    QCString read(uint64_t offset,size_t length) const;
+
+    /** Returns the number of strings stored */
+    uint64_t strings() const;
+    /** Returns the number of bytes stored */
+    uint64_t bytes() const;
+
+  private:
+    DocStore();
+   ~DocStore();
+    NON_COPYABLE(DocStore)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+/** @brief String that is kept in the DocStore when it is open, and in memory otherwise. */
+class StoredString
+{
+  public:
+    StoredString() = default;
+    StoredString(const QCString &s) { set(s); }
+    StoredString &operator=(const QCString &s) { set(s); return *this; }
+
+    /** Returns the string, reading it from the store if needed */
+    QCString str() const
+    {
+      return m_length>0 ? DocStore::instance().read(m_offset,m_length) : m_text;
+    }
+    bool isEmpty() const { return m_length==0 && m_text.isEmpty(); }
+
+  private:
+    void set(const QCString &s)
+    {
+      if (!s.isEmpty() && DocStore::instance().isOpen() && DocStore::instance().append(s,m_offset))
+      {
+        m_length = s.length();
+        m_text   = QCString();
+      }
+      else
+      {
+        m_length = 0;
+        m_text   = s;
+      }
+    }
+    QCString m_text;       // string if not stored
+    uint64_t m_offset = 0; // location of the string in the store
+    size_t   m_length = 0; // length of the string in the store, 0 if not stored
+};
+
+#endif
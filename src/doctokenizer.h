@@ -142,6 +142,10 @@ class DocTokenizer
     void init(const char *input,const QCString &fileName,
               bool markdownSupport, bool insideHtmlLink);
     void cleanup();
+    /** Puts the scanner back in its initial state, so it can be reused after a
+     *  parse that did not run to the end of its input.
+     */
+    void reset();
     void pushContext();
     bool popContext();
     int  lex();
@@ -25,7 +25,7 @@
 struct DocVisitor::Private
 {
   int id;
-  std::unordered_map< std::string, std::unique_ptr<CodeParserInterface> > parserFactoryMap;
+  std::unordered_map< std::string, CodeParserPtr > parserFactoryMap;
   std::stack<bool> hidden;
 };
 
@@ -46,8 +46,7 @@ CodeParserInterface &DocVisitor::getCodeParser(const QCString &extension)
   auto it = m_p->parserFactoryMap.find(ext);
   if (it==m_p->parserFactoryMap.end())
   {
-    auto factory = Doxygen::parserManager->getCodeParserFactory(extension);
-    auto result = m_p->parserFactoryMap.insert(std::make_pair(ext,factory()));
+    auto result = m_p->parserFactoryMap.insert(std::make_pair(ext,Doxygen::parserManager->getCodeParser(extension)));
     it = result.first;
   }
   return *it->second.get();
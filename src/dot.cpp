@@ -30,6 +30,8 @@
 #include "language.h"
 #include "indexlist.h"
 #include "dir.h"
+#include "namedmutex.h"
+#include "outputarchive.h"
 
 #define MAP_CMD "cmapx"
 
@@ -37,7 +39,7 @@
 
 static QCString g_dotFontPath;
 
-static std::mutex g_dotManagerMutex;
+static NamedMutex g_dotManagerMutex("dot.cpp:g_dotManagerMutex");
 
 static void setDotFontPath(const QCString &path)
 {
@@ -81,7 +83,7 @@ DotManager *DotManager::instance()
   return &theInstance;
 }
 
-DotManager::DotManager() : m_runners(), m_filePatchers(), m_workers(static_cast<size_t>(Config_getInt(DOT_NUM_THREADS)))
+DotManager::DotManager() : m_runners(), m_filePatchers(), m_workers(static_cast<size_t>(Config_getInt(DOT_NUM_THREADS)),"dot")
 {
 }
 
@@ -91,7 +93,7 @@ DotManager::~DotManager()
 
 DotRunner* DotManager::createRunner(const QCString &absDotName, const QCString& md5Hash)
 {
-  std::lock_guard<std::mutex> lock(g_dotManagerMutex);
+  std::lock_guard<NamedMutex> lock(g_dotManagerMutex);
   DotRunner* rv = nullptr;
   auto const runit = m_runners.find(absDotName.str());
   if (runit == m_runners.end())
@@ -115,7 +117,7 @@ DotRunner* DotManager::createRunner(const QCString &absDotName, const QCString&
 
 DotFilePatcher *DotManager::createFilePatcher(const QCString &fileName)
 {
-  std::lock_guard<std::mutex> lock(g_dotManagerMutex);
+  std::lock_guard<NamedMutex> lock(g_dotManagerMutex);
   auto patcher = m_filePatchers.find(fileName.str());
 
   if (patcher != m_filePatchers.end()) return &(patcher->second);
@@ -125,6 +127,12 @@ DotFilePatcher *DotManager::createFilePatcher(const QCString &fileName)
   return &(rv.first->second);
 }
 
+bool DotManager::hasFilePatcher(const QCString &fileName) const
+{
+  std::lock_guard<NamedMutex> lock(g_dotManagerMutex);
+  return m_filePatchers.find(fileName.str())!=m_filePatchers.end();
+}
+
 bool DotManager::run()
 {
   size_t numDotRuns = m_runners.size();
@@ -184,7 +192,7 @@ bool DotManager::run()
       {
         runner->run();
       };
-      results.emplace_back(m_workers.queue(process));
+      results.emplace_back(m_workers.queue(dr.first.c_str(),process));
     }
     for (auto &f : results)
     {
@@ -265,6 +273,7 @@ void writeDotGraphFromFile(const QCString &inFile,const QCString &outDir,
      return;
   }
 
+  addDiskFileToOutputArchive(absImgName);
   Doxygen::indexList->addImageFile(imgName);
 
 }
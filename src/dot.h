@@ -37,6 +37,7 @@ class DotManager
     static DotManager *instance();
     DotRunner*      createRunner(const QCString& absDotName, const QCString& md5Hash);
     DotFilePatcher *createFilePatcher(const QCString &fileName);
+    bool            hasFilePatcher(const QCString &fileName) const;
     bool run();
 
   private:
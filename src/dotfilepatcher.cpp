@@ -311,28 +311,42 @@ bool DotFilePatcher::run() const
     //printf("DotFilePatcher::addSVGConversion: file=%s zoomable=%d\n",
     //    qPrint(m_patchFile),map->zoomable);
   }
+  // with KEEP_UNCHANGED_FILES the patched result is collected in memory and only
+  // written if it differs from the existing file; writeFileContents() then already
+  // stored the unpatched page as tmpName
+  bool keepUnchanged = Config_getBool(KEEP_UNCHANGED_FILES);
   QCString tmpName = m_patchFile+".tmp";
   Dir thisDir;
-  if (!thisDir.rename(m_patchFile.str(),tmpName.str()))
+  bool staged = keepUnchanged && thisDir.exists(tmpName.str());
+  if (!staged && !thisDir.rename(m_patchFile.str(),tmpName.str()))
   {
     err("Failed to rename file %s to %s!\n",qPrint(m_patchFile),qPrint(tmpName));
     return FALSE;
   }
+  auto restore = [&]()
+  {
+    if (staged) thisDir.remove(tmpName.str()); else thisDir.rename(tmpName.str(),m_patchFile.str());
+  };
   std::ifstream fi = Portable::openInputStream(tmpName);
-  std::ofstream fo = Portable::openOutputStream(m_patchFile);
   if (!fi.is_open())
   {
     err("problem opening file %s for patching!\n",qPrint(tmpName));
-    thisDir.rename(tmpName.str(),m_patchFile.str());
+    restore();
     return FALSE;
   }
-  if (!fo.is_open())
+  std::ofstream fo;
+  TextStream t;
+  if (!keepUnchanged)
   {
-    err("problem opening file %s for patching!\n",qPrint(m_patchFile));
-    thisDir.rename(tmpName.str(),m_patchFile.str());
-    return FALSE;
+    fo = Portable::openOutputStream(m_patchFile);
+    if (!fo.is_open())
+    {
+      err("problem opening file %s for patching!\n",qPrint(m_patchFile));
+      restore();
+      return FALSE;
+    }
+    t.setStream(&fo);
   }
-  TextStream t(&fo);
   int width=0,height=0;
   bool insideHeader=FALSE;
   bool replacedHeader=FALSE;
@@ -484,40 +498,69 @@ bool DotFilePatcher::run() const
   if (isSVGFile && interactiveSVG && !useNagivation) t << "</svg>\n";
 
   fi.close();
+  QCString orgName;
   if (isSVGFile && interactiveSVG && replacedHeader)
   {
-    QCString orgName=m_patchFile.left(m_patchFile.length()-4)+"_org.svg";
+    orgName=m_patchFile.left(m_patchFile.length()-4)+"_org.svg";
     if (useNagivation)
     {
       t << substitute(svgZoomFooter1,"$orgname",stripPath(orgName));
     }
     t << svgZoomFooter2;
+  }
+  if (keepUnchanged)
+  {
+    if (!writeFileIfChanged(m_patchFile,t.str()))
+    {
+      return FALSE;
+    }
+    t.clear();
+  }
+  else
+  {
     t.flush();
     fo.close();
+  }
+  if (!orgName.isEmpty())
+  {
     // keep original SVG file so we can refer to it, we do need to replace
     // dummy link by real ones
     fi = Portable::openInputStream(tmpName);
-    fo = Portable::openOutputStream(orgName);
     if (!fi.is_open())
     {
       err("problem opening file %s for reading!\n",qPrint(tmpName));
       return FALSE;
     }
-    if (!fo.is_open())
+    if (!keepUnchanged)
     {
-      err("problem opening file %s for writing!\n",qPrint(orgName));
-      return FALSE;
+      fo = Portable::openOutputStream(orgName);
+      if (!fo.is_open())
+      {
+        err("problem opening file %s for writing!\n",qPrint(orgName));
+        return FALSE;
+      }
+      t.setStream(&fo);
     }
-    t.setStream(&fo);
     while (getline(fi,lineStr)) // foreach line
     {
       std::string line = lineStr+'\n';
       const Map &map = m_maps.front(); // there is only one 'map' for a SVG file
       t << replaceRef(line.c_str(),map.relPath,map.urlOnly,map.context,"_top");
     }
-    t.flush();
     fi.close();
-    fo.close();
+    if (keepUnchanged)
+    {
+      if (!writeFileIfChanged(orgName,t.str()))
+      {
+        return FALSE;
+      }
+      t.clear();
+    }
+    else
+    {
+      t.flush();
+      fo.close();
+    }
   }
   // remove temporary file
   thisDir.remove(tmpName.str());
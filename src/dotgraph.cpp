@@ -30,6 +30,7 @@
 #include "dotfilepatcher.h"
 #include "fileinfo.h"
 #include "portable.h"
+#include "outputarchive.h"
 
 #define MAP_CMD "cmapx"
 
@@ -136,6 +137,8 @@ QCString DotGraph::writeGraph(
   computeTheGraph();
 
   m_regenerate = prepareDotFile();
+  // the image is reused by later runs as long as its .md5 signature matches
+  addDiskFileToOutputArchive(absImgName(),true);
 
   if (!m_doNotAddImageToIndex)
   {
@@ -23,6 +23,7 @@
 
 #include "types.h"
 #include "dotgraph.h"
+#include "memoryusage.h"
 
 class ClassDef;
 class DotNode;
@@ -64,7 +65,7 @@ using DotNodeRefVector = std::vector<DotNode*>;
 using EdgeInfoVector = std::vector<EdgeInfo>;
 
 /** A node in a dot graph */
-class DotNode
+class DotNode : public MemoryCounted<MemoryCategory::DotGraphs,DotNode>
 {
   public:
     static constexpr auto placeholderUrl = "-";
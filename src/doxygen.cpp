@@ -109,6 +109,14 @@
 #include "trace.h"
 #include "moduledef.h"
 #include "stringutil.h"
+#include "outputarchive.h"
+#include "contentstore.h"
+#include "docstore.h"
+#include "fssnapshot.h"
+#include "timeline.h"
+#include "shardmodel.h"
+#include "memoryusage.h"
+#include "namedmutex.h"
 
 #include <sqlite3.h>
 
@@ -162,6 +170,8 @@ ParserManager        *Doxygen::parserManager = nullptr;
 QCString              Doxygen::htmlFileExtension;
 bool                  Doxygen::suppressDocWarnings = FALSE;
 QCString              Doxygen::filterDBFileName;
+QCString              Doxygen::contentStoreFileName;
+QCString              Doxygen::docStoreFileName;
 IndexList            *Doxygen::indexList;
 QCString              Doxygen::spaces;
 bool                  Doxygen::generatingXmlOutput = FALSE;
@@ -170,8 +180,8 @@ bool                  Doxygen::clangAssistedParsing = FALSE;
 QCString              Doxygen::verifiedDotPath;
 volatile bool         Doxygen::terminating = false;
 InputFileEncodingList Doxygen::inputFileEncodingList;
-std::mutex            Doxygen::countFlowKeywordsMutex;
-std::mutex            Doxygen::addExampleMutex;
+NamedMutex            Doxygen::countFlowKeywordsMutex("doxygen.cpp:Doxygen::countFlowKeywordsMutex");
+NamedMutex            Doxygen::addExampleMutex("doxygen.cpp:Doxygen::addExampleMutex");
 StaticInitMap         Doxygen::staticInitMap;
 
 // locally accessible globals
@@ -181,6 +191,10 @@ static OutputList      *g_outputList = nullptr;          // list of output gener
 static StringSet        g_usingDeclarations; // used classes
 static bool             g_successfulRun = FALSE;
 static bool             g_dumpSymbolMap = FALSE;
+static int              g_shardIndex = -1;       // index of the shard to parse (--shard)
+static int              g_shardCount = 0;        // number of shards (--shard)
+static int              g_linkShards = 0;        // number of shard files to link (--link-shards)
+static QCString         g_memoryReportFileName;
 
 // keywords recognised as compounds
 static const StringUnorderedSet g_compoundKeywords =
@@ -220,13 +234,22 @@ class Statistics
     {
       msg("%s", name);
       stats.emplace_back(name,0);
+      Portable::getMemoryUsage(stats.back().rssStart,stats.back().peakRssStart);
       startTime = std::chrono::steady_clock::now();
+      timelineStart = Timeline::beginEvent();
     }
     void end()
     {
       std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
       stats.back().elapsed = static_cast<double>(std::chrono::duration_cast<
                                 std::chrono::microseconds>(endTime - startTime).count())/1000000.0;
+      Portable::getMemoryUsage(stats.back().rssEnd,stats.back().peakRssEnd);
+      if (Timeline::isEnabled())
+      {
+        Timeline::addEvent("phase",phaseName(stats.back()),timelineStart,Timeline::now());
+        Timeline::addCounter("memory",{ { "rss",    stats.back().rssEnd     },
+                                        { "peakRss",stats.back().peakRssEnd } });
+      }
       warn_flush();
     }
     void print()
@@ -244,16 +267,87 @@ class Statistics
       }
       if (restore) Debug::setFlag(Debug::Time);
     }
+    /** Prints the memory usage per phase and the object counters per subsystem */
+    void printMemory()
+    {
+      auto mb = [](int64_t bytes) { return static_cast<double>(bytes)/(1024.0*1024.0); };
+      msg("----------------------\n");
+      msg("Resident memory per phase in MB (at start -> at end, high-water mark at end):\n");
+      for (const auto &s : stats)
+      {
+        msg("%9.1f -> %9.1f, peak %9.1f in %s\n",
+            mb(static_cast<int64_t>(s.rssStart)),mb(static_cast<int64_t>(s.rssEnd)),
+            mb(static_cast<int64_t>(s.peakRssEnd)),qPrint(phaseName(s)));
+      }
+      if (MemoryUsage::countersEnabled())
+      {
+        msg("Objects per subsystem (shallow size in MB):\n");
+        for (int i=0;i<static_cast<int>(MemoryCategory::Count);i++)
+        {
+          MemoryCategory c = static_cast<MemoryCategory>(i);
+          MemoryUsage::Counters counters = MemoryUsage::counters(c);
+          msg("  %-18s created=%" PRIu64 " live=%" PRId64 " size=%.1f peak=%.1f\n",
+              MemoryUsage::categoryName(c),counters.allocations,
+              static_cast<int64_t>(counters.allocations-counters.frees),
+              mb(counters.bytes),mb(counters.peakBytes));
+        }
+      }
+    }
+    /** Writes the memory usage per phase and the object counters per subsystem as JSON */
+    void writeMemoryReport(const QCString &fileName)
+    {
+      std::ofstream t = Portable::openOutputStream(fileName);
+      if (!t.is_open())
+      {
+        err("Could not open file %s for writing the memory report\n",qPrint(fileName));
+        return;
+      }
+      uint64_t rss=0, peakRss=0;
+      Portable::getMemoryUsage(rss,peakRss);
+      t << "{\n  \"peakRss\": " << peakRss << ",\n  \"phases\": [";
+      bool first=true;
+      for (const auto &s : stats)
+      {
+        t << (first ? "\n" : ",\n");
+        t << "    { \"name\": \"" << phaseName(s) << "\", \"seconds\": " << s.elapsed
+          << ", \"rssStart\": " << s.rssStart << ", \"rssEnd\": " << s.rssEnd
+          << ", \"peakRssStart\": " << s.peakRssStart << ", \"peakRssEnd\": " << s.peakRssEnd << " }";
+        first=false;
+      }
+      t << "\n  ],\n  \"subsystems\": {";
+      for (int i=0;i<static_cast<int>(MemoryCategory::Count);i++)
+      {
+        MemoryCategory c = static_cast<MemoryCategory>(i);
+        MemoryUsage::Counters counters = MemoryUsage::counters(c);
+        t << (i==0 ? "\n" : ",\n");
+        t << "    \"" << MemoryUsage::categoryName(c) << "\": { \"allocations\": " << counters.allocations
+          << ", \"frees\": " << counters.frees << ", \"bytes\": " << counters.bytes
+          << ", \"peakBytes\": " << counters.peakBytes << " }";
+      }
+      t << "\n  }\n}\n";
+    }
   private:
     struct stat
     {
       const char *name;
       double elapsed;
+      uint64_t rssStart     = 0;
+      uint64_t rssEnd       = 0;
+      uint64_t peakRssStart = 0;
+      uint64_t peakRssEnd   = 0;
       //stat() : name(nullptr),elapsed(0) {}
       stat(const char *n, double el) : name(n),elapsed(el) {}
     };
+    /** Returns the name of phase \a s without the trailing "...\n" */
+    static QCString phaseName(const stat &s)
+    {
+      QCString name = QCString(s.name).stripWhiteSpace();
+      while (name.endsWith(".")) name=name.left(name.length()-1);
+      return name;
+    }
     std::vector<stat> stats;
     std::chrono::steady_clock::time_point startTime;
+    uint64_t timelineStart = 0;
 } g_s;
 
 
@@ -7999,7 +8093,69 @@ static void generateFileSources()
           filesToProcess.insert(fd->absFilePath().str());
         }
       }
-      // process source files (and their include dependencies)
+
+      // parses the translation unit of source file fd and processes the file together with
+      // the input files in includedFiles, which were assigned to this unit beforehand.
+      // The translation unit kept from the input parsing phase is reused if available.
+      auto processTU = [&](FileDef *fd,const std::vector<FileDef*> &includedFiles,OutputList &ol)
+      {
+        auto clangParser = ClangParser::instance()->createTUParser(fd);
+        clangParser->parse();
+        processSourceFile(fd,ol,clangParser.get());
+        for (FileDef *ifd : includedFiles)
+        {
+          processSourceFile(ifd,ol,clangParser.get());
+        }
+      };
+
+      // processes a single file, using its own translation unit for C/C++ files
+      auto processFile = [&](FileDef *fd,OutputList &ol)
+      {
+        if (fd->getLanguage()==SrcLangExt::Cpp) // C/C++ file, use clang parser
+        {
+          auto clangParser = ClangParser::instance()->createTUParser(fd);
+          clangParser->parse();
+          processSourceFile(fd,ol,clangParser.get());
+        }
+        else // non C/C++ file, use built-in parser
+        {
+          processSourceFile(fd,ol,nullptr);
+        }
+      };
+
+      std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+      if (numThreads>1)
+      {
+        msg("Generating code files using %zu threads.\n",numThreads);
+      }
+      ThreadPool threadPool(numThreads>1 ? numThreads : 0,"source");
+      std::vector< std::future<void> > results;
+      // runs func for fd, in a worker thread with its own copy of the output list if threads are used
+      auto dispatch = [&](FileDef *fd,const std::function<void(FileDef*,OutputList&)> &func)
+      {
+        if (numThreads>1)
+        {
+          auto ol = std::make_shared<OutputList>(*g_outputList);
+          results.emplace_back(threadPool.queue(fd->absFilePath(),[fd,ol,func]()
+          {
+            func(fd,*ol);
+          }));
+        }
+        else
+        {
+          func(fd,*g_outputList);
+        }
+      };
+      auto waitForResults = [&results]()
+      {
+        for (auto &f : results) f.get();
+        results.clear();
+      };
+
+      // process source files (and their include dependencies). The input files included
+      // by a translation unit are assigned to it here, before the unit is queued and in the
+      // same order as a single threaded run, so which unit processes a header does not
+      // depend on the timing of the worker threads.
       for (const auto &fn : *Doxygen::inputNameLinkedMap)
       {
         for (const auto &fd : *fn)
@@ -8007,33 +8163,37 @@ static void generateFileSources()
           if (fd->isSource() && !fd->isReference() && fd->getLanguage()==SrcLangExt::Cpp &&
               (fd->generateSourceFile() ||
                (!fd->isReference() && Doxygen::parseSourcesNeeded)
-              )
+              ) &&
+              processedFiles.insert(fd->absFilePath().str()).second
              )
           {
-            auto clangParser = ClangParser::instance()->createTUParser(fd.get());
-            clangParser->parse();
-            processSourceFile(fd.get(),*g_outputList,clangParser.get());
-
-            for (auto incFile : clangParser->filesInSameTU())
+            StringVector incFiles;
+            fd->getAllIncludeFilesRecursively(incFiles);
+            std::vector<FileDef*> includedFiles;
+            for (const auto &incFile : incFiles)
             {
               if (filesToProcess.find(incFile)!=filesToProcess.end() &&  // part of input
                   fd->absFilePath()!=QCString(incFile) &&                // not same file
-                  processedFiles.find(incFile)==processedFiles.end())    // not yet marked as processed
+                  processedFiles.find(incFile)==processedFiles.end())    // not yet assigned
               {
-                StringVector moreFiles;
                 bool ambig = false;
                 FileDef *ifd=findFileDef(Doxygen::inputNameLinkedMap,incFile.c_str(),ambig);
                 if (ifd && !ifd->isReference())
                 {
-                  processSourceFile(ifd,*g_outputList,clangParser.get());
                   processedFiles.insert(incFile);
+                  includedFiles.push_back(ifd);
                 }
               }
             }
-            processedFiles.insert(fd->absFilePath().str());
+            dispatch(fd.get(),[&processTU,includedFiles](FileDef *tuFd,OutputList &ol)
+            {
+              processTU(tuFd,includedFiles,ol);
+            });
           }
         }
       }
+      waitForResults();
+
       // process remaining files
       for (const auto &fn : *Doxygen::inputNameLinkedMap)
       {
@@ -8041,19 +8201,12 @@ static void generateFileSources()
         {
           if (processedFiles.find(fd->absFilePath().str())==processedFiles.end()) // not yet processed
           {
-            if (fd->getLanguage()==SrcLangExt::Cpp) // C/C++ file, use clang parser
-            {
-              auto clangParser = ClangParser::instance()->createTUParser(fd.get());
-              clangParser->parse();
-              processSourceFile(fd.get(),*g_outputList,clangParser.get());
-            }
-            else // non C/C++ file, use built-in parser
-            {
-              processSourceFile(fd.get(),*g_outputList,nullptr);
-            }
+            dispatch(fd.get(),processFile);
           }
         }
       }
+      waitForResults();
+      ClangParser::instance()->clearKeptTUParsers();
     }
     else
 #endif
@@ -8070,7 +8223,7 @@ static void generateFileSources()
           bool generateSourceFile;
           OutputList ol;
         };
-        ThreadPool threadPool(numThreads);
+        ThreadPool threadPool(numThreads,"source");
         std::vector< std::future< std::shared_ptr<SourceContext> > > results;
         for (const auto &fn : *Doxygen::inputNameLinkedMap)
         {
@@ -8103,7 +8256,7 @@ static void generateFileSources()
               }
               return ctx;
             };
-            results.emplace_back(threadPool.queue(processFile));
+            results.emplace_back(threadPool.queue(fd->absFilePath(),processFile));
           }
         }
         for (auto &f : results)
@@ -8145,7 +8298,7 @@ static void generateFileDocs()
         FileDef *fd;
         OutputList ol;
       };
-      ThreadPool threadPool(numThreads);
+      ThreadPool threadPool(numThreads,"generate");
       std::vector< std::future< std::shared_ptr<DocContext> > > results;
       for (const auto &fn : *Doxygen::inputNameLinkedMap)
       {
@@ -8160,7 +8313,7 @@ static void generateFileDocs()
               ctx->fd->writeDocumentation(ctx->ol);
               return ctx;
             };
-            results.emplace_back(threadPool.queue(processFile));
+            results.emplace_back(threadPool.queue(fd->absFilePath(),processFile));
           }
         }
       }
@@ -8361,7 +8514,7 @@ static void computeTooltipTexts()
   std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
   if (numThreads>1)
   {
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"tooltip");
     std::vector < std::future< void > > results;
     // queue the work
     for (const auto &[name,symList] : *Doxygen::symbolMap)
@@ -8374,7 +8527,7 @@ static void computeTooltipTexts()
           auto processTooltip = [dm]() {
             dm->computeTooltip();
           };
-          results.emplace_back(threadPool.queue(processTooltip));
+          results.emplace_back(threadPool.queue(def->name(),processTooltip));
         }
       }
     }
@@ -8469,7 +8622,7 @@ static void generateDocsForClassList(const std::vector<ClassDefMutable*> &classL
       ClassDefMutable *cd;
       OutputList ol;
     };
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"generate");
     std::vector< std::future< std::shared_ptr<DocContext> > > results;
     for (const auto &cd : classList)
     {
@@ -8496,7 +8649,7 @@ static void generateDocsForClassList(const std::vector<ClassDefMutable*> &classL
           ctx->cd->writeDocumentationForInnerClasses(ctx->ol);
           return ctx;
         };
-        results.emplace_back(threadPool.queue(processFile));
+        results.emplace_back(threadPool.queue(cd->name(),processFile));
       }
     }
     for (auto &f : results)
@@ -9477,7 +9630,7 @@ static void generateNamespaceClassDocs(const ClassLinkedRefMap &classList)
       ClassDefMutable *cdm;
       OutputList ol;
     };
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"generate");
     std::vector< std::future< std::shared_ptr<DocContext> > > results;
     // for each class in the namespace...
     for (const auto &cd : classList)
@@ -9502,7 +9655,7 @@ static void generateNamespaceClassDocs(const ClassLinkedRefMap &classList)
           ctx->cdm->writeDocumentationForInnerClasses(ctx->ol);
           return ctx;
         };
-        results.emplace_back(threadPool.queue(processFile));
+        results.emplace_back(threadPool.queue(cdm->name(),processFile));
       }
     }
     // wait for the results
@@ -10034,7 +10187,7 @@ static void generateDiskNames()
 
 //----------------------------------------------------------------------------
 
-static std::unique_ptr<OutlineParserInterface> getParserForFile(const QCString &fn)
+static OutlineParserPtr getParserForFile(const QCString &fn)
 {
   QCString fileName=fn;
   QCString extension;
@@ -10070,36 +10223,46 @@ static std::shared_ptr<Entry> parseFile(OutlineParserInterface &parser,
   }
 
   FileInfo fi(fileName.str());
-  std::string preBuf;
+  bool preprocess = Config_getBool(ENABLE_PREPROCESSING) && parser.needsPreprocessing(extension);
+  msg("%s %s...\n",preprocess ? "Preprocessing" : "Reading",qPrint(fn));
 
-  if (Config_getBool(ENABLE_PREPROCESSING) &&
-      parser.needsPreprocessing(extension))
-  {
-    Preprocessor preprocessor;
-    const StringVector &includePath = Config_getList(INCLUDE_PATH);
-    for (const auto &s : includePath)
+  std::string convBuf;
+  { // the intermediate buffers are released before the language parser runs
+    // use the file contents directly from memory if no filtering or transcoding is needed,
+    // otherwise read them into inBuf
+    MappedInputFile mappedFile;
+    std::string inBuf;
+    std::string_view input;
+    if (mappedFile.open(fileName))
     {
-      std::string absPath = FileInfo(s).absFilePath();
-      preprocessor.addSearchDir(absPath.c_str());
+      input = mappedFile.contents();
+    }
+    else
+    {
+      readInputFile(fileName,inBuf);
+      addTerminalCharIfMissing(inBuf,'\n');
+      input = inBuf;
     }
-    std::string inBuf;
-    msg("Preprocessing %s...\n",qPrint(fn));
-    readInputFile(fileName,inBuf);
-    addTerminalCharIfMissing(inBuf,'\n');
-    preprocessor.processFile(fileName,inBuf,preBuf);
-  }
-  else // no preprocessing
-  {
-    msg("Reading %s...\n",qPrint(fn));
-    readInputFile(fileName,preBuf);
-    addTerminalCharIfMissing(preBuf,'\n');
-  }
 
-  std::string convBuf;
-  convBuf.reserve(preBuf.size()+1024);
+    std::string preBuf;
+    if (preprocess)
+    {
+      Preprocessor preprocessor;
+      const StringVector &includePath = Config_getList(INCLUDE_PATH);
+      for (const auto &s : includePath)
+      {
+        std::string absPath = FileInfo(s).absFilePath();
+        preprocessor.addSearchDir(absPath.c_str());
+      }
+      preprocessor.processFile(fileName,input,preBuf);
+      input = preBuf;
+    }
 
-  // convert multi-line C++ comments to C style comments
-  convertCppComments(preBuf,convBuf,fileName.str());
+    convBuf.reserve(input.size()+1024);
+
+    // convert multi-line C++ comments to C style comments
+    convertCppComments(input,convBuf,fileName.str());
+  }
 
   std::shared_ptr<Entry> fileRoot = std::make_shared<Entry>();
   // use language parse to parse the file
@@ -10129,13 +10292,20 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
       filesToProcess.insert(s);
     }
 
-    std::mutex processedFilesLock;
+    // result of parsing the source file of a translation unit
+    struct TUResult
+    {
+      std::string fileName;
+      std::unique_ptr<OutlineParserInterface> parser;
+      std::unique_ptr<ClangTUParser> clangParser;
+      std::shared_ptr<Entry> root;
+    };
+
     // process source files (and their include dependencies)
     std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
     msg("Processing input using %zu threads.\n",numThreads);
-    ThreadPool threadPool(numThreads);
-    using FutureType = std::vector< std::shared_ptr<Entry> >;
-    std::vector< std::future< FutureType > > results;
+    ThreadPool threadPool(numThreads,"parse");
+    std::vector< std::future< std::shared_ptr<TUResult> > > tuResults;
     for (const auto &s : g_inputFiles)
     {
       bool ambig = false;
@@ -10143,45 +10313,60 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
       ASSERT(fd!=nullptr);
       if (fd->isSource() && !fd->isReference() && fd->getLanguage()==SrcLangExt::Cpp) // this is a source file
       {
+        processedFiles.insert(s);
         // lambda representing the work to executed by a thread
-        auto processFile = [s,&filesToProcess,&processedFilesLock,&processedFiles]() {
+        auto processFile = [s]() {
           bool ambig_l = false;
-          std::vector< std::shared_ptr<Entry> > roots;
           FileDef *fd_l = findFileDef(Doxygen::inputNameLinkedMap,s.c_str(),ambig_l);
-          auto clangParser = ClangParser::instance()->createTUParser(fd_l);
-          auto parser = getParserForFile(s.c_str());
-          auto fileRoot { parseFile(*parser.get(),fd_l,s.c_str(),clangParser.get(),true) };
-          roots.push_back(fileRoot);
-
-          // Now process any include files in the same translation unit
-          // first. When libclang is used this is much more efficient.
-          for (auto incFile : clangParser->filesInSameTU())
-          {
-            if (filesToProcess.find(incFile)!=filesToProcess.end())
-            {
-              bool needsToBeProcessed = false;
-              {
-                std::lock_guard<std::mutex> lock(processedFilesLock);
-                needsToBeProcessed = processedFiles.find(incFile)==processedFiles.end();
-                if (needsToBeProcessed) processedFiles.insert(incFile);
-              }
-              if (incFile!=s && needsToBeProcessed)
-              {
-                FileDef *ifd=findFileDef(Doxygen::inputNameLinkedMap,incFile.c_str(),ambig_l);
-                if (ifd && !ifd->isReference())
-                {
-                  //printf("  Processing %s in same translation unit as %s\n",incFile,s->c_str());
-                  fileRoot = parseFile(*parser.get(),ifd,incFile.c_str(),clangParser.get(),false);
-                  roots.push_back(fileRoot);
-                }
-              }
-            }
-          }
-          return roots;
+          auto result = std::make_shared<TUResult>();
+          result->fileName = s;
+          result->clangParser = ClangParser::instance()->createTUParser(fd_l);
+          result->parser = getParserForFile(s.c_str());
+          result->root = parseFile(*result->parser.get(),fd_l,s.c_str(),result->clangParser.get(),true);
+          return result;
         };
         // dispatch the work and collect the future results
-        results.emplace_back(threadPool.queue(processFile));
+        tuResults.emplace_back(threadPool.queue(s.c_str(),processFile));
+      }
+    }
+
+    // Now process any include files in the same translation unit
+    // first. When libclang is used this is much more efficient.
+    // The include files are assigned to the translation units here, in the order
+    // of the input files, so which unit parses a file does not depend on the
+    // order in which the threads finish.
+    using FutureType = std::vector< std::shared_ptr<Entry> >;
+    std::vector< std::future< FutureType > > results;
+    for (auto &f : tuResults)
+    {
+      std::shared_ptr<TUResult> tu = f.get();
+      std::vector<FileDef*> includedFiles;
+      for (const auto &incFile : tu->clangParser->filesInSameTU())
+      {
+        if (filesToProcess.find(incFile)!=filesToProcess.end() && // file need to be processed
+            processedFiles.find(incFile)==processedFiles.end())   // and is not processed already
+        {
+          bool ambig = false;
+          FileDef *ifd=findFileDef(Doxygen::inputNameLinkedMap,incFile.c_str(),ambig);
+          if (ifd && !ifd->isReference())
+          {
+            processedFiles.insert(incFile);
+            includedFiles.push_back(ifd);
+          }
+        }
       }
+      auto processIncludes = [tu,includedFiles]() {
+        FutureType roots;
+        roots.push_back(tu->root);
+        for (FileDef *ifd : includedFiles)
+        {
+          //printf("  Processing %s in same translation unit as %s\n",qPrint(ifd->absFilePath()),tu->fileName.c_str());
+          roots.push_back(parseFile(*tu->parser.get(),ifd,ifd->absFilePath(),tu->clangParser.get(),false));
+        }
+        ClangParser::instance()->keepTUParser(std::move(tu->clangParser));
+        return roots;
+      };
+      results.emplace_back(threadPool.queue(tu->fileName.c_str(),processIncludes));
     }
     // synchronise with the Entry result lists produced and add them to the root
     for (auto &f : results)
@@ -10210,6 +10395,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
             auto clangParser = ClangParser::instance()->createTUParser(fd);
             auto fileRoot = parseFile(*parser.get(),fd,s.c_str(),clangParser.get(),true);
             roots.push_back(fileRoot);
+            ClangParser::instance()->keepTUParser(std::move(clangParser));
           }
           else
           {
@@ -10218,7 +10404,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
           }
           return roots;
         };
-        results.emplace_back(threadPool.queue(processFile));
+        results.emplace_back(threadPool.queue(s.c_str(),processFile));
       }
     }
     // synchronise with the Entry result lists produced and add them to the root
@@ -10236,7 +10422,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
   {
     std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
     msg("Processing input using %zu threads.\n",numThreads);
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"parse");
     using FutureType = std::shared_ptr<Entry>;
     std::vector< std::future< FutureType > > results;
     for (const auto &s : g_inputFiles)
@@ -10250,7 +10436,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
         return fileRoot;
       };
       // dispatch the work and collect the future results
-      results.emplace_back(threadPool.queue(processFile));
+      results.emplace_back(threadPool.queue(s.c_str(),processFile));
     }
     // synchronise with the Entry results produced and add them to the root
     for (auto &f : results)
@@ -10308,6 +10494,7 @@ static void parseFilesSingleThreading(const std::shared_ptr<Entry> &root)
             }
           }
         }
+        ClangParser::instance()->keepTUParser(std::move(clangParser));
       }
     }
     // process remaining files
@@ -10323,10 +10510,11 @@ static void parseFilesSingleThreading(const std::shared_ptr<Entry> &root)
           auto parser { getParserForFile(s.c_str()) };
           auto fileRoot = parseFile(*parser.get(),fd,s.c_str(),clangParser.get(),true);
           root->moveToSubEntryAndKeep(fileRoot);
+          ClangParser::instance()->keepTUParser(std::move(clangParser));
         }
         else
         {
-          std::unique_ptr<OutlineParserInterface> parser { getParserForFile(s.c_str()) };
+          auto parser { getParserForFile(s.c_str()) };
           std::shared_ptr<Entry> fileRoot = parseFile(*parser.get(),fd,s.c_str(),nullptr,true);
           root->moveToSubEntryAndKeep(fileRoot);
         }
@@ -10342,13 +10530,95 @@ static void parseFilesSingleThreading(const std::shared_ptr<Entry> &root)
       bool ambig = false;
       FileDef *fd=findFileDef(Doxygen::inputNameLinkedMap,s.c_str(),ambig);
       ASSERT(fd!=nullptr);
-      std::unique_ptr<OutlineParserInterface> parser { getParserForFile(s.c_str()) };
+      auto parser { getParserForFile(s.c_str()) };
       std::shared_ptr<Entry> fileRoot = parseFile(*parser.get(),fd,s.c_str(),nullptr,true);
       root->moveToSubEntryAndKeep(std::move(fileRoot));
     }
   }
 }
 
+//! check that the input can be split over several doxygen processes
+static void checkShardedInput()
+{
+#if USE_LIBCLANG
+  if (Doxygen::clangAssistedParsing)
+  {
+    err("CLANG_ASSISTED_PARSING cannot be used with --shard or --link-shards.\n");
+    cleanUpDoxygen();
+    exit(1);
+  }
+#endif
+  for (const auto &s : g_inputFiles)
+  {
+    if (getLanguageFromFileName(s.c_str())==SrcLangExt::VHDL)
+    {
+      err("VHDL input file %s cannot be used with --shard or --link-shards.\n",s.c_str());
+      cleanUpDoxygen();
+      exit(1);
+    }
+  }
+}
+
+//! parse the input files of one shard and write the results to its shard file
+static void parseFilesOfShard()
+{
+  AUTO_TRACE("shard {} of {}",g_shardIndex,g_shardCount);
+  checkShardedInput();
+  ShardModel &sm = ShardModel::instance();
+  size_t index = 0;
+  for (const auto &s : g_inputFiles)
+  {
+    // files are distributed round robin, so each shard gets files from all directories
+    if (index++%static_cast<size_t>(g_shardCount)!=static_cast<size_t>(g_shardIndex)) continue;
+    bool ambig = false;
+    FileDef *fd=findFileDef(Doxygen::inputNameLinkedMap,s.c_str(),ambig);
+    ASSERT(fd!=nullptr);
+    auto parser { getParserForFile(s.c_str()) };
+    sm.beginFile(s.c_str());
+    std::shared_ptr<Entry> fileRoot = parseFile(*parser.get(),fd,s.c_str(),nullptr,true);
+    sm.endFile(fileRoot,fd);
+  }
+  QCString shardFile = ShardModel::shardFileName(Config_getString(OUTPUT_DIRECTORY),g_shardIndex,g_shardCount);
+  if (!sm.write(shardFile))
+  {
+    cleanUpDoxygen();
+    exit(1);
+  }
+  sm.clear();
+}
+
+//! read the results of the shards and add the files to root in the order of the input files
+static void linkShardFiles(const std::shared_ptr<Entry> &root)
+{
+  AUTO_TRACE("shards={}",g_linkShards);
+  checkShardedInput();
+  ShardModel &sm = ShardModel::instance();
+  QCString outputDirectory = Config_getString(OUTPUT_DIRECTORY);
+  for (int i=0;i<g_linkShards;i++)
+  {
+    if (!sm.read(ShardModel::shardFileName(outputDirectory,i,g_linkShards)))
+    {
+      cleanUpDoxygen();
+      exit(1);
+    }
+  }
+  for (const auto &s : g_inputFiles)
+  {
+    if (!sm.contains(s.c_str()))
+    {
+      err("input file %s is not present in any of the shard files, "
+          "make sure all shards were created with the same configuration.\n",s.c_str());
+      cleanUpDoxygen();
+      exit(1);
+    }
+    bool ambig = false;
+    FileDef *fd=findFileDef(Doxygen::inputNameLinkedMap,s.c_str(),ambig);
+    ASSERT(fd!=nullptr);
+    root->moveToSubEntryAndKeep(sm.replayFile(s.c_str(),fd));
+  }
+  sm.clear();
+}
+
 // resolves a path that may include symlinks, if a recursive symlink is
 // found an empty string is returned.
 static std::string resolveSymlink(const std::string &path)
@@ -10464,10 +10734,12 @@ static void readDir(FileInfo *fi,
   //printf("killSet=%p count=%d\n",killSet,killSet ? (int)killSet->count() : -1);
 
   StringVector dirResultList;
+  FileSystemSnapshot::Listing listing;
 
   for (const auto &dirEntry : dir.iterator())
   {
     FileInfo cfi(dirEntry.path());
+    listing.emplace(cfi.fileName(),FileSystemSnapshot::Entry{dirEntry.is_regular_file(),dirEntry.is_directory()});
     if (exclSet==nullptr || exclSet->find(cfi.absFilePath())==exclSet->end())
     { // file should not be excluded
       //printf("killSet->find(%s)\n",qPrint(cfi->absFilePath()));
@@ -10516,6 +10788,8 @@ static void readDir(FileInfo *fi,
       }
     }
   }
+  // remember the contents, so include files in this directory can be found without system calls
+  FileSystemSnapshot::instance().addListing(dirName,std::move(listing));
   if (resultList && !dirResultList.empty())
   {
     // sort the resulting list to make the order platform independent.
@@ -10659,7 +10933,15 @@ static void devUsage()
   msg("  -t        [<file|stdout|stderr>] trace debug info to file, stdout, or stderr (default file stdout)\n");
   msg("  -t_notime [<file|stdout|stderr>] trace debug info to file, stdout, or stderr (default file stdout),\n"
       "                                   but without time and thread information\n");
+  msg("  --trace-subsystems <list>  only trace the subsystems in the comma separated list; one or more of\n"
+      "                             general, symbolresolver, markdown, docparser, all (default all)\n");
+  msg("  --trace-sample <n>  only trace one in n calls of each function in the symbolresolver,\n"
+      "                      markdown and docparser subsystems\n");
 #endif
+  msg("  --timeline <file>  write a timeline of the phases, tasks and external tools of the run\n"
+      "                     to file in the Chrome trace event format\n");
+  msg("  --memory-report <file>  write the memory usage per phase and the number of objects\n"
+      "                          created per subsystem to file in JSON format\n");
   msg("  -d <level>  enable a debug level, such as (multiple invocations of -d are possible):\n");
   Debug::printFlags();
 }
@@ -10730,6 +11012,9 @@ static void usage(const QCString &name,const QCString &versionString)
   msg("   If configName is omitted 'Doxyfile' will be used as a default.\n");
   msg("   If - is used for configFile doxygen will write / read the configuration to /from standard output / input.\n\n");
   msg("If -q is used for a doxygen documentation run, doxygen will see this as if QUIET=YES has been set.\n\n");
+  msg("If --shard index/count is used for a doxygen documentation run, doxygen only parses its part of the\n");
+  msg("input files and writes the results to doxygen_shard_<index>_of_<count>.dat in the output directory.\n");
+  msg("Once all shards are written, --link-shards count reads them and generates the documentation.\n\n");
   msg("-v print version string, -V print extended version information\n");
   msg("-h,-? prints usage help information\n");
   msg("%s -d prints additional usage flags for debugging purposes\n",qPrint(name));
@@ -11177,6 +11462,111 @@ void readConfiguration(int argc, char **argv)
           cleanUpDoxygen();
           exit(0);
         }
+        else if (qstrcmp(&argv[optInd][2],"shard")==0)
+        {
+          if (optInd+1>=argc || argv[optInd+1][0]=='-')
+          {
+            err("option \"--shard\" is missing the shard in the form index/count.\n");
+            usage(argv[0],versionString);
+            exit(1);
+          }
+          QCString value = argv[++optInd];
+          int slash = value.find('/');
+          bool okIndex=false, okCount=false;
+          if (slash!=-1)
+          {
+            g_shardIndex = value.left(slash).toInt(&okIndex);
+            g_shardCount = value.mid(slash+1).toInt(&okCount);
+          }
+          if (!okIndex || !okCount || g_shardCount<1 || g_shardIndex<0 || g_shardIndex>=g_shardCount)
+          {
+            err("option \"--shard\" expects index/count with 0<=index<count, found: \"%s\".\n",qPrint(value));
+            exit(1);
+          }
+          if (g_linkShards>0)
+          {
+            err("options \"--shard\" and \"--link-shards\" cannot be combined.\n");
+            exit(1);
+          }
+        }
+        else if (qstrcmp(&argv[optInd][2],"link-shards")==0)
+        {
+          if (optInd+1>=argc || argv[optInd+1][0]=='-')
+          {
+            err("option \"--link-shards\" is missing the number of shards.\n");
+            usage(argv[0],versionString);
+            exit(1);
+          }
+          QCString value = argv[++optInd];
+          bool ok=false;
+          g_linkShards = value.toInt(&ok);
+          if (!ok || g_linkShards<1)
+          {
+            err("option \"--link-shards\" expects a positive number, found: \"%s\".\n",qPrint(value));
+            exit(1);
+          }
+          if (g_shardCount>0)
+          {
+            err("options \"--shard\" and \"--link-shards\" cannot be combined.\n");
+            exit(1);
+          }
+        }
+        else if (qstrcmp(&argv[optInd][2],"trace-subsystems")==0 ||
+                 qstrcmp(&argv[optInd][2],"trace-sample")==0)
+        {
+#if ENABLE_TRACING
+          if (optInd+1>=argc || argv[optInd+1][0]=='-')
+          {
+            err("option \"%s\" is missing its argument.\n",argv[optInd]);
+            devUsage();
+            exit(1);
+          }
+          QCString option = argv[optInd];
+          QCString value  = argv[++optInd];
+          if (option=="--trace-sample")
+          {
+            bool ok=false;
+            uint32_t n = value.toUInt(&ok);
+            if (!ok || n==0)
+            {
+              err("option \"--trace-sample\" expects a positive number, found: \"%s\".\n",qPrint(value));
+              exit(1);
+            }
+            Trace::setSampleRate(n);
+          }
+          else if (!Trace::setMask(value))
+          {
+            err("option \"--trace-subsystems\" has an unknown subsystem in: \"%s\".\n",qPrint(value));
+            devUsage();
+            exit(1);
+          }
+#else
+          err("support for option \"%s\" has not been compiled in (use a debug build or a release build with tracing enabled).\n",argv[optInd]);
+          cleanUpDoxygen();
+          exit(1);
+#endif
+        }
+        else if (qstrcmp(&argv[optInd][2],"memory-report")==0)
+        {
+          if (optInd+1>=argc || argv[optInd+1][0]=='-')
+          {
+            err("option \"--memory-report\" is missing the name of the output file.\n");
+            devUsage();
+            exit(1);
+          }
+          g_memoryReportFileName = argv[++optInd];
+          MemoryUsage::enableCounters();
+        }
+        else if (qstrcmp(&argv[optInd][2],"timeline")==0)
+        {
+          if (optInd+1>=argc || argv[optInd+1][0]=='-')
+          {
+            err("option \"--timeline\" is missing the name of the output file.\n");
+            devUsage();
+            exit(1);
+          }
+          Timeline::enable(argv[++optInd]);
+        }
         else
         {
           err("Unknown option \"-%s\"\n",&argv[optInd][1]);
@@ -11203,6 +11593,15 @@ void readConfiguration(int argc, char **argv)
     optInd++;
   }
 
+  if (Debug::isFlagSet(Debug::Memory))
+  {
+    MemoryUsage::enableCounters();
+  }
+  if (Debug::isFlagSet(Debug::Locks))
+  {
+    LockStatistics::enable();
+  }
+
   /**************************************************************************
    *            Parse or generate the config file                           *
    **************************************************************************/
@@ -11433,6 +11832,14 @@ static void stopDoxygen(int)
   {
     thisDir.remove(Doxygen::filterDBFileName.str());
   }
+  if (!Doxygen::contentStoreFileName.isEmpty())
+  {
+    thisDir.remove(Doxygen::contentStoreFileName.str());
+  }
+  if (!Doxygen::docStoreFileName.isEmpty())
+  {
+    thisDir.remove(Doxygen::docStoreFileName.str());
+  }
   killpg(0,SIGINT);
   cleanUpDoxygen();
   Doxygen::terminating=true;
@@ -11529,6 +11936,14 @@ static void exitDoxygen() noexcept
     {
       thisDir.remove(Doxygen::filterDBFileName.str());
     }
+    if (!Doxygen::contentStoreFileName.isEmpty())
+    {
+      thisDir.remove(Doxygen::contentStoreFileName.str());
+    }
+    if (!Doxygen::docStoreFileName.isEmpty())
+    {
+      thisDir.remove(Doxygen::docStoreFileName.str());
+    }
   }
 }
 
@@ -11836,6 +12251,16 @@ void parseInput()
   uint32_t pid = Portable::pid();
   Doxygen::filterDBFileName.sprintf("doxygen_filterdb_%d.tmp",pid);
   Doxygen::filterDBFileName.prepend(outputDirectory+"/");
+  Doxygen::contentStoreFileName.sprintf("doxygen_content_%d.tmp",pid);
+  Doxygen::contentStoreFileName.prepend(outputDirectory+"/");
+  ContentStore::instance().init(Doxygen::contentStoreFileName,
+                                static_cast<size_t>(Config_getInt(INPUT_CACHE_SIZE))*1024*1024);
+  if (Config_getBool(DOC_STORE_ON_DISK))
+  {
+    Doxygen::docStoreFileName.sprintf("doxygen_docs_%d.tmp",pid);
+    Doxygen::docStoreFileName.prepend(outputDirectory+"/");
+    DocStore::instance().open(Doxygen::docStoreFileName);
+  }
 
   /**************************************************************************
    *            Check/create output directories                             *
@@ -12021,7 +12446,15 @@ void parseInput()
   addSTLSupport(root);
 
   g_s.begin("Parsing files\n");
-  if (Config_getInt(NUM_PROC_THREADS)==1)
+  if (g_shardCount>0)
+  {
+    parseFilesOfShard();
+  }
+  else if (g_linkShards>0)
+  {
+    linkShardFiles(root);
+  }
+  else if (Config_getInt(NUM_PROC_THREADS)==1)
   {
     parseFilesSingleThreading(root);
   }
@@ -12031,6 +12464,11 @@ void parseInput()
   }
   g_s.end();
 
+  if (g_shardCount>0) // the rest is done by the link step
+  {
+    return;
+  }
+
   /**************************************************************************
    *             Gather information                                         *
    **************************************************************************/
@@ -12405,6 +12843,25 @@ void parseInput()
 void generateOutput()
 {
   AUTO_TRACE();
+  if (g_shardCount>0) // only the input files of a single shard were parsed
+  {
+    if (Timeline::isEnabled())
+    {
+      Timeline::write();
+    }
+    cleanUpDoxygen();
+    ContentStore::instance().clear();
+    DocStore::instance().close();
+    FileSystemSnapshot::instance().clear();
+    Dir thisDir;
+    thisDir.remove(Doxygen::filterDBFileName.str());
+    finishWarnExit();
+    exitTracing();
+    Config::deinit();
+    g_successfulRun=TRUE;
+    return;
+  }
+
   /**************************************************************************
    *            Initialize output generators                                *
    **************************************************************************/
@@ -12426,6 +12883,8 @@ void generateOutput()
   bool generateDocbook = Config_getBool(GENERATE_DOCBOOK);
 
 
+  initOutputArchives();
+
   g_outputList = new OutputList;
   if (generateHtml)
   {
@@ -12685,6 +13144,8 @@ void generateOutput()
     g_s.end();
   }
 
+  finalizeOutputArchives();
+
   if (generateHtml &&
       Config_getBool(GENERATE_HTMLHELP) &&
       !Config_getString(HHC_LOCATION).isEmpty())
@@ -12717,12 +13178,75 @@ void generateOutput()
       Doxygen::symbolLookupCache->misses());
   int typeCacheParam   = computeIdealCacheParam(static_cast<size_t>(Doxygen::typeLookupCache->misses()*2/3)); // part of the cache is flushed, hence the 2/3 correction factor
   int symbolCacheParam = computeIdealCacheParam(static_cast<size_t>(Doxygen::symbolLookupCache->misses()));
+  msg("input content store hits=%" PRIu64 " misses=%" PRIu64 " spilled=%" PRIu64 "\n",
+      ContentStore::instance().hits(),
+      ContentStore::instance().misses(),
+      ContentStore::instance().spilled());
+  msg("parser pool created=%zu reused=%zu\n",
+      ObjectPool<OutlineParserInterface>::created()+ObjectPool<CodeParserInterface>::created()+ObjectPool<IDocParser>::created(),
+      ObjectPool<OutlineParserInterface>::reused() +ObjectPool<CodeParserInterface>::reused() +ObjectPool<IDocParser>::reused());
+  msg("file system snapshot directories=%" PRIu64 " hits=%" PRIu64 " misses=%" PRIu64 " include hits=%" PRIu64 " misses=%" PRIu64 "\n",
+      FileSystemSnapshot::instance().directories(),
+      FileSystemSnapshot::instance().hits(),
+      FileSystemSnapshot::instance().misses(),
+      FileSystemSnapshot::instance().includeHits(),
+      FileSystemSnapshot::instance().includeMisses());
+  msg("macro expansion memo hits=%" PRIu64 " misses=%" PRIu64 "\n",
+      Preprocessor::macroMemoHits(),
+      Preprocessor::macroMemoMisses());
+  if (DocStore::instance().bytes()>0)
+  {
+    msg("documentation store strings=%" PRIu64 " size=%.1f MB\n",
+        DocStore::instance().strings(),
+        static_cast<double>(DocStore::instance().bytes())/(1024.0*1024.0));
+  }
+  if (Timeline::isEnabled())
+  {
+    Timeline::addCounter("type lookup cache",{ { "hits",  Doxygen::typeLookupCache->hits()   },
+                                               { "misses",Doxygen::typeLookupCache->misses() } });
+    Timeline::addCounter("symbol lookup cache",{ { "hits",  Doxygen::symbolLookupCache->hits()   },
+                                                 { "misses",Doxygen::symbolLookupCache->misses() } });
+    Timeline::addCounter("input content store",{ { "hits",   ContentStore::instance().hits()    },
+                                                 { "misses", ContentStore::instance().misses()  },
+                                                 { "spilled",ContentStore::instance().spilled() } });
+    Timeline::addCounter("parser pool",{ { "created",ObjectPool<OutlineParserInterface>::created()+ObjectPool<CodeParserInterface>::created()+ObjectPool<IDocParser>::created() },
+                                         { "reused", ObjectPool<OutlineParserInterface>::reused() +ObjectPool<CodeParserInterface>::reused() +ObjectPool<IDocParser>::reused()  } });
+    Timeline::addCounter("file system snapshot",{ { "hits",         FileSystemSnapshot::instance().hits()          },
+                                                  { "misses",       FileSystemSnapshot::instance().misses()        },
+                                                  { "includeHits",  FileSystemSnapshot::instance().includeHits()   },
+                                                  { "includeMisses",FileSystemSnapshot::instance().includeMisses() } });
+    Timeline::addCounter("macro expansion memo",{ { "hits",  Preprocessor::macroMemoHits()   },
+                                                  { "misses",Preprocessor::macroMemoMisses() } });
+    Timeline::addCounter("documentation store",{ { "strings",DocStore::instance().strings() },
+                                                 { "bytes",  DocStore::instance().bytes()   } });
+    Timeline::write();
+  }
   int cacheParam = std::max(typeCacheParam,symbolCacheParam);
   if (cacheParam>Config_getInt(LOOKUP_CACHE_SIZE))
   {
     msg("Note: based on cache misses the ideal setting for LOOKUP_CACHE_SIZE is %d at the cost of higher memory usage.\n",cacheParam);
   }
 
+  if (Config_getBool(KEEP_UNCHANGED_FILES))
+  {
+    size_t filesWritten=0, filesUnchanged=0;
+    getOutputFileCounts(filesWritten,filesUnchanged);
+    msg("Output files written: %zu, left unchanged: %zu\n",filesWritten,filesUnchanged);
+  }
+
+  if (Debug::isFlagSet(Debug::Memory))
+  {
+    g_s.printMemory();
+  }
+  if (!g_memoryReportFileName.isEmpty())
+  {
+    g_s.writeMemoryReport(g_memoryReportFileName);
+  }
+  if (Debug::isFlagSet(Debug::Locks))
+  {
+    LockStatistics::printAll();
+  }
+
   if (Debug::isFlagSet(Debug::Time))
   {
 
@@ -12751,6 +13275,9 @@ void generateOutput()
   cleanUpDoxygen();
 
   finalizeSearchIndexer();
+  ContentStore::instance().clear();
+  DocStore::instance().close();
+  FileSystemSnapshot::instance().clear();
   Dir thisDir;
   thisDir.remove(Doxygen::filterDBFileName.str());
   finishWarnExit();
@@ -26,6 +26,8 @@
 #include "cache.h"
 #include "symbolmap.h"
 #include "searchindex.h"
+#include "memoryusage.h"
+#include "namedmutex.h"
 
 #define THREAD_LOCAL thread_local
 #define AtomicInt    std::atomic_int
@@ -52,7 +54,7 @@ class Preprocessor;
 struct MemberGroupInfo;
 class NamespaceDefMutable;
 
-struct LookupInfo
+struct LookupInfo : public MemoryCounted<MemoryCategory::LookupCaches,LookupInfo>
 {
   LookupInfo() = default;
   LookupInfo(const Definition *d,const MemberDef *td,const QCString &ts,const QCString &rt)
@@ -121,6 +123,8 @@ class Doxygen
     static ParserManager            *parserManager;
     static bool                      suppressDocWarnings;
     static QCString                  filterDBFileName;
+    static QCString                  contentStoreFileName;
+    static QCString                  docStoreFileName;
     static IndexList                *indexList;
     static QCString                  spaces;
     static bool                      generatingXmlOutput;
@@ -129,8 +133,8 @@ class Doxygen
     static QCString                  verifiedDotPath;
     static volatile bool             terminating;
     static InputFileEncodingList     inputFileEncodingList;
-    static std::mutex                countFlowKeywordsMutex;
-    static std::mutex                addExampleMutex;
+    static NamedMutex                countFlowKeywordsMutex;
+    static NamedMutex                addExampleMutex;
     static StaticInitMap             staticInitMap;
 };
 
@@ -13,12 +13,15 @@
  *
  */
 
+#include <array>
+
 #include "emoji.h"
 #include "message.h"
 #include "util.h"
 #include "textstream.h"
+#include "staticmap.h"
 
-static struct emojiEntityInfo
+static constexpr struct emojiEntityInfo
 {
   const char *name;
   const char *unicode;
@@ -1882,7 +1885,7 @@ static struct emojiEntityInfo
   { ":zzz:",                                   "&#x1f4a4;"                            },
 };
 // compatibility with older versions
-static struct emojiEntityCompatibility
+static constexpr struct emojiEntityCompatibility
 {
   const char *oldName;
   const char *newName;
@@ -1894,22 +1897,38 @@ static struct emojiEntityCompatibility
   {":person_with_pouting_face:",              ":pouting_face:"},
 };
 
-static const size_t g_numEmojiEntities = sizeof(g_emojiEntities)/sizeof(*g_emojiEntities);
-static const size_t g_numEmojiCompatibilityEntities = sizeof(g_emojiCompatibilityEntities)/sizeof(*g_emojiCompatibilityEntities);
-
-EmojiEntityMapper *EmojiEntityMapper::s_instance = nullptr;
+static constexpr size_t g_numEmojiEntities = sizeof(g_emojiEntities)/sizeof(*g_emojiEntities);
+static constexpr size_t g_numEmojiCompatibilityEntities = sizeof(g_emojiCompatibilityEntities)/sizeof(*g_emojiCompatibilityEntities);
 
-EmojiEntityMapper::EmojiEntityMapper()
+//! Returns the table used to look up an emoji by its name, built at compile time.
+//! The old names are mapped to the index of their new name, or -1 if it does not exist.
+static constexpr std::array<StaticMapEntry<int>,g_numEmojiEntities+g_numEmojiCompatibilityEntities> makeEmojiNames()
 {
+  std::array<StaticMapEntry<int>,g_numEmojiEntities+g_numEmojiCompatibilityEntities> result {};
   for (size_t i = 0; i < g_numEmojiEntities; i++)
   {
-    m_name2symGh.insert(std::make_pair(g_emojiEntities[i].name, static_cast<int>(i)));
+    result[i] = { g_emojiEntities[i].name, static_cast<int>(i) };
   }
   for (size_t i = 0; i < g_numEmojiCompatibilityEntities; i++)
   {
-    int ii = symbol2index(g_emojiCompatibilityEntities[i].newName);
-    if (ii != -1) m_name2symGh.insert(std::make_pair(g_emojiCompatibilityEntities[i].oldName, ii));
+    int ii = -1;
+    std::string_view newName = g_emojiCompatibilityEntities[i].newName;
+    for (size_t j = 0; j < g_numEmojiEntities && ii==-1; j++)
+    {
+      if (newName==std::string_view(g_emojiEntities[j].name)) ii = static_cast<int>(j);
+    }
+    result[g_numEmojiEntities+i] = { g_emojiCompatibilityEntities[i].oldName, ii };
   }
+  return result;
+}
+
+static constexpr auto g_emojiNames = makeEmojiNames();
+static constexpr auto g_emojiMap   = makeStaticMap(g_emojiNames);
+
+EmojiEntityMapper *EmojiEntityMapper::s_instance = nullptr;
+
+EmojiEntityMapper::EmojiEntityMapper()
+{
 }
 
 EmojiEntityMapper::~EmojiEntityMapper()
@@ -1931,8 +1950,7 @@ EmojiEntityMapper &EmojiEntityMapper::instance()
  */
 int EmojiEntityMapper::symbol2index(const std::string &symName) const
 {
-  auto it = m_name2symGh.find(symName);
-  return it!=m_name2symGh.end() ? it->second : -1;
+  return g_emojiMap.value(symName,-1);
 }
 
 /*!
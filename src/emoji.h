@@ -15,7 +15,6 @@
 #ifndef EMOJIENTITY_H
 #define EMOJIENTITY_H
 
-#include <map>
 #include <string>
 
 #include "construct.h"
@@ -37,7 +36,6 @@ class EmojiEntityMapper
    ~EmojiEntityMapper();
     NON_COPYABLE(EmojiEntityMapper)
     static EmojiEntityMapper *s_instance;
-    std::map<std::string,int> m_name2symGh;
 };
 
 #endif
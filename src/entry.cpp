@@ -44,7 +44,7 @@ Entry::Entry() : section(EntryType::makeEmpty()), program(static_cast<size_t>(0)
   reset();
 }
 
-Entry::Entry(const Entry &e) : section(e.section)
+Entry::Entry(const Entry &e) : MemoryCounted(e), section(e.section)
 {
   //printf("Entry::Entry(%p):copy\n",this);
   g_num++;
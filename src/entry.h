@@ -28,6 +28,7 @@
 #include "reflist.h"
 #include "textstream.h"
 #include "configvalues.h"
+#include "memoryusage.h"
 
 class SectionInfo;
 class FileDef;
@@ -111,7 +112,7 @@ struct TagInfo
  *  parseMain() in scanner.l will generate a tree of these
  *  entries.
  */
-class Entry
+class Entry : public MemoryCounted<MemoryCategory::EntryTree,Entry>
 {
   public:
 
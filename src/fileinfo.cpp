@@ -27,6 +27,16 @@ size_t FileInfo::size() const
   return ec ? 0 : result;
 }
 
+/** Returns the modification time of the file as an opaque number, or 0 if it is not known.
+ *  Only meant to detect changes by comparing the result of two calls.
+ */
+int64_t FileInfo::lastModified() const
+{
+  std::error_code ec;
+  fs::file_time_type t = fs::last_write_time(fs::path(m_name),ec);
+  return ec ? 0 : static_cast<int64_t>(t.time_since_epoch().count());
+}
+
 bool FileInfo::exists() const
 {
   std::error_code ec;
@@ -36,6 +36,9 @@
 // TODO: remove these dependencies
 #include "doxygen.h"   // for Doxygen::indexList
 #include "indexlist.h" // for Doxygen::indexList
+#include "namedmutex.h"
+#include "shardmodel.h"
+#include "outputarchive.h"
 
 static int determineInkscapeVersion(const Dir &thisDir);
 
@@ -329,7 +332,7 @@ static bool extractBoundingBox(const QCString &formBase,
   return true;
 }
 
-static std::mutex g_formulaUpdateMutex;
+static NamedMutex g_formulaUpdateMutex("formula.cpp:g_formulaUpdateMutex");
 
 static double updateFormulaSize(Formula *formula,int x1,int y1,int x2,int y2)
 {
@@ -340,7 +343,7 @@ static double updateFormulaSize(Formula *formula,int x1,int y1,int x2,int y2)
 
   if (formula)
   {
-    std::lock_guard<std::mutex> lock(g_formulaUpdateMutex);
+    std::lock_guard<NamedMutex> lock(g_formulaUpdateMutex);
     formula->setWidth(static_cast<int>((x2-x1)*scaleFactor+0.5));
     formula->setHeight(static_cast<int>((y2-y1)*scaleFactor+0.5));
   }
@@ -574,7 +577,7 @@ void FormulaManager::createFormulasTexFile(Dir &thisDir,Format format,HighDPI hd
     std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
     if (numThreads>1) // multi-threaded version
     {
-      ThreadPool threadPool(numThreads);
+      ThreadPool threadPool(numThreads,"formula");
       std::vector< std::future< StringVector > > results;
       for (int pageNum : formulasToGenerate)
       {
@@ -584,7 +587,7 @@ void FormulaManager::createFormulasTexFile(Dir &thisDir,Format format,HighDPI hd
         {
           return generateFormula(thisDir,formulaFileName,formula,pageNum,pageIndex,format,hd,mode);
         };
-        results.emplace_back(threadPool.queue(processFormula));
+        results.emplace_back(threadPool.queue("formula "+QCString().setNum(pageNum),processFormula));
         pageIndex++;
       }
       for (auto &f : results)
@@ -669,6 +672,17 @@ void FormulaManager::generateImages(const QCString &path,Format format,HighDPI h
     createFormulasTexFile(thisDir,format,hd,Mode::Dark);
   }
 
+  // the images are reused by later runs as long as they are listed in formula.repository
+  bool darkMode = Config_getEnum(HTML_COLORSTYLE)!=HTML_COLORSTYLE_t::LIGHT;
+  QCString imgExt = format==Format::Vector ? ".svg" : ".png";
+  for (const auto &formula : p->formulas)
+  {
+    QCString baseName;
+    baseName.sprintf("%s/form_%d",d.absPath().c_str(),formula->id());
+    addDiskFileToOutputArchive(baseName+imgExt,true);
+    if (darkMode) addDiskFileToOutputArchive(baseName+"_dark"+imgExt,true);
+  }
+
   // clean up temporary files
   if (!Debug::isFlagSet(Debug::Formula))
   {
@@ -693,12 +707,14 @@ int FormulaManager::addFormula(const std::string &formulaText,int width,int heig
   Formula *formula = p->formulas.find(formulaText);
   if (formula) // same formula already stored
   {
+    ShardModel::instance().recordFormula(formulaText,formula->id());
     return formula->id();
   }
   // add new formula
   int id = static_cast<int>(p->formulas.size());
   formula = p->formulas.add(formulaText.c_str(),id,width,height);
   p->formulaIdMap.insert(std::make_pair(id,formula));
+  ShardModel::instance().recordFormula(formulaText,id);
   return id;
 }
 
@@ -722,13 +738,13 @@ bool FormulaManager::hasFormulas() const
   return !p->formulas.empty();
 }
 
-static std::mutex g_inkscapeDetectionMutex;
+static NamedMutex g_inkscapeDetectionMutex("formula.cpp:g_inkscapeDetectionMutex");
 
 // helper function to detect and return the major version of inkscape.
 // return -1 if the version cannot be determined.
 static int determineInkscapeVersion(const Dir &thisDir)
 {
-  std::lock_guard<std::mutex> lock(g_inkscapeDetectionMutex);
+  std::lock_guard<NamedMutex> lock(g_inkscapeDetectionMutex);
   // The command line interface (CLI) of Inkscape 1.0 has changed in comparison to
   // previous versions. In order to invokine Inkscape, the used version is detected
   // and based on the version the right syntax of the CLI is chosen.
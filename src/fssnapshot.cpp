@@ -0,0 +1,254 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <mutex>
+
+#include "fssnapshot.h"
+#include "dir.h"
+#include "fileinfo.h"
+#include "portable.h"
+#include "qcstring.h"
+
+/** Contents of a single directory */
+struct DirSnapshot
+{
+  FileSystemSnapshot::Listing entries;
+  bool complete = false; // false if the entries could not be read, queries then use system calls
+};
+
+struct FileSystemSnapshot::Private
+{
+  std::mutex mutex;
+  std::unordered_map< std::string, std::shared_ptr<const DirSnapshot> > dirs;
+  std::unordered_map< std::string, size_t > sizes;
+  std::unordered_map< std::string, std::string > includes;
+  bool     caseSensitive = true;
+  uint64_t directories   = 0;
+  uint64_t hits          = 0;
+  uint64_t misses        = 0;
+  uint64_t includeHits   = 0;
+  uint64_t includeMisses = 0;
+
+  std::string entryName(const std::string &name) const
+  {
+    return caseSensitive ? name : QCString(name).lower().str();
+  }
+
+  /** Stores \a ds for \a dirName unless another thread did so first, returns the stored version */
+  std::shared_ptr<const DirSnapshot> store(const std::string &dirName,std::shared_ptr<const DirSnapshot> &&ds)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto result = dirs.emplace(dirName,std::move(ds));
+    if (result.second) directories++;
+    return result.first->second;
+  }
+
+  std::shared_ptr<const DirSnapshot> read(const std::string &dirName)
+  {
+    auto ds = std::make_shared<DirSnapshot>();
+    FileInfo fi(dirName);
+    if (fi.isDir())
+    {
+      Dir dir(dirName);
+      for (const auto &dirEntry : dir.iterator())
+      {
+        Entry entry;
+        entry.isFile = dirEntry.is_regular_file();
+        entry.isDir  = dirEntry.is_directory();
+        ds->entries.emplace(entryName(FileInfo(dirEntry.path()).fileName()),entry);
+      }
+      // an empty result may also mean the directory is not readable but still searchable
+      ds->complete = !ds->entries.empty();
+    }
+    else // a path in a non existing directory does not exist either
+    {
+      ds->complete = true;
+    }
+    return ds;
+  }
+
+  /** Returns the entry for \a path in \a entry, or FALSE if the snapshot cannot answer
+   *  the query for \a path and the file system needs to be asked.
+   */
+  bool lookup(const std::string &path,bool &found,Entry &entry)
+  {
+    std::string absPath = FileInfo(path).absFilePath();
+    size_t i = absPath.rfind('/');
+    if (i==std::string::npos || i+1==absPath.length()) return false;
+    std::string dirName = i==0 ? std::string("/") : absPath.substr(0,i);
+    if (dirName.length()==2 && dirName[1]==':') dirName+='/'; // root of a drive
+    std::string name = entryName(absPath.substr(i+1));
+
+    std::shared_ptr<const DirSnapshot> ds;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = dirs.find(dirName);
+      if (it!=dirs.end()) ds = it->second;
+    }
+    if (!ds) // read outside the lock
+    {
+      ds = store(dirName,read(dirName));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!ds->complete)
+    {
+      misses++;
+      return false;
+    }
+    hits++;
+    auto it = ds->entries.find(name);
+    found = it!=ds->entries.end();
+    if (found) entry = it->second;
+    return true;
+  }
+};
+
+FileSystemSnapshot &FileSystemSnapshot::instance()
+{
+  static FileSystemSnapshot theInstance;
+  return theInstance;
+}
+
+FileSystemSnapshot::FileSystemSnapshot() : p(std::make_unique<Private>())
+{
+  p->caseSensitive = Portable::fileSystemIsCaseSensitive();
+}
+
+FileSystemSnapshot::~FileSystemSnapshot() = default;
+
+void FileSystemSnapshot::addListing(const std::string &dirName,Listing &&entries)
+{
+  auto ds = std::make_shared<DirSnapshot>();
+  if (p->caseSensitive)
+  {
+    ds->entries = std::move(entries);
+  }
+  else
+  {
+    for (const auto &kv : entries) ds->entries.emplace(p->entryName(kv.first),kv.second);
+  }
+  ds->complete = !ds->entries.empty();
+  p->store(FileInfo(dirName).absFilePath(),std::move(ds));
+}
+
+void FileSystemSnapshot::addDirectory(const std::string &dirName)
+{
+  std::string absName = FileInfo(dirName).absFilePath();
+  {
+    std::lock_guard<std::mutex> lock(p->mutex);
+    if (p->dirs.find(absName)!=p->dirs.end()) return;
+  }
+  p->store(absName,p->read(absName));
+}
+
+bool FileSystemSnapshot::exists(const std::string &path)
+{
+  bool found = false;
+  Entry entry;
+  if (p->lookup(path,found,entry)) return found;
+  return FileInfo(path).exists();
+}
+
+bool FileSystemSnapshot::isFile(const std::string &path)
+{
+  bool found = false;
+  Entry entry;
+  if (p->lookup(path,found,entry)) return found && entry.isFile;
+  return FileInfo(path).isFile();
+}
+
+bool FileSystemSnapshot::isDir(const std::string &path)
+{
+  bool found = false;
+  Entry entry;
+  if (p->lookup(path,found,entry)) return found && entry.isDir;
+  return FileInfo(path).isDir();
+}
+
+size_t FileSystemSnapshot::size(const std::string &path)
+{
+  std::string absPath = FileInfo(path).absFilePath();
+  {
+    std::lock_guard<std::mutex> lock(p->mutex);
+    auto it = p->sizes.find(absPath);
+    if (it!=p->sizes.end())
+    {
+      p->hits++;
+      return it->second;
+    }
+  }
+  size_t result = isFile(absPath) ? FileInfo(absPath).size() : 0;
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->sizes.emplace(absPath,result);
+  return result;
+}
+
+bool FileSystemSnapshot::findInclude(const std::string &key,std::string &path)
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  auto it = p->includes.find(key);
+  if (it!=p->includes.end())
+  {
+    path = it->second;
+    p->includeHits++;
+    return true;
+  }
+  p->includeMisses++;
+  return false;
+}
+
+void FileSystemSnapshot::insertInclude(const std::string &key,const std::string &path)
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->includes.emplace(key,path);
+}
+
+void FileSystemSnapshot::clear()
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->dirs.clear();
+  p->sizes.clear();
+  p->includes.clear();
+}
+
+uint64_t FileSystemSnapshot::directories() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->directories;
+}
+
+uint64_t FileSystemSnapshot::hits() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->hits;
+}
+
+uint64_t FileSystemSnapshot::misses() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->misses;
+}
+
+uint64_t FileSystemSnapshot::includeHits() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->includeHits;
+}
+
+uint64_t FileSystemSnapshot::includeMisses() const
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->includeMisses;
+}
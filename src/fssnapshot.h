@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef FSSNAPSHOT_H
+#define FSSNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "construct.h"
+
+/** @brief In memory snapshot of the directories that are searched for input and include files.
+ *
+ *  Instead of probing every candidate path with a system call, the contents of a directory
+ *  are read once, either when the directory is scanned for input files (see addListing())
+ *  or on the first query for a path inside it, and all further exists(), isFile() and
+ *  isDir() queries for that directory are answered from memory. The snapshot assumes the
+ *  input does not change while doxygen runs.
+ *
+ *  The snapshot also keeps the results of resolving include names to file paths, so
+ *  the same \c \#include found in many files is only resolved once.
+ *
+ *  All methods can be called from multiple threads.
+ */
+class FileSystemSnapshot
+{
+  public:
+    /** Type of a directory entry */
+    struct Entry
+    {
+      bool isFile = false;
+      bool isDir  = false;
+    };
+    /** Directory entries keyed by name */
+    using Listing = std::unordered_map<std::string,Entry>;
+
+    static FileSystemSnapshot &instance();
+
+    /** Stores the entries of directory \a dirName that were read by the caller. */
+    void addListing(const std::string &dirName,Listing &&entries);
+    /** Reads the entries of directory \a dirName unless this was done before. */
+    void addDirectory(const std::string &dirName);
+
+    bool exists(const std::string &path);
+    bool isFile(const std::string &path);
+    bool isDir(const std::string &path);
+    size_t size(const std::string &path);
+
+    /** Looks up the result of resolving include \a key. Returns TRUE and sets
+     *  \a path (which is empty if the include could not be found) if present.
+     */
+    bool findInclude(const std::string &key,std::string &path);
+    /** Stores \a path as the result of resolving include \a key. */
+    void insertInclude(const std::string &key,const std::string &path);
+
+    /** Removes all entries. */
+    void clear();
+
+    /** Returns the number of directories read so far. */
+    uint64_t directories() const;
+    /** Returns the number of queries answered from memory. */
+    uint64_t hits() const;
+    /** Returns the number of queries that needed a system call. */
+    uint64_t misses() const;
+    uint64_t includeHits() const;
+    uint64_t includeMisses() const;
+
+  private:
+    FileSystemSnapshot();
+   ~FileSystemSnapshot();
+    NON_COPYABLE(FileSystemSnapshot)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
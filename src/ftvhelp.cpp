@@ -39,6 +39,7 @@
 #include "portable.h"
 #include "outputlist.h"
 #include "threadpool.h"
+#include "namedmutex.h"
 
 static int folderId=1;
 
@@ -594,10 +595,42 @@ static void collectJSTreeFiles(const FTVNodes &nl,JSTreeFiles &files)
   }
 }
 
-static std::mutex g_navIndexMutex;
+static NamedMutex g_navIndexMutex("ftvhelp.cpp:g_navIndexMutex");
+
+/** Subtrees that are shown inline but have more nodes than this are moved to a
+ *  separate file, so they are only loaded when the node is expanded.
+ */
+static const int maxInlineTreeNodes = 100;
+
+/** Information about the navigation tree file that is being written */
+struct JSTreeFileContext
+{
+  JSTreeFileContext(const QCString &fi) : fileId(fi) {}
+  QCString fileId;
+  int numSubFiles = 0;
+};
+
+static bool exceedsNodeCount(const FTVNodes &nl,int &budget)
+{
+  for (const auto &n : nl)
+  {
+    if (--budget<0 || exceedsNodeCount(n->children,budget)) return TRUE;
+  }
+  return FALSE;
+}
+
+/** Returns TRUE if the tree \a nl has more than \a maxNodes nodes */
+static bool isLargeTree(const FTVNodes &nl,int maxNodes)
+{
+  return exceedsNodeCount(nl,maxNodes);
+}
+
+static void writeJSTreeFile(NavIndexEntryList &navIndex,const QCString &fileId,
+                            const FTVNodes &nl,JSTreeFileContext &ctx);
 
 static bool generateJSTree(NavIndexEntryList &navIndex,TextStream &t,
-                           const FTVNodes &nl,int level,bool &first)
+                           const FTVNodes &nl,int level,bool &first,
+                           JSTreeFileContext &ctx)
 {
   QCString htmlOutput = Config_getString(HTML_OUTPUT);
   QCString indentStr;
@@ -662,12 +695,20 @@ static bool generateJSTree(NavIndexEntryList &navIndex,TextStream &t,
         t << "null ]";
       }
     }
+    else if (isLargeTree(n->children,maxInlineTreeNodes)) // too big to show inline, use a separate file
+    {
+      QCString fileId = ctx.fileId+"_sub"+QCString().setNum(ctx.numSubFiles++);
+      t << indentStr << "  [ ";
+      generateJSLink(t,n);
+      t << "\"" << fileId << "\" ]";
+      writeJSTreeFile(navIndex,fileId,n->children,ctx);
+    }
     else // show items in this file
     {
       bool firstChild=TRUE;
       t << indentStr << "  [ ";
       generateJSLink(t,n);
-      bool emptySection = !generateJSTree(navIndex,t,n->children,level+1,firstChild);
+      bool emptySection = !generateJSTree(navIndex,t,n->children,level+1,firstChild,ctx);
       if (emptySection)
         t << "null ]";
       else
@@ -677,6 +718,21 @@ static bool generateJSTree(NavIndexEntryList &navIndex,TextStream &t,
   return found;
 }
 
+static void writeJSTreeFile(NavIndexEntryList &navIndex,const QCString &fileId,
+                            const FTVNodes &nl,JSTreeFileContext &ctx)
+{
+  QCString fileName = Config_getString(HTML_OUTPUT)+"/"+fileId+".js";
+  std::ofstream ff = Portable::openOutputStream(fileName);
+  if (ff.is_open())
+  {
+    bool firstChild = true;
+    TextStream tt(&ff);
+    tt << "var " << convertFileId2Var(fileId) << " =\n";
+    generateJSTree(navIndex,tt,nl,1,firstChild,ctx);
+    tt << "\n];";
+  }
+}
+
 static void generateJSTreeFiles(NavIndexEntryList &navIndex,TextStream &t,const FTVNodes &nodeList)
 {
   QCString htmlOutput = Config_getString(HTML_OUTPUT);
@@ -692,16 +748,8 @@ static void generateJSTreeFiles(NavIndexEntryList &navIndex,TextStream &t,const
   auto generateJSFile = [&](const JSTreeFile &tf)
   {
     QCString fileId = getVarName(tf.node);
-    QCString fileName = htmlOutput+"/"+fileId+".js";
-    std::ofstream ff = Portable::openOutputStream(fileName);
-    if (ff.is_open())
-    {
-      bool firstChild = true;
-      TextStream tt(&ff);
-      tt << "var " << convertFileId2Var(fileId) << " =\n";
-      generateJSTree(navIndex,tt,tf.node->children,1,firstChild);
-      tt << "\n];";
-    }
+    JSTreeFileContext ctx(fileId);
+    writeJSTreeFile(navIndex,fileId,tf.node->children,ctx);
   };
 
   JSTreeFiles jsTreeFiles;
@@ -710,11 +758,11 @@ static void generateJSTreeFiles(NavIndexEntryList &navIndex,TextStream &t,const
   std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
   if (numThreads>1) // multi threaded version
   {
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"navtree");
     std::vector< std::future<void> > results;
     for (const auto &tf : jsTreeFiles)
     {
-      results.emplace_back(threadPool.queue([&](){ generateJSFile(tf); }));
+      results.emplace_back(threadPool.queue(tf.fileId,[&](){ generateJSFile(tf); }));
     }
     // wait for the results
     for (auto &f : results) f.get();
@@ -728,6 +776,21 @@ static void generateJSTreeFiles(NavIndexEntryList &navIndex,TextStream &t,const
   }
 }
 
+/** Returns the index of the navigation index shard holding the entries for \a url.
+ *  The anchor part is ignored, so all entries of a page end up in the same shard.
+ *  Uses the 32-bit FNV-1a hash, which must match navTreeShard() in navtree.js.
+ */
+static size_t navIndexShard(const QCString &url,size_t numShards)
+{
+  uint32_t h = 2166136261u;
+  for (const char *p=url.data(); *p && *p!='#'; p++)
+  {
+    h ^= static_cast<uint8_t>(*p);
+    h *= 16777619u;
+  }
+  return h % numShards;
+}
+
 static void generateJSNavTree(const FTVNodes &nodeList)
 {
   QCString htmlOutput = Config_getString(HTML_OUTPUT);
@@ -768,7 +831,8 @@ static void generateJSNavTree(const FTVNodes &nodeList)
     navIndex.emplace_back("pages"+Doxygen::htmlFileExtension,"");
 
     bool first=TRUE;
-    generateJSTree(navIndex,t,nodeList,1,first);
+    JSTreeFileContext ctx("navtreedata");
+    generateJSTree(navIndex,t,nodeList,1,first,ctx);
     generateJSTreeFiles(navIndex,t,nodeList);
 
     if (first)
@@ -781,54 +845,55 @@ static void generateJSNavTree(const FTVNodes &nodeList)
     std::sort(navIndex.begin(),navIndex.end(),[](const auto &n1,const auto &n2)
         { return !n1.url.isEmpty() && (n2.url.isEmpty() || (n1.url<n2.url)); });
 
-    int subIndex=0;
-    int elemCount=0;
-    const int maxElemCount=250;
-    std::ofstream tsidx = Portable::openOutputStream(htmlOutput+"/navtreeindex0.js");
-    if (tsidx.is_open())
+    // distribute the entries over shards based on the page name, so the
+    // index for a page can be found without loading any other shard
+    const size_t maxElemCount=250;
+    size_t numShards = std::max<size_t>(1,(navIndex.size()+maxElemCount-1)/maxElemCount);
+    std::vector<NavIndexEntryList> shards(numShards);
+    for (const auto &e : navIndex)
     {
-      t << "var NAVTREEINDEX =\n";
-      t << "[\n";
-      tsidx << "var NAVTREEINDEX" << subIndex << " =\n";
-      tsidx << "{\n";
-      first=TRUE;
-      auto it = navIndex.begin();
-      while (it!=navIndex.end())
-      {
-        const NavIndexEntry &e = *it;
-        if (elemCount==0)
-        {
-          if (!first)
-          {
-            t << ",\n";
-          }
-          else
-          {
-            first=FALSE;
-          }
-          t << "\"" << e.url << "\"";
-        }
-        tsidx << "\"" << e.url << "\":[" << e.path << "]";
-        ++it;
-        if (it!=navIndex.end() && elemCount<maxElemCount-1) tsidx << ","; // not last entry
-        tsidx << "\n";
+      shards[navIndexShard(e.url,numShards)].push_back(e);
+    }
+    t << "var NAVTREEINDEXSHARDS = " << numShards << ";\n";
 
-        elemCount++;
-        if (it!=navIndex.end() && elemCount>=maxElemCount) // switch to new sub-index
+    auto writeShard = [&](size_t index)
+    {
+      QCString fileName = htmlOutput+"/navtreeindex"+QCString().setNum(index)+".js";
+      std::ofstream tsidx = Portable::openOutputStream(fileName);
+      if (tsidx.is_open())
+      {
+        TextStream ts(&tsidx);
+        ts << "var NAVTREEINDEX" << index << " =\n";
+        ts << "{\n";
+        bool firstEntry=TRUE;
+        for (const auto &e : shards[index])
         {
-          tsidx << "};\n";
-          elemCount=0;
-          tsidx.close();
-          subIndex++;
-          QCString fileName = htmlOutput+"/navtreeindex"+QCString().setNum(subIndex)+".js";
-          tsidx = Portable::openOutputStream(fileName);
-          if (!tsidx.is_open()) break;
-          tsidx << "var NAVTREEINDEX" << subIndex << " =\n";
-          tsidx << "{\n";
+          if (!firstEntry) ts << ",\n";
+          firstEntry=FALSE;
+          ts << "\"" << e.url << "\":[" << e.path << "]";
         }
+        ts << "\n};\n";
+      }
+    };
+
+    std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+    if (numThreads>1) // multi threaded version
+    {
+      ThreadPool threadPool(numThreads,"navtree");
+      std::vector< std::future<void> > results;
+      for (size_t i=0;i<numShards;i++)
+      {
+        results.emplace_back(threadPool.queue("navtreeindex"+QCString().setNum(i),[&writeShard,i](){ writeShard(i); }));
+      }
+      // wait for the results
+      for (auto &r : results) r.get();
+    }
+    else // single threaded version
+    {
+      for (size_t i=0;i<numShards;i++)
+      {
+        writeShard(i);
       }
-      tsidx << "};\n";
-      t << "\n];\n";
     }
     t << "\nvar SYNCONMSG = '"  << theTranslator->trPanelSynchronisationTooltip(FALSE) << "';";
     t << "\nvar SYNCOFFMSG = '" << theTranslator->trPanelSynchronisationTooltip(TRUE)  << "';";
@@ -13,10 +13,12 @@
  *
  */
 
-#include <vector>
+#include <array>
+#include <iterator>
 
 #include "htmlentity.h"
 #include "message.h"
+#include "staticmap.h"
 #include "textstream.h"
 
 //! @brief Structure defining all HTML4 entities, doxygen extensions and doxygen commands representing special symbols.
@@ -37,7 +39,7 @@ struct HtmlEntityInfo
   HtmlEntityMapper::PerlSymb perl;
 };
 
-static const std::vector<HtmlEntityInfo> g_htmlEntities
+static constexpr HtmlEntityInfo g_htmlEntities[] =
 {
 #undef SYM
 // helper macro to force consistent entries for the symbol and item columns
@@ -323,13 +325,25 @@ static const std::vector<HtmlEntityInfo> g_htmlEntities
 //! Number of doxygen commands mapped as if it were HTML entities
 static const int g_numberHtmlMappedCmds = 16;
 
+static constexpr size_t g_numHtmlEntities = std::size(g_htmlEntities);
 
-HtmlEntityMapper::HtmlEntityMapper()
+//! Returns the table used to look up an entity by its name, built at compile time
+static constexpr std::array<StaticMapEntry<HtmlEntityMapper::SymType>,g_numHtmlEntities> makeHtmlEntityNames()
 {
-  for (const auto &entity : g_htmlEntities)
+  std::array<StaticMapEntry<HtmlEntityMapper::SymType>,g_numHtmlEntities> result {};
+  for (size_t i=0;i<g_numHtmlEntities;i++)
   {
-    m_name2sym.insert(std::make_pair(entity.item,entity.symb));
+    result[i] = { g_htmlEntities[i].item, g_htmlEntities[i].symb };
   }
+  return result;
+}
+
+static constexpr auto g_htmlEntityNames = makeHtmlEntityNames();
+static constexpr auto g_htmlEntityMap   = makeStaticMap(g_htmlEntityNames);
+
+
+HtmlEntityMapper::HtmlEntityMapper()
+{
   validate();
 }
 
@@ -459,13 +473,12 @@ const HtmlEntityMapper::PerlSymb *HtmlEntityMapper::perl(HtmlEntityMapper::SymTy
  */
 HtmlEntityMapper::SymType HtmlEntityMapper::name2sym(const QCString &symName) const
 {
-  auto it = m_name2sym.find(symName.str());
-  return it!=m_name2sym.end() ? it->second : HtmlEntityMapper::Sym_Unknown;
+  return g_htmlEntityMap.value(symName.view(),HtmlEntityMapper::Sym_Unknown);
 }
 
 void HtmlEntityMapper::writeXMLSchema(TextStream &t)
 {
-  for (size_t i=0;i<g_htmlEntities.size() - g_numberHtmlMappedCmds;i++)
+  for (size_t i=0;i<g_numHtmlEntities - g_numberHtmlMappedCmds;i++)
   {
     QCString bareName = g_htmlEntities[i].xml;
     if (!bareName.isEmpty() && bareName.at(0)=='<' && bareName.endsWith("/>"))
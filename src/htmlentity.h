@@ -15,7 +15,6 @@
 #ifndef HTMLENTITY_H
 #define HTMLENTITY_H
 
-#include <unordered_map>
 #include <string>
 
 #include "qcstring.h"
@@ -114,7 +113,6 @@ class HtmlEntityMapper
    ~HtmlEntityMapper();
     NON_COPYABLE(HtmlEntityMapper)
     static HtmlEntityMapper *s_instance;
-    std::unordered_map<std::string,SymType> m_name2sym;
 };
 
 #endif
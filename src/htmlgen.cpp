@@ -56,6 +56,7 @@
 #include "datetime.h"
 #include "portable.h"
 #include "outputlist.h"
+#include "namedmutex.h"
 
 //#define DBG_HTML(x) x;
 #define DBG_HTML(x)
@@ -1429,7 +1430,7 @@ void HtmlGenerator::writeFooterFile(TextStream &t)
   t << ResourceMgr::instance().getAsString("footer.html");
 }
 
-static std::mutex g_indexLock;
+static NamedMutex g_indexLock("htmlgen.cpp:g_indexLock");
 
 void HtmlGenerator::startFile(const QCString &name,const QCString &,
                               const QCString &title,int /*id*/, int /*hierarchyLevel*/)
@@ -1444,7 +1445,7 @@ void HtmlGenerator::startFile(const QCString &name,const QCString &,
   m_codeGen->setFileName(fileName);
   m_codeGen->setRelativePath(m_relPath);
   {
-    std::lock_guard<std::mutex> lock(g_indexLock);
+    std::lock_guard<NamedMutex> lock(g_indexLock);
     Doxygen::indexList->addIndexFile(fileName);
   }
 
@@ -19,6 +19,9 @@
 
 #include <cstdlib>
 #include <array>
+#include <functional>
+#include <future>
+#include <numeric>
 
 #include <assert.h>
 
@@ -51,6 +54,7 @@
 #include "portable.h"
 #include "moduledef.h"
 #include "sitemap.h"
+#include "threadpool.h"
 
 #define MAX_ITEMS_BEFORE_MULTIPAGE_INDEX 200
 #define MAX_ITEMS_BEFORE_QUICK_INDEX 30
@@ -2195,6 +2199,61 @@ static QCString letterToLabel(const QCString &startLetter)
 
 //----------------------------------------------------------------------------
 
+/** Returns the ranges [start,end) of the pages over which an index of \a count entries
+ *  is divided according to HTML_INDEX_PAGE_SIZE. Function \a sameEntry(i) should return
+ *  true if entry \a i belongs to the same item as entry \a i-1, so they are kept together.
+ */
+template<class SameEntry>
+static std::vector< std::pair<size_t,size_t> > splitIndexIntoPages(size_t count,SameEntry sameEntry)
+{
+  size_t pageSize = static_cast<size_t>(Config_getInt(HTML_INDEX_PAGE_SIZE));
+  std::vector< std::pair<size_t,size_t> > pages;
+  size_t start=0;
+  while (start<count)
+  {
+    size_t end = pageSize==0 ? count : std::min(count,start+pageSize);
+    while (end<count && sameEntry(end)) end++;
+    pages.emplace_back(start,end);
+    start=end;
+  }
+  if (pages.empty()) pages.emplace_back(0,0);
+  return pages;
+}
+
+/** Returns the file name (without extension) of page \a pageNr (counting from 0) of an
+ *  index whose first page is \a baseName.
+ */
+static QCString indexPageFileName(const QCString &baseName,size_t pageNr)
+{
+  if (pageNr==0) return baseName;
+  return baseName+"_p"+QCString().setNum(static_cast<int>(pageNr+1));
+}
+
+/** Writes the links to the other pages of an index that is divided over \a numPages pages */
+static void writeIndexPageNavigation(OutputList &ol,const QCString &baseName,size_t pageNr,size_t numPages)
+{
+  if (numPages<2) return;
+  QCString pageLinks = "<div class=\"qindex\">";
+  for (size_t i=0;i<numPages;i++)
+  {
+    QCString nr = QCString().setNum(static_cast<int>(i+1));
+    if (i>0) pageLinks += "&#160;|&#160;";
+    if (i==pageNr)
+    {
+      pageLinks += "<b>" + nr + "</b>";
+    }
+    else
+    {
+      pageLinks += "<a class=\"qindex\" href=\"" + indexPageFileName(baseName,i) +
+                   Doxygen::htmlFileExtension + "\">" + nr + "</a>";
+    }
+  }
+  pageLinks += "</div>\n";
+  ol.writeString(pageLinks);
+}
+
+//----------------------------------------------------------------------------
+
 /** Class representing a cell in the alphabetical class index. */
 class AlphaIndexTableCell
 {
@@ -2218,8 +2277,72 @@ class AlphaIndexTableCell
 
 using UsedIndexLetters = std::set<std::string>;
 
-// write an alphabetical index of all class with a header for each letter
-static void writeAlphabeticalClassList(OutputList &ol, ClassDef::CompoundType ct, int /* annotatedCount */)
+// write the classes in [begin,end) that start with \a letter as part of the alphabetical index
+static void writeAlphabeticalClassLetter(OutputList &ol,const std::string &letter,const QCString &parity,
+                                         std::vector<const ClassDef*>::const_iterator begin,
+                                         std::vector<const ClassDef*>::const_iterator end)
+{
+  ol.writeString("<dl class=\"classindex " + parity + "\">\n");
+
+  // write character heading
+  ol.writeString("<dt class=\"alphachar\">");
+  QCString s = letterToLabel(letter.c_str());
+  ol.writeString("<a id=\"letter_");
+  ol.writeString(s);
+  ol.writeString("\" name=\"letter_");
+  ol.writeString(s);
+  ol.writeString("\">");
+  ol.writeString(letter.c_str());
+  ol.writeString("</a>");
+  ol.writeString("</dt>\n");
+
+  // write class links
+  for (auto it = begin; it!=end; ++it)
+  {
+    const ClassDef *cd = *it;
+    ol.writeString("<dd>");
+    QCString namesp,cname;
+    extractNamespaceName(cd->name(),cname,namesp);
+    QCString nsDispName;
+    SrcLangExt lang = cd->getLanguage();
+    QCString sep = getLanguageSpecificSeparator(lang);
+    if (sep!="::")
+    {
+      nsDispName=substitute(namesp,"::",sep);
+      cname=substitute(cname,"::",sep);
+    }
+    else
+    {
+      nsDispName=namesp;
+    }
+
+    ol.writeObjectLink(cd->getReference(),
+        cd->getOutputFileBase(),cd->anchor(),cname);
+    if (!namesp.isEmpty())
+    {
+      ol.writeString(" (");
+      NamespaceDef *nd = getResolvedNamespace(namesp);
+      if (nd && nd->isLinkable())
+      {
+        ol.writeObjectLink(nd->getReference(),
+            nd->getOutputFileBase(),QCString(),nsDispName);
+      }
+      else
+      {
+        ol.docify(nsDispName);
+      }
+      ol.writeString(")");
+    }
+    ol.writeString("</dd>");
+  }
+
+  ol.writeString("</dl>\n");
+}
+
+// write an alphabetical index of all class with a header for each letter,
+// divided over one or more pages starting with file \a fileName
+static void writeAlphabeticalClassList(OutputList &ol, ClassDef::CompoundType ct,
+                                       const QCString &fileName, const QCString &title, HighlightedItem hli)
 {
   bool sliceOpt = Config_getBool(OPTIMIZE_OUTPUT_SLICE);
 
@@ -2246,21 +2369,6 @@ static void writeAlphabeticalClassList(OutputList &ol, ClassDef::CompoundType ct
     }
   }
 
-  // write quick link index (row of letters)
-  QCString alphaLinks = "<div class=\"qindex\">";
-  bool first=true;
-  for (const auto &letter : indexLettersUsed)
-  {
-    if (!first) alphaLinks += "&#160;|&#160;";
-    first=false;
-    QCString li = letterToLabel(letter.c_str());
-    alphaLinks += "<a class=\"qindex\" href=\"#letter_" +
-                  li + "\">" +
-                  QCString(letter) + "</a>";
-  }
-  alphaLinks += "</div>\n";
-  ol.writeString(alphaLinks);
-
   std::map<std::string, std::vector<const ClassDef*> > classesByLetter;
 
   // fill the columns with the class list (row elements in each column,
@@ -2307,70 +2415,72 @@ static void writeAlphabeticalClassList(OutputList &ol, ClassDef::CompoundType ct
               });
   }
 
-  // generate table
-  if (!classesByLetter.empty())
+  // divide the classes over the pages, and determine the page on which each letter starts
+  size_t classIndex=0;
+  std::map<std::string,size_t> letterPage;
+  auto pages = splitIndexIntoPages(
+      std::accumulate(classesByLetter.begin(),classesByLetter.end(),size_t(0),
+                      [](size_t n,const auto &cl) { return n+cl.second.size(); }),
+      [](size_t) { return false; });
+  for (const auto &cl : classesByLetter)
   {
-    ol.writeString("<div class=\"classindex\">\n");
-    int counter=0;
-    for (const auto &cl : classesByLetter)
-    {
-      QCString parity = (counter++%2)==0 ? "even" : "odd";
-      ol.writeString("<dl class=\"classindex " + parity + "\">\n");
+    size_t pageNr=0;
+    while (pageNr+1<pages.size() && classIndex>=pages[pageNr].second) pageNr++;
+    letterPage.emplace(cl.first,pageNr);
+    classIndex+=cl.second.size();
+  }
+
+  // write quick link index (row of letters)
+  QCString alphaLinks = "<div class=\"qindex\">";
+  bool first=true;
+  for (const auto &letter : indexLettersUsed)
+  {
+    if (!first) alphaLinks += "&#160;|&#160;";
+    first=false;
+    QCString li = letterToLabel(letter.c_str());
+    QCString page = pages.size()>1 ? indexPageFileName(fileName,letterPage[letter])+Doxygen::htmlFileExtension : QCString();
+    alphaLinks += "<a class=\"qindex\" href=\"" + page + "#letter_" +
+                  li + "\">" +
+                  QCString(letter) + "</a>";
+  }
+  alphaLinks += "</div>\n";
 
-      // write character heading
-      ol.writeString("<dt class=\"alphachar\">");
-      QCString s = letterToLabel(cl.first.c_str());
-      ol.writeString("<a id=\"letter_");
-      ol.writeString(s);
-      ol.writeString("\" name=\"letter_");
-      ol.writeString(s);
-      ol.writeString("\">");
-      ol.writeString(cl.first.c_str());
-      ol.writeString("</a>");
-      ol.writeString("</dt>\n");
+  for (size_t pageNr=0; pageNr<pages.size(); pageNr++)
+  {
+    const auto &[pageStart,pageEnd] = pages[pageNr];
+    startFile(ol,indexPageFileName(fileName,pageNr),QCString(),title,hli);
 
-      // write class links
-      for (const auto &cd : cl.second)
-      {
-        ol.writeString("<dd>");
-        QCString namesp,cname;
-        extractNamespaceName(cd->name(),cname,namesp);
-        QCString nsDispName;
-        SrcLangExt lang = cd->getLanguage();
-        QCString sep = getLanguageSpecificSeparator(lang);
-        if (sep!="::")
-        {
-          nsDispName=substitute(namesp,"::",sep);
-          cname=substitute(cname,"::",sep);
-        }
-        else
-        {
-          nsDispName=namesp;
-        }
+    startTitle(ol,QCString());
+    ol.parseText(title);
+    endTitle(ol,QCString(),QCString());
 
-        ol.writeObjectLink(cd->getReference(),
-            cd->getOutputFileBase(),cd->anchor(),cname);
-        if (!namesp.isEmpty())
+    ol.startContents();
+    ol.writeString(alphaLinks);
+    writeIndexPageNavigation(ol,fileName,pageNr,pages.size());
+
+    // generate table
+    if (!classesByLetter.empty())
+    {
+      ol.writeString("<div class=\"classindex\">\n");
+      int counter=0;
+      size_t offset=0; // index of the first class of the letter
+      for (const auto &[letter,list] : classesByLetter)
+      {
+        QCString parity = (counter++%2)==0 ? "even" : "odd";
+        size_t start = std::max(offset,pageStart)-offset;
+        size_t end   = std::min(offset+list.size(),pageEnd);
+        end = end>offset ? end-offset : 0;
+        if (start<end) // (part of) the letter is on this page
         {
-          ol.writeString(" (");
-          NamespaceDef *nd = getResolvedNamespace(namesp);
-          if (nd && nd->isLinkable())
-          {
-            ol.writeObjectLink(nd->getReference(),
-                nd->getOutputFileBase(),QCString(),nsDispName);
-          }
-          else
-          {
-            ol.docify(nsDispName);
-          }
-          ol.writeString(")");
+          writeAlphabeticalClassLetter(ol,letter,parity,
+              list.begin()+static_cast<ptrdiff_t>(start),list.begin()+static_cast<ptrdiff_t>(end));
         }
-        ol.writeString("</dd>");
+        offset+=list.size();
       }
-
-      ol.writeString("</dl>\n");
+      ol.writeString("</div>\n");
     }
-    ol.writeString("</div>\n");
+    writeIndexPageNavigation(ol,fileName,pageNr,pages.size());
+    endFile(ol); // contains ol.endContents()
   }
 }
 
@@ -2385,20 +2495,12 @@ static void writeAlphabeticalIndex(OutputList &ol)
   QCString title = lne ? lne->title() : theTranslator->trCompoundIndex();
   bool addToIndex = lne==nullptr || lne->visible();
 
-  startFile(ol,"classes",QCString(),title,HighlightedItem::Classes);
-
-  startTitle(ol,QCString());
-  ol.parseText(title);
-  endTitle(ol,QCString(),QCString());
-
   if (addToIndex)
   {
     Doxygen::indexList->addContentsItem(FALSE,title,QCString(),"classes",QCString(),FALSE,TRUE);
   }
 
-  ol.startContents();
-  writeAlphabeticalClassList(ol, ClassDef::Class, Index::instance().numAnnotatedClasses());
-  endFile(ol); // contains ol.endContents()
+  writeAlphabeticalClassList(ol, ClassDef::Class, "classes", title, HighlightedItem::Classes);
 
   ol.popGeneratorState();
 }
@@ -2414,20 +2516,12 @@ static void writeAlphabeticalInterfaceIndex(OutputList &ol)
   QCString title = lne ? lne->title() : theTranslator->trInterfaceIndex();
   bool addToIndex = lne==nullptr || lne->visible();
 
-  startFile(ol,"interfaces",QCString(),title,HighlightedItem::Interfaces);
-
-  startTitle(ol,QCString());
-  ol.parseText(title);
-  endTitle(ol,QCString(),QCString());
-
   if (addToIndex)
   {
     Doxygen::indexList->addContentsItem(FALSE,title,QCString(),"interfaces",QCString(),FALSE,TRUE);
   }
 
-  ol.startContents();
-  writeAlphabeticalClassList(ol, ClassDef::Interface, Index::instance().numAnnotatedInterfaces());
-  endFile(ol); // contains ol.endContents()
+  writeAlphabeticalClassList(ol, ClassDef::Interface, "interfaces", title, HighlightedItem::Interfaces);
 
   ol.popGeneratorState();
 }
@@ -2443,20 +2537,12 @@ static void writeAlphabeticalStructIndex(OutputList &ol)
   QCString title = lne ? lne->title() : theTranslator->trStructIndex();
   bool addToIndex = lne==nullptr || lne->visible();
 
-  startFile(ol,"structs",QCString(),title,HighlightedItem::Structs);
-
-  startTitle(ol,QCString());
-  ol.parseText(title);
-  endTitle(ol,QCString(),QCString());
-
   if (addToIndex)
   {
     Doxygen::indexList->addContentsItem(FALSE,title,QCString(),"structs",QCString(),FALSE,TRUE);
   }
 
-  ol.startContents();
-  writeAlphabeticalClassList(ol, ClassDef::Struct, Index::instance().numAnnotatedStructs());
-  endFile(ol); // contains ol.endContents()
+  writeAlphabeticalClassList(ol, ClassDef::Struct, "structs", title, HighlightedItem::Structs);
 
   ol.popGeneratorState();
 }
@@ -2472,20 +2558,12 @@ static void writeAlphabeticalExceptionIndex(OutputList &ol)
   QCString title = lne ? lne->title() : theTranslator->trExceptionIndex();
   bool addToIndex = lne==nullptr || lne->visible();
 
-  startFile(ol,"exceptions",QCString(),title,HighlightedItem::Exceptions);
-
-  startTitle(ol,QCString());
-  ol.parseText(title);
-  endTitle(ol,QCString(),QCString());
-
   if (addToIndex)
   {
     Doxygen::indexList->addContentsItem(FALSE,title,QCString(),"exceptions",QCString(),FALSE,TRUE);
   }
 
-  ol.startContents();
-  writeAlphabeticalClassList(ol, ClassDef::Exception, Index::instance().numAnnotatedExceptions());
-  endFile(ol); // contains ol.endContents()
+  writeAlphabeticalClassList(ol, ClassDef::Exception, "exceptions", title, HighlightedItem::Exceptions);
 
   ol.popGeneratorState();
 }
@@ -2703,7 +2781,8 @@ static void writeModuleLinkForMember(OutputList &ol,const MemberDef *md,const QC
 
 static void writeMemberList(OutputList &ol,bool useSections,const std::string &page,
                             const Index::MemberIndexMap &memberIndexMap,
-                            Definition::DefType type)
+                            Definition::DefType type,
+                            size_t itemStart=0,size_t itemEnd=SIZE_MAX)
 {
   int index = static_cast<int>(type);
   const int numIndices = 4;
@@ -2744,8 +2823,10 @@ static void writeMemberList(OutputList &ol,bool useSections,const std::string &p
       letter = kv.first;
     }
     if (mil==nullptr || mil->empty()) continue;
-    for (const auto &md : *mil)
+    size_t lastItem = std::min(itemEnd,mil->size());
+    for (size_t i=itemStart; i<lastItem; i++)
     {
+      const MemberDef *md = (*mil)[i];
       const char *sep = nullptr;
       bool isFunc=!md->isObjCMethod() &&
         (md->isFunction() || md->isSlot() || md->isSignal());
@@ -3042,6 +3123,177 @@ static void writeQuickMemberIndex(OutputList &ol,
 
 //----------------------------------------------------------------------------
 
+/** Returns the name under which \a md is listed in a member index of the given \a type */
+static QCString memberIndexName(const MemberDef *md,Definition::DefType type)
+{
+  QCString name = type==Definition::TypeModule ? md->qualifiedName() : md->name();
+  return name.mid(static_cast<size_t>(getPrefixIndex(name)));
+}
+
+/** Properties of a (filtered) member index that are shared by all of its pages */
+struct MemberIndexInfo
+{
+  /** Link to one of the other filters of the same member index */
+  struct Tab
+  {
+    QCString fileName;
+    QCString title;
+    bool     highlighted;
+  };
+  Index::MemberIndexMap letterMap;  // the members per starting letter
+  Definition::DefType type = Definition::TypeClass;
+  HighlightedItem hli = HighlightedItem::None;
+  QCString baseName;                // file name of the first page
+  QCString title;
+  QCString intro;                   // introduction text shown above the list
+  bool multiPage = false;           // one or more pages per starting letter
+  bool quickIndex = false;          // show a row with the starting letters
+  std::vector<Tab> tabs;
+};
+
+/** Helper class that writes the pages of the member indices.
+ *
+ *  The pages are independent of each other, so they are written in parallel when
+ *  NUM_PROC_THREADS allows it, each using its own copy of the output list.
+ *  Since Doxygen::indexList is not thread safe, it is updated while queuing the pages.
+ */
+class IndexPageWriter
+{
+  public:
+    using WriteFunc = std::function<void(OutputList &)>;
+    explicit IndexPageWriter(OutputList &ol) : m_ol(ol) {}
+    void queue(const QCString &fileName,WriteFunc &&func) { m_pages.emplace_back(fileName,std::move(func)); }
+    void writeAll();
+  private:
+    OutputList &m_ol;
+    std::vector< std::pair<QCString,WriteFunc> > m_pages;
+};
+
+void IndexPageWriter::writeAll()
+{
+  std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+  if (numThreads>1 && m_pages.size()>1)
+  {
+    ThreadPool threadPool(numThreads,"index");
+    std::vector< std::future<void> > results;
+    for (const auto &[fileName,page] : m_pages)
+    {
+      auto ol = std::make_shared<OutputList>(m_ol);
+      results.emplace_back(threadPool.queue(fileName,[ol,&page=page]() { page(*ol); }));
+    }
+    for (auto &f : results)
+    {
+      f.get();
+    }
+  }
+  else
+  {
+    for (const auto &page : m_pages)
+    {
+      page.second(m_ol);
+    }
+  }
+  m_pages.clear();
+}
+
+static void writeMemberIndexPage(OutputList &ol,const MemberIndexInfo &info,const std::string &letter,
+                                 const QCString &fileName,size_t pageNr,size_t numPages,
+                                 size_t itemStart,size_t itemEnd)
+{
+  bool disableIndex = Config_getBool(DISABLE_INDEX);
+
+  ol.pushGeneratorState();
+  ol.disableAllBut(OutputType::Html);
+
+  QCString pageFileName = indexPageFileName(fileName,pageNr);
+  ol.startFile(pageFileName+Doxygen::htmlFileExtension,QCString(),info.title);
+  ol.startQuickIndices();
+  if (!disableIndex)
+  {
+    ol.writeQuickLinks(info.hli,QCString());
+    if (!Config_getBool(HTML_DYNAMIC_MENUS))
+    {
+      // index items for the complete and the per category member lists
+      bool first=TRUE;
+      startQuickIndexList(ol);
+      for (const auto &tab : info.tabs)
+      {
+        startQuickIndexItem(ol,tab.fileName+Doxygen::htmlFileExtension,tab.highlighted,TRUE,first);
+        ol.writeString(fixSpaces(tab.title));
+        endQuickIndexItem(ol);
+      }
+      endQuickIndexList(ol);
+
+      // quick alphabetical index
+      if (info.quickIndex)
+      {
+        writeQuickMemberIndex(ol,info.letterMap,letter,info.baseName,info.multiPage);
+      }
+    }
+  }
+  ol.endQuickIndices();
+  ol.writeSplitBar(pageFileName);
+  ol.writeSearchInfo();
+
+  ol.startContents();
+
+  ol.startTextBlock();
+  ol.parseText(info.intro);
+  ol.endTextBlock();
+
+  writeIndexPageNavigation(ol,fileName,pageNr,numPages);
+  writeMemberList(ol,info.quickIndex,
+      info.multiPage ? letter : std::string(),
+      info.letterMap,info.type,itemStart,itemEnd);
+  writeIndexPageNavigation(ol,fileName,pageNr,numPages);
+  endFile(ol);
+
+  ol.popGeneratorState();
+}
+
+/** Queues the pages of a member index, and adds the per letter pages to the navigation index */
+static void queueMemberIndexPages(IndexPageWriter &writer,const std::shared_ptr<const MemberIndexInfo> &info,bool addToIndex)
+{
+  if (info->letterMap.empty()) return;
+  if (!info->multiPage) // all letters on a single page
+  {
+    std::string lastLetter = info->letterMap.rbegin()->first;
+    writer.queue(info->baseName,[info,lastLetter](OutputList &ol)
+                 { writeMemberIndexPage(ol,*info,lastLetter,info->baseName,0,1,0,SIZE_MAX); });
+    return;
+  }
+  bool first=TRUE;
+  for (const auto &[letter,list] : info->letterMap)
+  {
+    QCString cs(letter);
+    QCString fileName = info->baseName;
+    if (!first)
+    {
+      fileName+="_"+letterToLabel(cs);
+    }
+    if (addToIndex)
+    {
+      Doxygen::indexList->addContentsItem(FALSE,cs,QCString(),fileName,QCString(),FALSE,TRUE);
+    }
+    const Index::MemberIndexList &mil = list;
+    Definition::DefType type = info->type;
+    auto pages = splitIndexIntoPages(mil.size(),
+        [&mil,type](size_t i) { return memberIndexName(mil[i],type)==memberIndexName(mil[i-1],type); });
+    for (size_t pageNr=0; pageNr<pages.size(); pageNr++)
+    {
+      std::string pageLetter = letter;
+      size_t numPages  = pages.size();
+      size_t itemStart = pages[pageNr].first;
+      size_t itemEnd   = pages[pageNr].second;
+      writer.queue(fileName,[info,pageLetter,fileName,pageNr,numPages,itemStart,itemEnd](OutputList &ol)
+                   { writeMemberIndexPage(ol,*info,pageLetter,fileName,pageNr,numPages,itemStart,itemEnd); });
+    }
+    first=FALSE;
+  }
+}
+
+//----------------------------------------------------------------------------
+
 /** Helper class representing a class member in the navigation menu. */
 struct CmhlInfo
 {
@@ -3072,23 +3324,17 @@ static const CmhlInfo *getCmhlInfo(size_t hl)
   return &cmhlInfo[hl];
 }
 
-static void writeClassMemberIndexFiltered(OutputList &ol, ClassMemberHighlight::Enum hl)
+static void writeClassMemberIndexFiltered(IndexPageWriter &writer, ClassMemberHighlight::Enum hl)
 {
   const auto &index = Index::instance();
   if (index.numDocumentedClassMembers(hl)==0) return;
 
-  bool disableIndex     = Config_getBool(DISABLE_INDEX);
-
   bool multiPageIndex=FALSE;
   if (index.numDocumentedClassMembers(hl)>MAX_ITEMS_BEFORE_MULTIPAGE_INDEX)
   {
     multiPageIndex=TRUE;
   }
 
-  ol.pushGeneratorState();
-  ol.disableAllBut(OutputType::Html);
-
-  QCString extension=Doxygen::htmlFileExtension;
   LayoutNavEntry *lne = LayoutDocManager::instance().rootNavEntry()->find(LayoutNavEntry::ClassMembers);
   QCString title = lne ? lne->title() : theTranslator->trCompoundMembers();
   if (hl!=ClassMemberHighlight::All) title+=QCString(" - ")+getCmhlInfo(hl)->title;
@@ -3101,83 +3347,26 @@ static void writeClassMemberIndexFiltered(OutputList &ol, ClassMemberHighlight::
     if (multiPageIndex) Doxygen::indexList->incContentsDepth();
   }
 
-  bool first=TRUE;
-  for (const auto &[letter,list] : index.isClassIndexLetterUsed(hl))
+  auto info = std::make_shared<MemberIndexInfo>();
+  info->letterMap  = index.isClassIndexLetterUsed(hl);
+  info->type       = Definition::TypeClass;
+  info->hli        = HighlightedItem::Functions;
+  info->baseName   = getCmhlInfo(hl)->fname;
+  info->title      = title;
+  info->intro      = hl == ClassMemberHighlight::All && lne ? lne->intro() : theTranslator->trCompoundMembersDescriptionTotal(hl);
+  info->multiPage  = multiPageIndex;
+  info->quickIndex = index.numDocumentedClassMembers(hl)>maxItemsBeforeQuickIndex;
+  // index item for the complete member list, followed by the per category member lists
+  for (int i=0;i<ClassMemberHighlight::Total;i++)
   {
-    QCString fileName = getCmhlInfo(hl)->fname;
-    if (multiPageIndex)
-    {
-      QCString cs(letter);
-      if (!first)
-      {
-        fileName+="_"+letterToLabel(cs);
-      }
-      if (addToIndex)
-      {
-        Doxygen::indexList->addContentsItem(FALSE,cs,QCString(),fileName,QCString(),FALSE,TRUE);
-      }
-    }
-    bool quickIndex = index.numDocumentedClassMembers(hl)>maxItemsBeforeQuickIndex;
-
-    ol.startFile(fileName+extension,QCString(),title);
-    ol.startQuickIndices();
-    if (!disableIndex)
+    if (i==0 || index.numDocumentedClassMembers(static_cast<ClassMemberHighlight::Enum>(i))>0)
     {
-      ol.writeQuickLinks(HighlightedItem::Functions,QCString());
-      if (!Config_getBool(HTML_DYNAMIC_MENUS))
-      {
-        startQuickIndexList(ol);
-
-        // index item for global member list
-        startQuickIndexItem(ol,
-            getCmhlInfo(0)->fname+Doxygen::htmlFileExtension,hl==ClassMemberHighlight::All,TRUE,first);
-        ol.writeString(fixSpaces(getCmhlInfo(0)->title));
-        endQuickIndexItem(ol);
-
-        // index items per category member lists
-        for (int i=1;i<ClassMemberHighlight::Total;i++)
-        {
-          if (index.numDocumentedClassMembers(static_cast<ClassMemberHighlight::Enum>(i))>0)
-          {
-            startQuickIndexItem(ol,getCmhlInfo(i)->fname+Doxygen::htmlFileExtension,hl==i,TRUE,first);
-            ol.writeString(fixSpaces(getCmhlInfo(i)->title));
-            //printf("multiPageIndex=%d first=%d fileName=%s file=%s title=%s\n",
-            //    multiPageIndex,first,qPrint(fileName),getCmhlInfo(i)->fname,qPrint(getCmhlInfo(i)->title));
-            endQuickIndexItem(ol);
-          }
-        }
-
-        endQuickIndexList(ol);
-
-        // quick alphabetical index
-        if (quickIndex)
-        {
-          writeQuickMemberIndex(ol,index.isClassIndexLetterUsed(hl),letter,
-              getCmhlInfo(hl)->fname,multiPageIndex);
-        }
-      }
+      info->tabs.push_back({ getCmhlInfo(i)->fname, getCmhlInfo(i)->title, hl==i });
     }
-    ol.endQuickIndices();
-    ol.writeSplitBar(fileName);
-    ol.writeSearchInfo();
-
-    ol.startContents();
-
-    ol.startTextBlock();
-    ol.parseText(hl == ClassMemberHighlight::All && lne ? lne->intro() : theTranslator->trCompoundMembersDescriptionTotal(hl));
-    ol.endTextBlock();
-
-    writeMemberList(ol,quickIndex,
-        multiPageIndex ? letter : std::string(),
-        index.isClassIndexLetterUsed(hl),
-        Definition::TypeClass);
-    endFile(ol);
-    first=FALSE;
   }
+  queueMemberIndexPages(writer,info,addToIndex);
 
   if (multiPageIndex && addToIndex) Doxygen::indexList->decContentsDepth();
-
-  ol.popGeneratorState();
 }
 
 static void writeClassMemberIndex(OutputList &ol)
@@ -3191,15 +3380,17 @@ static void writeClassMemberIndex(OutputList &ol)
     Doxygen::indexList->addContentsItem(TRUE,lne ? lne->title() : theTranslator->trCompoundMembers(),QCString(),"functions",QCString());
     Doxygen::indexList->incContentsDepth();
   }
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::All);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Functions);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Variables);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Typedefs);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Enums);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::EnumValues);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Properties);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Events);
-  writeClassMemberIndexFiltered(ol,ClassMemberHighlight::Related);
+  IndexPageWriter writer(ol);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::All);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Functions);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Variables);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Typedefs);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Enums);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::EnumValues);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Properties);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Events);
+  writeClassMemberIndexFiltered(writer,ClassMemberHighlight::Related);
+  writer.writeAll();
   if (index.numDocumentedClassMembers(ClassMemberHighlight::All)>0 && addToIndex)
   {
     Doxygen::indexList->decContentsDepth();
@@ -3240,23 +3431,17 @@ static const FmhlInfo *getFmhlInfo(size_t hl)
   return &fmhlInfo[hl];
 }
 
-static void writeFileMemberIndexFiltered(OutputList &ol, FileMemberHighlight::Enum hl)
+static void writeFileMemberIndexFiltered(IndexPageWriter &writer, FileMemberHighlight::Enum hl)
 {
   const auto &index = Index::instance();
   if (index.numDocumentedFileMembers(hl)==0) return;
 
-  bool disableIndex     = Config_getBool(DISABLE_INDEX);
-
   bool multiPageIndex=FALSE;
-  if (Index::instance().numDocumentedFileMembers(hl)>MAX_ITEMS_BEFORE_MULTIPAGE_INDEX)
+  if (index.numDocumentedFileMembers(hl)>MAX_ITEMS_BEFORE_MULTIPAGE_INDEX)
   {
     multiPageIndex=TRUE;
   }
 
-  ol.pushGeneratorState();
-  ol.disableAllBut(OutputType::Html);
-
-  QCString extension=Doxygen::htmlFileExtension;
   LayoutNavEntry *lne = LayoutDocManager::instance().rootNavEntry()->find(LayoutNavEntry::FileGlobals);
   QCString title = lne ? lne->title() : theTranslator->trFileMembers();
   bool addToIndex = lne==nullptr || lne->visible();
@@ -3268,79 +3453,26 @@ static void writeFileMemberIndexFiltered(OutputList &ol, FileMemberHighlight::En
     if (multiPageIndex) Doxygen::indexList->incContentsDepth();
   }
 
-  bool first=TRUE;
-  for (const auto &[letter,list] : index.isFileIndexLetterUsed(hl))
+  auto info = std::make_shared<MemberIndexInfo>();
+  info->letterMap  = index.isFileIndexLetterUsed(hl);
+  info->type       = Definition::TypeFile;
+  info->hli        = HighlightedItem::Globals;
+  info->baseName   = getFmhlInfo(hl)->fname;
+  info->title      = title;
+  info->intro      = hl == FileMemberHighlight::All && lne ? lne->intro() : theTranslator->trFileMembersDescriptionTotal(hl);
+  info->multiPage  = multiPageIndex;
+  info->quickIndex = index.numDocumentedFileMembers(hl)>maxItemsBeforeQuickIndex;
+  // index item for the complete member list, followed by the per category member lists
+  for (int i=0;i<FileMemberHighlight::Total;i++)
   {
-    QCString fileName = getFmhlInfo(hl)->fname;
-    if (multiPageIndex)
+    if (i==0 || index.numDocumentedFileMembers(static_cast<FileMemberHighlight::Enum>(i))>0)
     {
-      QCString cs(letter);
-      if (!first)
-      {
-        fileName+="_"+letterToLabel(cs);
-      }
-      if (addToIndex)
-      {
-        Doxygen::indexList->addContentsItem(FALSE,cs,QCString(),fileName,QCString(),FALSE,TRUE);
-      }
-    }
-    bool quickIndex = index.numDocumentedFileMembers(hl)>maxItemsBeforeQuickIndex;
-
-    ol.startFile(fileName+extension,QCString(),title);
-    ol.startQuickIndices();
-    if (!disableIndex)
-    {
-      ol.writeQuickLinks(HighlightedItem::Globals,QCString());
-      if (!Config_getBool(HTML_DYNAMIC_MENUS))
-      {
-        startQuickIndexList(ol);
-
-        // index item for all file member lists
-        startQuickIndexItem(ol,
-            getFmhlInfo(0)->fname+Doxygen::htmlFileExtension,hl==FileMemberHighlight::All,TRUE,first);
-        ol.writeString(fixSpaces(getFmhlInfo(0)->title));
-        endQuickIndexItem(ol);
-
-        // index items for per category member lists
-        for (int i=1;i<FileMemberHighlight::Total;i++)
-        {
-          if (Index::instance().numDocumentedFileMembers(static_cast<FileMemberHighlight::Enum>(i))>0)
-          {
-            startQuickIndexItem(ol,
-                getFmhlInfo(i)->fname+Doxygen::htmlFileExtension,hl==i,TRUE,first);
-            ol.writeString(fixSpaces(getFmhlInfo(i)->title));
-            endQuickIndexItem(ol);
-          }
-        }
-
-        endQuickIndexList(ol);
-
-        if (quickIndex)
-        {
-          writeQuickMemberIndex(ol,index.isFileIndexLetterUsed(hl),letter,
-              getFmhlInfo(hl)->fname,multiPageIndex);
-        }
-      }
+      info->tabs.push_back({ getFmhlInfo(i)->fname, getFmhlInfo(i)->title, hl==i });
     }
-    ol.endQuickIndices();
-    ol.writeSplitBar(fileName);
-    ol.writeSearchInfo();
-
-    ol.startContents();
-
-    ol.startTextBlock();
-    ol.parseText(hl == FileMemberHighlight::All && lne ? lne->intro() : theTranslator->trFileMembersDescriptionTotal(hl));
-    ol.endTextBlock();
-
-    writeMemberList(ol,quickIndex,
-        multiPageIndex ? letter : std::string(),
-        index.isFileIndexLetterUsed(hl),
-        Definition::TypeFile);
-    endFile(ol);
-    first=FALSE;
   }
+  queueMemberIndexPages(writer,info,addToIndex);
+
   if (multiPageIndex && addToIndex) Doxygen::indexList->decContentsDepth();
-  ol.popGeneratorState();
 }
 
 static void writeFileMemberIndex(OutputList &ol)
@@ -3352,15 +3484,17 @@ static void writeFileMemberIndex(OutputList &ol)
     Doxygen::indexList->addContentsItem(true,lne ? lne->title() : theTranslator->trFileMembers(),QCString(),"globals",QCString());
     Doxygen::indexList->incContentsDepth();
   }
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::All);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Functions);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Variables);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Typedefs);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Sequences);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Dictionaries);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Enums);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::EnumValues);
-  writeFileMemberIndexFiltered(ol,FileMemberHighlight::Defines);
+  IndexPageWriter writer(ol);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::All);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Functions);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Variables);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Typedefs);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Sequences);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Dictionaries);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Enums);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::EnumValues);
+  writeFileMemberIndexFiltered(writer,FileMemberHighlight::Defines);
+  writer.writeAll();
   if (Index::instance().numDocumentedFileMembers(FileMemberHighlight::All)>0 && addToIndex)
   {
     Doxygen::indexList->decContentsDepth();
@@ -3402,25 +3536,17 @@ static const NmhlInfo *getNmhlInfo(size_t hl)
 
 //----------------------------------------------------------------------------
 
-static void writeNamespaceMemberIndexFiltered(OutputList &ol,
-                                        NamespaceMemberHighlight::Enum hl)
+static void writeNamespaceMemberIndexFiltered(IndexPageWriter &writer, NamespaceMemberHighlight::Enum hl)
 {
   const auto &index = Index::instance();
   if (index.numDocumentedNamespaceMembers(hl)==0) return;
 
-  bool disableIndex     = Config_getBool(DISABLE_INDEX);
-
-
   bool multiPageIndex=FALSE;
   if (index.numDocumentedNamespaceMembers(hl)>MAX_ITEMS_BEFORE_MULTIPAGE_INDEX)
   {
     multiPageIndex=TRUE;
   }
 
-  ol.pushGeneratorState();
-  ol.disableAllBut(OutputType::Html);
-
-  QCString extension=Doxygen::htmlFileExtension;
   LayoutNavEntry *lne = LayoutDocManager::instance().rootNavEntry()->find(LayoutNavEntry::NamespaceMembers);
   QCString title = lne ? lne->title() : theTranslator->trNamespaceMembers();
   bool addToIndex = lne==nullptr || lne->visible();
@@ -3432,79 +3558,26 @@ static void writeNamespaceMemberIndexFiltered(OutputList &ol,
     if (multiPageIndex) Doxygen::indexList->incContentsDepth();
   }
 
-  bool first=TRUE;
-  for (const auto &[letter,list] : index.isNamespaceIndexLetterUsed(hl))
+  auto info = std::make_shared<MemberIndexInfo>();
+  info->letterMap  = index.isNamespaceIndexLetterUsed(hl);
+  info->type       = Definition::TypeNamespace;
+  info->hli        = HighlightedItem::NamespaceMembers;
+  info->baseName   = getNmhlInfo(hl)->fname;
+  info->title      = title;
+  info->intro      = hl == NamespaceMemberHighlight::All && lne ? lne->intro() : theTranslator->trNamespaceMembersDescriptionTotal(hl);
+  info->multiPage  = multiPageIndex;
+  info->quickIndex = index.numDocumentedNamespaceMembers(hl)>maxItemsBeforeQuickIndex;
+  // index item for the complete member list, followed by the per category member lists
+  for (int i=0;i<NamespaceMemberHighlight::Total;i++)
   {
-    QCString fileName = getNmhlInfo(hl)->fname;
-    if (multiPageIndex)
-    {
-      QCString cs(letter);
-      if (!first)
-      {
-        fileName+="_"+letterToLabel(cs);
-      }
-      if (addToIndex)
-      {
-        Doxygen::indexList->addContentsItem(FALSE,cs,QCString(),fileName,QCString(),FALSE,TRUE);
-      }
-    }
-    bool quickIndex = index.numDocumentedNamespaceMembers(hl)>maxItemsBeforeQuickIndex;
-
-    ol.startFile(fileName+extension,QCString(),title);
-    ol.startQuickIndices();
-    if (!disableIndex)
+    if (i==0 || index.numDocumentedNamespaceMembers(static_cast<NamespaceMemberHighlight::Enum>(i))>0)
     {
-      ol.writeQuickLinks(HighlightedItem::NamespaceMembers,QCString());
-      if (!Config_getBool(HTML_DYNAMIC_MENUS))
-      {
-        startQuickIndexList(ol);
-
-        // index item for all namespace member lists
-        startQuickIndexItem(ol,
-            getNmhlInfo(0)->fname+Doxygen::htmlFileExtension,hl==NamespaceMemberHighlight::All,TRUE,first);
-        ol.writeString(fixSpaces(getNmhlInfo(0)->title));
-        endQuickIndexItem(ol);
-
-        // index items per category member lists
-        for (int i=1;i<NamespaceMemberHighlight::Total;i++)
-        {
-          if (index.numDocumentedNamespaceMembers(static_cast<NamespaceMemberHighlight::Enum>(i))>0)
-          {
-            startQuickIndexItem(ol,
-                getNmhlInfo(i)->fname+Doxygen::htmlFileExtension,hl==i,TRUE,first);
-            ol.writeString(fixSpaces(getNmhlInfo(i)->title));
-            endQuickIndexItem(ol);
-          }
-        }
-
-        endQuickIndexList(ol);
-
-        if (quickIndex)
-        {
-          writeQuickMemberIndex(ol,index.isNamespaceIndexLetterUsed(hl),letter,
-              getNmhlInfo(hl)->fname,multiPageIndex);
-        }
-      }
+      info->tabs.push_back({ getNmhlInfo(i)->fname, getNmhlInfo(i)->title, hl==i });
     }
-    ol.endQuickIndices();
-    ol.writeSplitBar(fileName);
-    ol.writeSearchInfo();
-
-    ol.startContents();
-
-    ol.startTextBlock();
-    ol.parseText(hl == NamespaceMemberHighlight::All && lne ? lne->intro() : theTranslator->trNamespaceMembersDescriptionTotal(hl));
-    ol.endTextBlock();
-
-    writeMemberList(ol,quickIndex,
-        multiPageIndex ? letter : std::string(),
-        index.isNamespaceIndexLetterUsed(hl),
-        Definition::TypeNamespace);
-    endFile(ol);
-    first=FALSE;
   }
+  queueMemberIndexPages(writer,info,addToIndex);
+
   if (multiPageIndex && addToIndex) Doxygen::indexList->decContentsDepth();
-  ol.popGeneratorState();
 }
 
 static void writeNamespaceMemberIndex(OutputList &ol)
@@ -3518,14 +3591,16 @@ static void writeNamespaceMemberIndex(OutputList &ol)
     Doxygen::indexList->incContentsDepth();
   }
   //bool fortranOpt = Config_getBool(OPTIMIZE_FOR_FORTRAN);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::All);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::Functions);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::Variables);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::Typedefs);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::Sequences);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::Dictionaries);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::Enums);
-  writeNamespaceMemberIndexFiltered(ol,NamespaceMemberHighlight::EnumValues);
+  IndexPageWriter writer(ol);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::All);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::Functions);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::Variables);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::Typedefs);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::Sequences);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::Dictionaries);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::Enums);
+  writeNamespaceMemberIndexFiltered(writer,NamespaceMemberHighlight::EnumValues);
+  writer.writeAll();
   if (index.numDocumentedNamespaceMembers(NamespaceMemberHighlight::All)>0 && addToIndex)
   {
     Doxygen::indexList->decContentsDepth();
@@ -3559,25 +3634,17 @@ static const MmhlInfo *getMmhlInfo(size_t hl)
 
 //----------------------------------------------------------------------------
 
-static void writeModuleMemberIndexFiltered(OutputList &ol,
-                                        ModuleMemberHighlight::Enum hl)
+static void writeModuleMemberIndexFiltered(IndexPageWriter &writer, ModuleMemberHighlight::Enum hl)
 {
   const auto &index = Index::instance();
   if (index.numDocumentedModuleMembers(hl)==0) return;
 
-  bool disableIndex     = Config_getBool(DISABLE_INDEX);
-
-
   bool multiPageIndex=FALSE;
   if (index.numDocumentedModuleMembers(hl)>MAX_ITEMS_BEFORE_MULTIPAGE_INDEX)
   {
     multiPageIndex=TRUE;
   }
 
-  ol.pushGeneratorState();
-  ol.disableAllBut(OutputType::Html);
-
-  QCString extension=Doxygen::htmlFileExtension;
   LayoutNavEntry *lne = LayoutDocManager::instance().rootNavEntry()->find(LayoutNavEntry::ModuleMembers);
   QCString title = lne ? lne->title() : theTranslator->trModulesMembers();
   bool addToIndex = lne==nullptr || lne->visible();
@@ -3589,79 +3656,26 @@ static void writeModuleMemberIndexFiltered(OutputList &ol,
     if (multiPageIndex) Doxygen::indexList->incContentsDepth();
   }
 
-  bool first=TRUE;
-  for (const auto &[letter,list] : index.isModuleIndexLetterUsed(hl))
+  auto info = std::make_shared<MemberIndexInfo>();
+  info->letterMap  = index.isModuleIndexLetterUsed(hl);
+  info->type       = Definition::TypeModule;
+  info->hli        = HighlightedItem::ModuleMembers;
+  info->baseName   = getMmhlInfo(hl)->fname;
+  info->title      = title;
+  info->intro      = hl == ModuleMemberHighlight::All && lne ? lne->intro() : theTranslator->trModuleMembersDescriptionTotal(hl);
+  info->multiPage  = multiPageIndex;
+  info->quickIndex = index.numDocumentedModuleMembers(hl)>maxItemsBeforeQuickIndex;
+  // index item for the complete member list, followed by the per category member lists
+  for (int i=0;i<ModuleMemberHighlight::Total;i++)
   {
-    QCString fileName = getMmhlInfo(hl)->fname;
-    if (multiPageIndex)
+    if (i==0 || index.numDocumentedModuleMembers(static_cast<ModuleMemberHighlight::Enum>(i))>0)
     {
-      QCString cs(letter);
-      if (!first)
-      {
-        fileName+="_"+letterToLabel(cs);
-      }
-      if (addToIndex)
-      {
-        Doxygen::indexList->addContentsItem(FALSE,cs,QCString(),fileName,QCString(),FALSE,TRUE);
-      }
+      info->tabs.push_back({ getMmhlInfo(i)->fname, getMmhlInfo(i)->title, hl==i });
     }
-    bool quickIndex = index.numDocumentedModuleMembers(hl)>maxItemsBeforeQuickIndex;
-
-    ol.startFile(fileName+extension,QCString(),title);
-    ol.startQuickIndices();
-    if (!disableIndex)
-    {
-      ol.writeQuickLinks(HighlightedItem::ModuleMembers,QCString());
-      if (!Config_getBool(HTML_DYNAMIC_MENUS))
-      {
-        startQuickIndexList(ol);
-
-        // index item for all namespace member lists
-        startQuickIndexItem(ol,
-            getMmhlInfo(0)->fname+Doxygen::htmlFileExtension,hl==ModuleMemberHighlight::All,TRUE,first);
-        ol.writeString(fixSpaces(getMmhlInfo(0)->title));
-        endQuickIndexItem(ol);
-
-        // index items per category member lists
-        for (int i=1;i<ModuleMemberHighlight::Total;i++)
-        {
-          if (index.numDocumentedModuleMembers(static_cast<ModuleMemberHighlight::Enum>(i))>0)
-          {
-            startQuickIndexItem(ol,
-                getMmhlInfo(i)->fname+Doxygen::htmlFileExtension,hl==i,TRUE,first);
-            ol.writeString(fixSpaces(getMmhlInfo(i)->title));
-            endQuickIndexItem(ol);
-          }
-        }
-
-        endQuickIndexList(ol);
-
-        if (quickIndex)
-        {
-          writeQuickMemberIndex(ol,index.isModuleIndexLetterUsed(hl),letter,
-              getMmhlInfo(hl)->fname,multiPageIndex);
-        }
-      }
-    }
-    ol.endQuickIndices();
-    ol.writeSplitBar(fileName);
-    ol.writeSearchInfo();
-
-    ol.startContents();
-
-    ol.startTextBlock();
-    ol.parseText(hl == ModuleMemberHighlight::All && lne ? lne->intro() : theTranslator->trModuleMembersDescriptionTotal(hl));
-    ol.endTextBlock();
-
-    writeMemberList(ol,quickIndex,
-        multiPageIndex ? letter : std::string(),
-        index.isModuleIndexLetterUsed(hl),
-        Definition::TypeModule);
-    endFile(ol);
-    first=FALSE;
   }
+  queueMemberIndexPages(writer,info,addToIndex);
+
   if (multiPageIndex && addToIndex) Doxygen::indexList->decContentsDepth();
-  ol.popGeneratorState();
 }
 
 
@@ -3678,12 +3692,14 @@ static void writeModuleMemberIndex(OutputList &ol)
     Doxygen::indexList->incContentsDepth();
   }
   //bool fortranOpt = Config_getBool(OPTIMIZE_FOR_FORTRAN);
-  writeModuleMemberIndexFiltered(ol,ModuleMemberHighlight::All);
-  writeModuleMemberIndexFiltered(ol,ModuleMemberHighlight::Functions);
-  writeModuleMemberIndexFiltered(ol,ModuleMemberHighlight::Variables);
-  writeModuleMemberIndexFiltered(ol,ModuleMemberHighlight::Typedefs);
-  writeModuleMemberIndexFiltered(ol,ModuleMemberHighlight::Enums);
-  writeModuleMemberIndexFiltered(ol,ModuleMemberHighlight::EnumValues);
+  IndexPageWriter writer(ol);
+  writeModuleMemberIndexFiltered(writer,ModuleMemberHighlight::All);
+  writeModuleMemberIndexFiltered(writer,ModuleMemberHighlight::Functions);
+  writeModuleMemberIndexFiltered(writer,ModuleMemberHighlight::Variables);
+  writeModuleMemberIndexFiltered(writer,ModuleMemberHighlight::Typedefs);
+  writeModuleMemberIndexFiltered(writer,ModuleMemberHighlight::Enums);
+  writeModuleMemberIndexFiltered(writer,ModuleMemberHighlight::EnumValues);
+  writer.writeAll();
   if (index.numDocumentedModuleMembers(ModuleMemberHighlight::All)>0 && addToIndex)
   {
     Doxygen::indexList->decContentsDepth();
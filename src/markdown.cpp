@@ -53,7 +53,10 @@
 #include "trace.h"
 #include "anchor.h"
 
-#if !ENABLE_MARKDOWN_TRACING
+#if ENABLE_MARKDOWN_TRACING
+#undef  TRACE_SUBSYSTEM
+#define TRACE_SUBSYSTEM Trace::Markdown
+#else
 #undef  AUTO_TRACE
 #undef  AUTO_TRACE_ADD
 #undef  AUTO_TRACE_EXIT
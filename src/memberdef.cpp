@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <atomic>
 #include <mutex>
 
 #include "md5.h"
@@ -47,6 +48,7 @@
 #include "definitionimpl.h"
 #include "regex.h"
 #include "trace.h"
+#include "namedmutex.h"
 
 //-----------------------------------------------------------------------------
 
@@ -382,6 +384,50 @@ class MemberDefImpl : public DefinitionMixin<MemberDefMutable>
               const ArgumentList &al,const QCString &meta
              );
 
+    /** Attributes that only few members have. They are kept in a separate structure that
+     *  is only allocated when one of them is set, which keeps the common members small.
+     */
+    struct RareData : public MemoryCounted<MemoryCategory::MemberDefs,RareData>
+    {
+      QCString bitfields;               // struct member bitfields
+      QCString read;                    // property read accessor
+      QCString write;                   // property write accessor
+      QCString exception;               // exceptions that can be thrown
+      QCString enumBaseType;            // base type of the enum (C++11)
+      QCString requiresClause;          // requires clause (C++20)
+      QCString metaData;                // Slice metadata.
+      QCString accessorType;            // return type that tell how to get to this member
+      ClassDef *accessorClass = nullptr; // class that this member accesses (for anonymous types)
+      ClassDef *relatedAlso = nullptr;  // points to class marked by relatedAlso
+      ExampleList examples;             // a dictionary of all examples for quick access
+      ArgumentList typeConstraints;     // type constraints for template parameters
+      std::optional<ArgumentList> formalTemplateArguments;
+      ArgumentLists defTmpArgLists;     // lists of template argument lists
+                                        // (for template functions in nested template classes)
+      const GroupDef *group = nullptr;  // group in which this member is in
+      Grouping::GroupPri_t grouppri = Grouping::GROUPING_AUTO_DEF; // priority of this definition
+      QCString groupFileName;           // file where this grouping was defined
+      int groupStartLine = 0;           // line  "      "      "     "     "
+      bool groupHasDocs = false;        // true if the entry that caused the grouping was documented
+      MemberDef *groupMember = nullptr;
+      QCString explicitOutputFileBase;  // to store the output file base from tag files
+      StringVector qualifiers;          // to store extra qualifiers
+      ClassDef *category = nullptr;     // objective-c
+      const MemberDef *categoryRelation = nullptr;
+    };
+    /** Returns the rare attributes, or a default constructed set if none were set */
+    const RareData &rare() const
+    {
+      static const RareData noRareData;
+      const RareData *rd = m_rare.get();
+      return rd ? *rd : noRareData;
+    }
+    /** Returns the rare attributes for modification, allocating them if needed */
+    RareData &writableRare()
+    {
+      return m_rare.getOrCreate();
+    }
+
     uint8_t m_isLinkableCached;    // 0 = not cached, 1=FALSE, 2=TRUE
     uint8_t m_isConstructorCached; // 0 = not cached, 1=FALSE, 2=TRUE
     uint8_t m_isDestructorCached;  // 1 = not cached, 1=FALSE, 2=TRUE
@@ -392,7 +438,6 @@ class MemberDefImpl : public DefinitionMixin<MemberDefMutable>
     ModuleDef    *m_moduleDef = nullptr;
 
     const MemberDef  *m_enumScope = nullptr;    // the enclosing scope, if this is an enum field
-    bool        m_livesInsideEnum = false;
     const MemberDef  *m_annEnumType = nullptr;  // the anonymous enum that is the type of this member
     MemberVector m_enumFields;              // enumeration fields
 
@@ -401,13 +446,8 @@ class MemberDefImpl : public DefinitionMixin<MemberDefMutable>
 
     MemberDef  *m_memDef = nullptr;       // member definition for this declaration
     MemberDef  *m_memDec = nullptr;       // member declaration for this definition
-    ClassDef   *m_relatedAlso = nullptr;  // points to class marked by relatedAlso
-
-    ExampleList m_examples;     // a dictionary of all examples for quick access
 
     QCString m_type;            // return actual type
-    QCString m_accessorType;    // return type that tell how to get to this member
-    ClassDef *m_accessorClass = nullptr;  // class that this member accesses (for anonymous types)
     QCString m_args;            // function arguments/variable array specifiers
     QCString m_def;             // member definition in code (fully qualified name)
     QCString m_anc;             // HTML anchor name
@@ -415,14 +455,8 @@ class MemberDefImpl : public DefinitionMixin<MemberDefMutable>
     Protection m_prot = Protection::Public; // protection type [Public/Protected/Private]
     QCString m_decl;            // member declaration in class
 
-    QCString m_bitfields;       // struct member bitfields
-    QCString m_read;            // property read accessor
-    QCString m_write;           // property write accessor
-    QCString m_exception;       // exceptions that can be thrown
     QCString m_initializer;     // initializer
     QCString m_extraTypeChars;  // extra type info found after the argument list
-    QCString m_enumBaseType;    // base type of the enum (C++11)
-    QCString m_requiresClause;  // requires clause (C++20)
     int m_initLines = 0;            // number of lines in the initializer
 
     TypeSpecifier m_memSpec;          // The specifiers present for this member
@@ -436,13 +470,7 @@ class MemberDefImpl : public DefinitionMixin<MemberDefMutable>
     ArgumentList m_declArgList;   // argument list of this member declaration
 
     ArgumentList m_tArgList;      // template argument list of function template
-    ArgumentList m_typeConstraints; // type constraints for template parameters
     MemberDef *m_templateMaster = nullptr;
-    std::optional<ArgumentList> m_formalTemplateArguments;
-    ArgumentLists m_defTmpArgLists; // lists of template argument lists
-                                         // (for template functions in nested template classes)
-
-    QCString m_metaData;        // Slice metadata.
 
     mutable ClassDef *m_cachedAnonymousType = nullptr; // if the member has an anonymous compound
                                    // as its type then this is computed by
@@ -453,58 +481,52 @@ class MemberDefImpl : public DefinitionMixin<MemberDefMutable>
     const MemberDef *m_groupAlias = nullptr;    // Member containing the definition
     int m_grpId = 0;                // group id
     MemberGroup *m_memberGroup = nullptr; // group's member definition
-    const GroupDef *m_group = nullptr;          // group in which this member is in
-    Grouping::GroupPri_t m_grouppri = Grouping::GROUPING_AUTO_DEF; // priority of this definition
-    QCString m_groupFileName;   // file where this grouping was defined
-    int m_groupStartLine = 0;       // line  "      "      "     "     "
-    MemberDef *m_groupMember = nullptr;
 
+    // set by cacheTypedefVal(), guarded by the typedef cache mutex of the symbol resolver
     bool m_isTypedefValCached = false;
     const ClassDef *m_cachedTypedefValue = nullptr;
     QCString m_cachedTypedefTemplSpec;
     QCString m_cachedResolvedType;
 
+    // Flags that are updated while the documentation is written, possibly by several
+    // threads at once. They are kept out of the bitfield below, since writing a bit
+    // also writes its neighbours.
+    mutable std::atomic<bool> m_hasDocumentedParams { false };      // guard to show only the first warning
+    mutable std::atomic<bool> m_hasDocumentedReturnType { false };  // guard to show only the first warning
+    mutable bool m_hasDetailedDescriptionCached = false;   // guarded by g_hasDetailedDescriptionMutex
+    mutable bool m_detailedDescriptionCachedValue = false; // guarded by g_hasDetailedDescriptionMutex
+
     // documentation inheritance
     const MemberDef *m_docProvider = nullptr;
 
-    // to store the output file base from tag files
-    QCString m_explicitOutputFileBase;
-
-    // to store extra qualifiers
-    StringVector m_qualifiers;
+    RareDataPtr<RareData> m_rare;
 
-    // objective-c
-    bool m_implOnly = false; // function found in implementation but not
-                           // in the interface
-    mutable bool m_hasDocumentedParams = false;      // guard to show only the first warning
-    mutable bool m_hasDocumentedReturnType = false;  // guard to show only the first warning
-    bool m_isDMember = false;
-    Relationship m_related = Relationship::Member;    // relationship of this to the class
-    bool m_stat = false;                // is it a static function?
-    bool m_proto = false;               // is it a prototype?
-    bool m_docEnumValues = false;       // is an enum with documented enum values.
-
-    mutable bool m_annScope = false;    // member is part of an anonymous scope
-    mutable bool m_hasDetailedDescriptionCached = false;
-    mutable bool m_detailedDescriptionCachedValue = false;
-                                      // const member.
-    bool m_hasCallGraph = false;
-    bool m_hasCallerGraph = false;
-    bool m_hasReferencedByRelation = false;
-    bool m_hasReferencesRelation = false;
-    bool m_hasInlineSource = false;
-    bool m_explExt = false;             // member was explicitly declared external
-    bool m_tspec = false;               // member is a template specialization
-    bool m_groupHasDocs = false;        // true if the entry that caused the grouping was documented
-    bool m_docsForDefinition = false;   // TRUE => documentation block is put before
-                                      //         definition.
-                                      // FALSE => block is put before declaration.
-    ClassDef *m_category = nullptr;
-    const MemberDef *m_categoryRelation = nullptr;
     QCString m_declFileName;
     int m_declLine = -1;
     int m_declColumn = -1;
     int m_numberOfFlowKW = 0;
+    Relationship m_related = Relationship::Member;    // relationship of this to the class
+
+    // flags, all initialized by init()
+    bool m_livesInsideEnum : 1;
+    // objective-c
+    bool m_implOnly : 1;                // function found in implementation but not
+                                        // in the interface
+    bool m_isDMember : 1;
+    bool m_stat : 1;                    // is it a static function?
+    bool m_proto : 1;                   // is it a prototype?
+    bool m_docEnumValues : 1;           // is an enum with documented enum values.
+    mutable bool m_annScope : 1;        // member is part of an anonymous scope
+    bool m_hasCallGraph : 1;
+    bool m_hasCallerGraph : 1;
+    bool m_hasReferencedByRelation : 1;
+    bool m_hasReferencesRelation : 1;
+    bool m_hasInlineSource : 1;
+    bool m_explExt : 1;                 // member was explicitly declared external
+    bool m_tspec : 1;                   // member is a template specialization
+    bool m_docsForDefinition : 1;       // TRUE => documentation block is put before
+                                        //         definition.
+                                        // FALSE => block is put before declaration.
 };
 
 std::unique_ptr<MemberDef> createMemberDef(const QCString &defFileName,int defLine,int defColumn,
@@ -1316,12 +1338,9 @@ void MemberDefImpl::init(Definition *d,
   m_fileDef=nullptr;
   m_moduleDef=nullptr;
   m_redefines=nullptr;
-  m_relatedAlso=nullptr;
-  m_accessorClass=nullptr;
   m_nspace=nullptr;
   m_memDef=nullptr;
   m_memDec=nullptr;
-  m_group=nullptr;
   m_grpId=-1;
   m_enumScope=nullptr;
   m_livesInsideEnum=FALSE;
@@ -1347,7 +1366,7 @@ void MemberDefImpl::init(Definition *d,
   m_related=r;
   m_stat=s;
   m_mtype=mt;
-  m_exception=e;
+  if (!e.isEmpty()) writableRare().exception=e;
   m_proto=FALSE;
   m_annScope=FALSE;
   m_memSpec=TypeSpecifier();
@@ -1373,17 +1392,18 @@ void MemberDefImpl::init(Definition *d,
     //printf("setDeclArgList %s to %s const=%d\n",qPrint(args),
     //    qPrint(argListToString(declArgList)),declArgList->constSpecifier);
   }
-  m_metaData = meta;
+  if (!meta.isEmpty()) writableRare().metaData = meta;
   m_templateMaster = nullptr;
   m_docsForDefinition = TRUE;
   m_isTypedefValCached = FALSE;
   m_cachedTypedefValue = nullptr;
   m_implOnly=FALSE;
-  m_groupMember = nullptr;
   m_hasDocumentedParams = FALSE;
   m_hasDocumentedReturnType = FALSE;
   m_docProvider = nullptr;
   m_isDMember = d->getDefFileName().lower().endsWith(".d");
+  m_hasDetailedDescriptionCached = FALSE;
+  m_detailedDescriptionCachedValue = FALSE;
 }
 
 
@@ -1430,10 +1450,9 @@ MemberDefImpl::MemberDefImpl(const QCString &df,int dl,int dc,
 std::unique_ptr<MemberDef> MemberDefImpl::deepCopy() const
 {
   std::unique_ptr<MemberDefImpl> result(new MemberDefImpl(
-        getDefFileName(),getDefLine(),getDefColumn(),m_type,localName(),m_args,m_exception,
-        m_prot,m_virt,m_stat,m_related,m_mtype,m_tArgList,m_defArgList,m_metaData));
+        getDefFileName(),getDefLine(),getDefColumn(),m_type,localName(),m_args,rare().exception,
+        m_prot,m_virt,m_stat,m_related,m_mtype,m_tArgList,m_defArgList,rare().metaData));
   // first copy everything by reference
-  result->m_typeConstraints                = m_typeConstraints                ;
   result->m_declArgList                    = m_declArgList                    ;
   result->m_classDef                       = m_classDef                       ;
   result->m_fileDef                        = m_fileDef                        ;
@@ -1441,27 +1460,18 @@ std::unique_ptr<MemberDef> MemberDefImpl::deepCopy() const
   result->m_nspace                         = m_nspace                         ;
   result->m_enumScope                      = m_enumScope                      ;
   result->m_livesInsideEnum                = m_livesInsideEnum                ;
+  result->m_rare = m_rare;
   result->m_annEnumType                    = m_annEnumType                    ;
   result->m_enumFields                     = m_enumFields                     ;
   result->m_redefines                      = m_redefines                      ;
   result->m_redefinedBy                    = m_redefinedBy                    ;
   result->m_memDef                         = m_memDef                         ;
   result->m_memDec                         = m_memDec                         ;
-  result->m_relatedAlso                    = m_relatedAlso                    ;
-  result->m_examples                       = m_examples                       ;
-  result->m_accessorType                   = m_accessorType                   ;
-  result->m_accessorClass                  = m_accessorClass                  ;
   result->m_def                            = m_def                            ;
   result->m_anc                            = m_anc                            ;
   result->m_decl                           = m_decl                           ;
-  result->m_bitfields                      = m_bitfields                      ;
-  result->m_read                           = m_read                           ;
-  result->m_write                          = m_write                          ;
-  result->m_exception                      = m_exception                      ;
   result->m_initializer                    = m_initializer                    ;
   result->m_extraTypeChars                 = m_extraTypeChars                 ;
-  result->m_enumBaseType                   = m_enumBaseType                   ;
-  result->m_requiresClause                 = m_requiresClause                 ;
   result->m_initLines                      = m_initLines                      ;
   result->m_memSpec                        = m_memSpec                        ;
   result->m_vhdlSpec                       = m_vhdlSpec                       ;
@@ -1471,30 +1481,20 @@ std::unique_ptr<MemberDef> MemberDefImpl::deepCopy() const
   result->m_defArgList                     = m_defArgList                     ;
   result->m_declArgList                    = m_declArgList                    ;
   result->m_tArgList                       = m_tArgList                       ;
-  result->m_typeConstraints                = m_typeConstraints                ;
   result->m_templateMaster                 = m_templateMaster                 ;
-  result->m_formalTemplateArguments        = m_formalTemplateArguments        ;
-  result->m_defTmpArgLists                 = m_defTmpArgLists                 ;
   result->m_cachedAnonymousType            = m_cachedAnonymousType            ;
   result->m_sectionMap                     = m_sectionMap                     ;
   result->m_groupAlias                     = m_groupAlias                     ;
   result->m_grpId                          = m_grpId                          ;
   result->m_memberGroup                    = m_memberGroup                    ;
-  result->m_group                          = m_group                          ;
-  result->m_grouppri                       = m_grouppri                       ;
-  result->m_groupFileName                  = m_groupFileName                  ;
-  result->m_groupStartLine                 = m_groupStartLine                 ;
-  result->m_groupMember                    = m_groupMember                    ;
   result->m_isTypedefValCached             = m_isTypedefValCached             ;
   result->m_cachedTypedefValue             = m_cachedTypedefValue             ;
   result->m_cachedTypedefTemplSpec         = m_cachedTypedefTemplSpec         ;
   result->m_cachedResolvedType             = m_cachedResolvedType             ;
   result->m_docProvider                    = m_docProvider                    ;
-  result->m_explicitOutputFileBase         = m_explicitOutputFileBase         ;
-  result->m_qualifiers                     = m_qualifiers                     ;
   result->m_implOnly                       = m_implOnly                       ;
-  result->m_hasDocumentedParams            = m_hasDocumentedParams            ;
-  result->m_hasDocumentedReturnType        = m_hasDocumentedReturnType        ;
+  result->m_hasDocumentedParams            = m_hasDocumentedParams.load()     ;
+  result->m_hasDocumentedReturnType        = m_hasDocumentedReturnType.load() ;
   result->m_isDMember                      = m_isDMember                      ;
   result->m_proto                          = m_proto                          ;
   result->m_docEnumValues                  = m_docEnumValues                  ;
@@ -1508,15 +1508,12 @@ std::unique_ptr<MemberDef> MemberDefImpl::deepCopy() const
   result->m_hasInlineSource                = m_hasInlineSource                ;
   result->m_explExt                        = m_explExt                        ;
   result->m_tspec                          = m_tspec                          ;
-  result->m_groupHasDocs                   = m_groupHasDocs                   ;
   result->m_docsForDefinition              = m_docsForDefinition              ;
-  result->m_category                       = m_category                       ;
-  result->m_categoryRelation               = m_categoryRelation               ;
   result->m_declFileName                   = m_declFileName                   ;
   result->m_declLine                       = m_declLine                       ;
   result->m_declColumn                     = m_declColumn                     ;
   result->m_numberOfFlowKW                 = m_numberOfFlowKW                 ;
-  result->setDefinitionTemplateParameterLists(m_defTmpArgLists);
+  result->setDefinitionTemplateParameterLists(rare().defTmpArgLists);
 
   result->m_isLinkableCached    = 0;
   result->m_isConstructorCached = 0;
@@ -1606,12 +1603,12 @@ void MemberDefImpl::insertEnumField(MemberDef *md)
 bool MemberDefImpl::addExample(const QCString &anchor,const QCString &nameStr, const QCString &file)
 {
   //printf("%s::addExample(%s,%s,%s)\n",qPrint(name()),anchor,nameStr,file);
-  return m_examples.inSort(Example(anchor,nameStr,file));
+  return writableRare().examples.inSort(Example(anchor,nameStr,file));
 }
 
 bool MemberDefImpl::hasExamples() const
 {
-  return !m_examples.empty();
+  return !rare().examples.empty();
 }
 
 QCString MemberDefImpl::getOutputFileBase() const
@@ -1628,9 +1625,9 @@ QCString MemberDefImpl::getOutputFileBase() const
   const ClassDef *classDef = getClassDef();
   const ModuleDef *moduleDef = getModuleDef();
   const GroupDef *groupDef = getGroupDef();
-  if (!m_explicitOutputFileBase.isEmpty())
+  if (!rare().explicitOutputFileBase.isEmpty())
   {
-    return m_explicitOutputFileBase;
+    return rare().explicitOutputFileBase;
   }
   else if (templateMaster())
   {
@@ -1733,9 +1730,9 @@ QCString MemberDefImpl::anchor() const
   }
   if (getGroupDef())
   {
-    if (m_groupMember)
+    if (rare().groupMember)
     {
-      result=m_groupMember->anchor();
+      result=rare().groupMember->anchor();
     }
     else if (getReference().isEmpty())
     {
@@ -1879,7 +1876,7 @@ bool MemberDefImpl::isLinkable() const
 
 void MemberDefImpl::setDefinitionTemplateParameterLists(const ArgumentLists &lists)
 {
-  m_defTmpArgLists = lists;
+  if (!lists.empty() || m_rare) writableRare().defTmpArgLists = lists;
 }
 
 void MemberDefImpl::writeLink(OutputList &ol,
@@ -1936,14 +1933,14 @@ void MemberDefImpl::writeLink(OutputList &ol,
   }
 }
 
-static std::mutex g_cachedAnonymousTypeMutex;
+static NamedMutex g_cachedAnonymousTypeMutex("memberdef.cpp:g_cachedAnonymousTypeMutex");
 
 /*! If this member has an anonymous class/struct/union as its type, then
  *  this method will return the ClassDef that describes this return type.
  */
 ClassDef *MemberDefImpl::getClassDefOfAnonymousType() const
 {
-  std::lock_guard<std::mutex> lock(g_cachedAnonymousTypeMutex);
+  std::lock_guard<NamedMutex> lock(g_cachedAnonymousTypeMutex);
   //printf("%s:getClassDefOfAnonymousType() cache=%s\n",qPrint(name()),
   //                   m_cachedAnonymousType?qPrint(m_cachedAnonymousType->name()):"<empty>");
   if (m_cachedAnonymousType) return m_cachedAnonymousType;
@@ -2151,7 +2148,7 @@ void MemberDefImpl::_writeTemplatePrefix(OutputList &ol, const Definition *def,
     if (it!=al.end()) ol.docify(", ");
   }
   ol.docify("> ");
-  if (writeReqClause && !m_requiresClause.isEmpty())
+  if (writeReqClause && !rare().requiresClause.isEmpty())
   {
     ol.lineBreak();
     ol.docify("requires ");
@@ -2159,7 +2156,7 @@ void MemberDefImpl::_writeTemplatePrefix(OutputList &ol, const Definition *def,
         def,                     // scope
         getFileDef(),            // fileScope
         this,                    // self
-        m_requiresClause,  // text
+        rare().requiresClause,  // text
         FALSE                    // autoBreak
         );
   }
@@ -2176,7 +2173,7 @@ static QCString combineArgsAndException(QCString args,QCString exception)
 
 bool MemberDefImpl::_isAnonymousBitField() const
 {
-  return !m_bitfields.isEmpty() && name().startsWith("__pad"); // anonymous bitfield
+  return !rare().bitfields.isEmpty() && name().startsWith("__pad"); // anonymous bitfield
 }
 
 void MemberDefImpl::writeDeclaration(OutputList &ol,
@@ -2466,9 +2463,9 @@ void MemberDefImpl::writeDeclaration(OutputList &ol,
   }
 
   // *** write bitfields
-  if (!m_bitfields.isEmpty()) // add bitfields
+  if (!rare().bitfields.isEmpty()) // add bitfields
   {
-    linkifyText(TextGeneratorOLImpl(ol),d,getBodyDef(),this,m_bitfields);
+    linkifyText(TextGeneratorOLImpl(ol),d,getBodyDef(),this,rare().bitfields);
   }
   else if (hasOneLineInitializer()
       //!init.isEmpty() && initLines==0 && // one line initializer
@@ -2619,11 +2616,11 @@ void MemberDefImpl::writeDeclaration(OutputList &ol,
   //printf("< %s MemberDefImpl::writeDeclaration() inGroup=%d\n",qPrint(qualifiedName()),inGroup);
 }
 
-static std::mutex g_hasDetailedDescriptionMutex;
+static NamedMutex g_hasDetailedDescriptionMutex("memberdef.cpp:g_hasDetailedDescriptionMutex");
 
 bool MemberDefImpl::hasDetailedDescription() const
 {
-  std::lock_guard<std::mutex> lock(g_hasDetailedDescriptionMutex);
+  std::lock_guard<NamedMutex> lock(g_hasDetailedDescriptionMutex);
   //printf(">hasDetailedDescription(cached=%d)\n",m_hasDetailedDescriptionCached);
   if (!m_hasDetailedDescriptionCached)
   {
@@ -2685,7 +2682,7 @@ bool MemberDefImpl::hasDetailedDescription() const
            // examples
            hasExamples() ||
            // type constraints
-           m_typeConstraints.hasParameters() ||
+           rare().typeConstraints.hasParameters() ||
            // has source definition
            !getSourceFileBase().isEmpty() ||
            // has inline sources
@@ -2868,7 +2865,7 @@ StringVector MemberDefImpl::getLabels(const Definition *container) const
     sl.emplace_back("implementation");
   }
 
-  for (const auto &sx : m_qualifiers)
+  for (const auto &sx : rare().qualifiers)
   {
     bool alreadyAdded = std::find(sl.begin(), sl.end(), sx) != sl.end();
     if (!alreadyAdded)
@@ -3091,14 +3088,14 @@ void MemberDefImpl::_writeCategoryRelation(OutputList &ol) const
     QCString anc;
     QCString name;
     int i=-1;
-    if (m_categoryRelation && m_categoryRelation->isLinkable())
+    if (rare().categoryRelation && rare().categoryRelation->isLinkable())
     {
-      if (m_category)
+      if (rare().category)
       {
         // this member is in a normal class and implements method categoryRelation from category
         // so link to method 'categoryRelation' with 'provided by category 'category' text.
         text = theTranslator->trProvidedByCategory();
-        name = m_category->displayName();
+        name = rare().category->displayName();
       }
       else if (getClassDef()->categoryOf())
       {
@@ -3110,7 +3107,7 @@ void MemberDefImpl::_writeCategoryRelation(OutputList &ol) const
       i=text.find("@0");
       if (i!=-1)
       {
-        const MemberDef *md = m_categoryRelation;
+        const MemberDef *md = rare().categoryRelation;
         ref  = md->getReference();
         file = md->getOutputFileBase();
         anc  = md->anchor();
@@ -3134,7 +3131,7 @@ void MemberDefImpl::_writeExamples(OutputList &ol) const
   {
     ol.startExamples();
     ol.startDescForItem();
-    writeExamples(ol,m_examples);
+    writeExamples(ol,rare().examples);
     ol.endDescForItem();
     ol.endExamples();
   }
@@ -3142,9 +3139,9 @@ void MemberDefImpl::_writeExamples(OutputList &ol) const
 
 void MemberDefImpl::_writeTypeConstraints(OutputList &ol) const
 {
-  if (m_typeConstraints.hasParameters())
+  if (rare().typeConstraints.hasParameters())
   {
-    writeTypeConstraints(ol,this,m_typeConstraints);
+    writeTypeConstraints(ol,this,rare().typeConstraints);
   }
 }
 
@@ -3223,9 +3220,9 @@ QCString MemberDefImpl::displayDefinition() const
     if (isAnonymous())
     {
       ldef = title = "anonymous enum";
-      if (!m_enumBaseType.isEmpty())
+      if (!rare().enumBaseType.isEmpty())
       {
-        ldef+=" : "+m_enumBaseType;
+        ldef+=" : "+rare().enumBaseType;
       }
     }
     else
@@ -3419,9 +3416,9 @@ void MemberDefImpl::writeDocumentation(const MemberList *ml,
     if (title.at(0)=='@')
     {
       ldef = title = "anonymous enum";
-      if (!m_enumBaseType.isEmpty())
+      if (!rare().enumBaseType.isEmpty())
       {
-        ldef+=" : "+m_enumBaseType;
+        ldef+=" : "+rare().enumBaseType;
       }
     }
     else
@@ -3525,20 +3522,20 @@ void MemberDefImpl::writeDocumentation(const MemberList *ml,
     ol.startMemberDoc(ciname,name(),memAnchor,title,memCount,memTotal,showInline);
     ol.addLabel(cfname, memAnchor);
 
-    if (!m_metaData.isEmpty() && getLanguage()==SrcLangExt::Slice)
+    if (!rare().metaData.isEmpty() && getLanguage()==SrcLangExt::Slice)
     {
       ol.startMemberDocPrefixItem();
-      ol.docify(m_metaData);
+      ol.docify(rare().metaData);
       ol.endMemberDocPrefixItem();
     }
 
     const ClassDef *cd=getClassDef();
     const NamespaceDef *nd=getNamespaceDef();
     bool first=TRUE;
-    if (!m_defTmpArgLists.empty() && lang==SrcLangExt::Cpp)
+    if (!rare().defTmpArgLists.empty() && lang==SrcLangExt::Cpp)
       // definition has explicit template parameter declarations
     {
-      for (const ArgumentList &tal : m_defTmpArgLists)
+      for (const ArgumentList &tal : rare().defTmpArgLists)
       {
         if (!tal.empty())
         {
@@ -3850,7 +3847,7 @@ static QCString simplifyTypeForTable(const QCString &s)
 
 QCString MemberDefImpl::fieldType() const
 {
-  QCString type = m_accessorType;
+  QCString type = rare().accessorType;
   if (type.isEmpty())
   {
     type = m_type;
@@ -3874,7 +3871,7 @@ void MemberDefImpl::writeMemberDocSimple(OutputList &ol, const Definition *conta
     doxyName="__unnamed__";
   }
 
-  ClassDef *cd = m_accessorClass;
+  ClassDef *cd = rare().accessorClass;
   //printf("===> %s::anonymous: %s\n",qPrint(name()),cd?qPrint(cd->name()):"<none>");
 
   if (container && container->definitionType()==Definition::TypeClass &&
@@ -3928,9 +3925,9 @@ void MemberDefImpl::writeMemberDocSimple(OutputList &ol, const Definition *conta
   {
     linkifyText(TextGeneratorOLImpl(ol),getOuterScope(),getBodyDef(),this,argsString());
   }
-  if (!m_bitfields.isEmpty()) // add bitfields
+  if (!rare().bitfields.isEmpty()) // add bitfields
   {
-    linkifyText(TextGeneratorOLImpl(ol),getOuterScope(),getBodyDef(),this,m_bitfields);
+    linkifyText(TextGeneratorOLImpl(ol),getOuterScope(),getBodyDef(),this,rare().bitfields);
   }
   if (hasOneLineInitializer() && !isDefine())
   {
@@ -4083,13 +4080,13 @@ static QCString stripTrailingReturn(const QCString &trailRet)
   return trailRet;
 }
 
-static std::mutex g_detectUndocumentedParamsMutex;
+static NamedMutex g_detectUndocumentedParamsMutex("memberdef.cpp:g_detectUndocumentedParamsMutex");
 
 void MemberDefImpl::detectUndocumentedParams(bool hasParamCommand,bool hasReturnCommand) const
 {
   // this function is called while parsing the documentation. A member can have multiple
   // documentation blocks, which could be handled by multiple threads, hence this guard.
-  std::lock_guard<std::mutex> lock(g_detectUndocumentedParamsMutex);
+  std::lock_guard<NamedMutex> lock(g_detectUndocumentedParamsMutex);
 
   bool isPython = getLanguage()==SrcLangExt::Python;
 
@@ -4268,9 +4265,9 @@ void MemberDefImpl::setAnchor()
     buf[19]='\0';
     memAnchor.prepend(buf);
   }
-  if (!m_requiresClause.isEmpty())
+  if (!rare().requiresClause.isEmpty())
   {
-    memAnchor+=" "+m_requiresClause;
+    memAnchor+=" "+rare().requiresClause;
   }
 
   // convert to md5 hash
@@ -4286,12 +4283,13 @@ void MemberDefImpl::setGroupDef(const GroupDef *gd,Grouping::GroupPri_t pri,
                             bool hasDocs,MemberDef *member)
 {
   //printf("%s MemberDefImpl::setGroupDef(%s)\n",qPrint(name()),qPrint(gd->name()));
-  m_group=gd;
-  m_grouppri=pri;
-  m_groupFileName=fileName;
-  m_groupStartLine=startLine;
-  m_groupHasDocs=hasDocs;
-  m_groupMember=member;
+  RareData &rd = writableRare();
+  rd.group=gd;
+  rd.grouppri=pri;
+  rd.groupFileName=fileName;
+  rd.groupStartLine=startLine;
+  rd.groupHasDocs=hasDocs;
+  rd.groupMember=member;
   m_isLinkableCached = 0;
 }
 
@@ -4301,11 +4299,12 @@ void MemberDefImpl::setEnumScope(const MemberDef *md,bool livesInsideEnum)
   m_livesInsideEnum=livesInsideEnum;
   if (md->getGroupDef())
   {
-    m_group           = const_cast<GroupDef*>(md->getGroupDef());
-    m_grouppri        = md->getGroupPri();
-    m_groupFileName   = md->getGroupFileName();
-    m_groupStartLine  = md->getGroupStartLine();
-    m_groupHasDocs    = md->getGroupHasDocs();
+    RareData &rd = writableRare();
+    rd.group          = const_cast<GroupDef*>(md->getGroupDef());
+    rd.grouppri       = md->getGroupPri();
+    rd.groupFileName  = md->getGroupFileName();
+    rd.groupStartLine = md->getGroupStartLine();
+    rd.groupHasDocs   = md->getGroupHasDocs();
     m_isLinkableCached = 0;
   }
 }
@@ -4351,7 +4350,7 @@ std::unique_ptr<MemberDef> MemberDefImpl::createTemplateInstanceMember(
                        substituteTemplateArgumentsInString(m_type,formalArgs,actualArgs.get()),
                        methodName,
                        substituteTemplateArgumentsInString(m_args,formalArgs,actualArgs.get()),
-                       m_exception, m_prot,
+                       rare().exception, m_prot,
                        m_virt, m_stat, m_related, m_mtype,
                        ArgumentList(), ArgumentList(), ""
                    );
@@ -4690,11 +4689,11 @@ void MemberDefImpl::writeEnumDeclaration(OutputList &typeDecl,
     }
     typeDecl.writeChar(' ');
   }
-  if (!m_enumBaseType.isEmpty())
+  if (!rare().enumBaseType.isEmpty())
   {
     typeDecl.writeChar(':');
     typeDecl.writeChar(' ');
-    typeDecl.docify(m_enumBaseType);
+    typeDecl.docify(rare().enumBaseType);
     typeDecl.writeChar(' ');
   }
 
@@ -4794,7 +4793,7 @@ void MemberDefImpl::moveDeclArgumentList(std::unique_ptr<ArgumentList> al)
 
 void MemberDefImpl::setTypeConstraints(const ArgumentList &al)
 {
-  m_typeConstraints = al;
+  if (!al.empty() || m_rare) writableRare().typeConstraints = al;
 }
 
 void MemberDefImpl::setType(const QCString &t)
@@ -4804,13 +4803,15 @@ void MemberDefImpl::setType(const QCString &t)
 
 void MemberDefImpl::setAccessorType(ClassDef *cd,const QCString &t)
 {
-  m_accessorClass = cd;
-  m_accessorType = t;
+  if (cd==nullptr && t.isEmpty() && !m_rare) return;
+  RareData &rd = writableRare();
+  rd.accessorClass = cd;
+  rd.accessorType = t;
 }
 
 ClassDef *MemberDefImpl::accessorClass() const
 {
-  return m_accessorClass;
+  return rare().accessorClass;
 }
 
 void MemberDefImpl::findSectionsInDocumentation()
@@ -4897,7 +4898,7 @@ void MemberDefImpl::setTagInfo(const TagInfo *ti)
     //printf("%s: Setting tag name=%s anchor=%s\n",qPrint(name()),qPrint(ti->tagName),qPrint(ti->anchor));
     m_anc=ti->anchor;
     setReference(ti->tagName);
-    m_explicitOutputFileBase = stripExtension(ti->fileName);
+    writableRare().explicitOutputFileBase = stripExtension(ti->fileName);
   }
 }
 
@@ -4945,12 +4946,12 @@ QCString MemberDefImpl::argsString() const
 
 QCString MemberDefImpl::excpString() const
 {
-  return m_exception;
+  return rare().exception;
 }
 
 QCString MemberDefImpl::bitfieldString() const
 {
-  return m_bitfields;
+  return rare().bitfields;
 }
 
 const QCString &MemberDefImpl::initializer() const
@@ -5010,17 +5011,17 @@ NamespaceDef* MemberDefImpl::getNamespaceDef()
 
 QCString MemberDefImpl::getReadAccessor() const
 {
-  return m_read;
+  return rare().read;
 }
 
 QCString MemberDefImpl::getWriteAccessor() const
 {
-  return m_write;
+  return rare().write;
 }
 
 const GroupDef *MemberDefImpl::getGroupDef() const
 {
-  return m_group;
+  return rare().group;
 }
 
 const ModuleDef *MemberDefImpl::getModuleDef() const
@@ -5030,22 +5031,22 @@ const ModuleDef *MemberDefImpl::getModuleDef() const
 
 Grouping::GroupPri_t MemberDefImpl::getGroupPri() const
 {
-  return m_grouppri;
+  return rare().grouppri;
 }
 
 QCString MemberDefImpl::getGroupFileName() const
 {
-  return m_groupFileName;
+  return rare().groupFileName;
 }
 
 int MemberDefImpl::getGroupStartLine() const
 {
-  return m_groupStartLine;
+  return rare().groupStartLine;
 }
 
 bool MemberDefImpl::getGroupHasDocs() const
 {
-  return m_groupHasDocs;
+  return rare().groupHasDocs;
 }
 
 Protection MemberDefImpl::protection() const
@@ -5403,7 +5404,7 @@ bool MemberDefImpl::isCallable() const
 
 ClassDef *MemberDefImpl::relatedAlso() const
 {
-  return m_relatedAlso;
+  return rare().relatedAlso;
 }
 
 bool MemberDefImpl::hasDocumentedEnumValues() const
@@ -5463,7 +5464,7 @@ const MemberVector &MemberDefImpl::enumFieldList() const
 
 const ExampleList &MemberDefImpl::getExamples() const
 {
-  return m_examples;
+  return rare().examples;
 }
 
 bool MemberDefImpl::isPrototype() const
@@ -5536,7 +5537,7 @@ const ArgumentList &MemberDefImpl::templateArguments() const
 
 const ArgumentLists &MemberDefImpl::definitionTemplateParameterLists() const
 {
-  return m_defTmpArgLists;
+  return rare().defTmpArgLists;
 }
 
 int MemberDefImpl::getMemberGroupId() const
@@ -5612,7 +5613,7 @@ const MemberDef *MemberDefImpl::templateMaster() const
 
 std::optional<ArgumentList> MemberDefImpl::formalTemplateArguments() const
 {
-  return m_formalTemplateArguments;
+  return rare().formalTemplateArguments;
 }
 
 bool MemberDefImpl::isTypedefValCached() const
@@ -5721,24 +5722,25 @@ void MemberDefImpl::mergeMemberSpecifiers(TypeSpecifier s)
 
 StringVector MemberDefImpl::getQualifiers() const
 {
-  return m_qualifiers;
+  return rare().qualifiers;
 }
 
 void MemberDefImpl::addQualifiers(const StringVector &qualifiers)
 {
   for (const auto &sx : qualifiers)
   {
-    bool alreadyAdded = std::find(m_qualifiers.begin(), m_qualifiers.end(), sx) != m_qualifiers.end();
+    const StringVector &current = rare().qualifiers;
+    bool alreadyAdded = std::find(current.begin(), current.end(), sx) != current.end();
     if (!alreadyAdded)
     {
-      m_qualifiers.push_back(sx);
+      writableRare().qualifiers.push_back(sx);
     }
   }
 }
 
 void MemberDefImpl::setBitfields(const QCString &s)
 {
-  m_bitfields = QCString(s).simplifyWhiteSpace();
+  if (!s.isEmpty() || m_rare) writableRare().bitfields = QCString(s).simplifyWhiteSpace();
 }
 
 void MemberDefImpl::setMaxInitLines(int lines)
@@ -5751,12 +5753,12 @@ void MemberDefImpl::setMaxInitLines(int lines)
 
 void MemberDefImpl::setReadAccessor(const QCString &r)
 {
-  m_read=r;
+  if (!r.isEmpty() || m_rare) writableRare().read=r;
 }
 
 void MemberDefImpl::setWriteAccessor(const QCString &w)
 {
-  m_write=w;
+  if (!w.isEmpty() || m_rare) writableRare().write=w;
 }
 
 void MemberDefImpl::setTemplateSpecialization(bool b)
@@ -5788,7 +5790,7 @@ void MemberDefImpl::setArgsString(const QCString &as)
 
 void MemberDefImpl::setRelatedAlso(ClassDef *cd)
 {
-  m_relatedAlso=cd;
+  if (cd || m_rare) writableRare().relatedAlso=cd;
 }
 
 void MemberDefImpl::setEnumClassScope(ClassDef *cd)
@@ -5874,7 +5876,7 @@ void MemberDefImpl::setTemplateMaster(MemberDef *mt)
 
 void MemberDefImpl::setFormalTemplateArguments(const ArgumentList &al)
 {
-  m_formalTemplateArguments = al;
+  writableRare().formalTemplateArguments = al;
 }
 
 void MemberDefImpl::setDocsForDefinition(bool b)
@@ -5904,42 +5906,42 @@ void MemberDefImpl::setMemberDeclaration(MemberDef *md)
 
 ClassDef *MemberDefImpl::category() const
 {
-  return m_category;
+  return rare().category;
 }
 
 void MemberDefImpl::setCategory(ClassDef *def)
 {
-  m_category = def;
+  if (def || m_rare) writableRare().category = def;
 }
 
 const MemberDef *MemberDefImpl::categoryRelation() const
 {
-  return m_categoryRelation;
+  return rare().categoryRelation;
 }
 
 void MemberDefImpl::setCategoryRelation(const MemberDef *md)
 {
-  m_categoryRelation = md;
+  if (md || m_rare) writableRare().categoryRelation = md;
 }
 
 void MemberDefImpl::setEnumBaseType(const QCString &type)
 {
-  m_enumBaseType = type;
+  if (!type.isEmpty() || m_rare) writableRare().enumBaseType = type;
 }
 
 QCString MemberDefImpl::enumBaseType() const
 {
-  return m_enumBaseType;
+  return rare().enumBaseType;
 }
 
 void MemberDefImpl::setRequiresClause(const QCString &req)
 {
-  m_requiresClause = req;
+  if (!req.isEmpty() || m_rare) writableRare().requiresClause = req;
 }
 
 QCString MemberDefImpl::requiresClause() const
 {
-  return m_requiresClause;
+  return rare().requiresClause;
 }
 
 void MemberDefImpl::cacheTypedefVal(const ClassDef*val, const QCString & templSpec, const QCString &resolvedType)
@@ -6201,7 +6203,7 @@ QCString MemberDefImpl::documentation() const
 
 const ArgumentList &MemberDefImpl::typeConstraints() const
 {
-  return m_typeConstraints;
+  return rare().typeConstraints;
 }
 
 bool MemberDefImpl::isFriendToHide() const
@@ -6270,14 +6272,14 @@ CodeSymbolType MemberDefImpl::codeSymbolType() const
 //-------------------------------------------------------------------------------
 // Helpers
 
-static std::mutex g_docCrossReferenceMutex;
+static NamedMutex g_docCrossReferenceMutex("memberdef.cpp:g_docCrossReferenceMutex");
 
 void addDocCrossReference(const MemberDef *s,const MemberDef *d)
 {
   MemberDefMutable *src = toMemberDefMutable(const_cast<MemberDef*>(s));
   MemberDefMutable *dst = toMemberDefMutable(const_cast<MemberDef*>(d));
   if (src==nullptr || dst==nullptr) return;
-  std::lock_guard<std::mutex> lock(g_docCrossReferenceMutex);
+  std::lock_guard<NamedMutex> lock(g_docCrossReferenceMutex);
   //printf("--> addDocCrossReference src=%s,dst=%s\n",qPrint(src->name()),qPrint(dst->name()));
   if (dst->isTypedef() || dst->isEnumerate()) return; // don't add types
   if ((dst->hasReferencedByRelation() || dst->hasCallerGraph()) &&
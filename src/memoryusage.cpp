@@ -0,0 +1,104 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <array>
+#include <atomic>
+
+#include "memoryusage.h"
+
+namespace
+{
+
+struct AtomicCounters
+{
+  std::atomic<uint64_t> allocations { 0 };
+  std::atomic<uint64_t> frees       { 0 };
+  std::atomic<int64_t>  bytes       { 0 };
+  std::atomic<int64_t>  peakBytes   { 0 };
+};
+
+std::atomic<bool> g_enabled { false };
+std::array<AtomicCounters,static_cast<size_t>(MemoryCategory::Count)> g_counters;
+
+AtomicCounters &countersFor(MemoryCategory category)
+{
+  return g_counters[static_cast<size_t>(category)];
+}
+
+} // namespace
+
+void MemoryUsage::enableCounters()
+{
+  g_enabled = true;
+}
+
+bool MemoryUsage::countersEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void MemoryUsage::allocated(MemoryCategory category,size_t size)
+{
+  if (!countersEnabled()) return;
+  AtomicCounters &c = countersFor(category);
+  c.allocations.fetch_add(1,std::memory_order_relaxed);
+  int64_t bytes = c.bytes.fetch_add(static_cast<int64_t>(size),std::memory_order_relaxed)+static_cast<int64_t>(size);
+  int64_t peak  = c.peakBytes.load(std::memory_order_relaxed);
+  while (bytes>peak && !c.peakBytes.compare_exchange_weak(peak,bytes,std::memory_order_relaxed)) {}
+}
+
+void MemoryUsage::freed(MemoryCategory category,size_t size)
+{
+  if (!countersEnabled()) return;
+  AtomicCounters &c = countersFor(category);
+  c.frees.fetch_add(1,std::memory_order_relaxed);
+  c.bytes.fetch_sub(static_cast<int64_t>(size),std::memory_order_relaxed);
+}
+
+MemoryUsage::Counters MemoryUsage::counters(MemoryCategory category)
+{
+  const AtomicCounters &c = countersFor(category);
+  Counters result;
+  result.allocations = c.allocations.load();
+  result.frees       = c.frees.load();
+  result.bytes       = c.bytes.load();
+  result.peakBytes   = c.peakBytes.load();
+  return result;
+}
+
+const char *MemoryUsage::categoryName(MemoryCategory category)
+{
+  switch (category)
+  {
+    case MemoryCategory::EntryTree:         return "entries";
+    case MemoryCategory::ClassDefs:         return "classDefs";
+    case MemoryCategory::MemberDefs:        return "memberDefs";
+    case MemoryCategory::FileDefs:          return "fileDefs";
+    case MemoryCategory::NamespaceDefs:     return "namespaceDefs";
+    case MemoryCategory::GroupDefs:         return "groupDefs";
+    case MemoryCategory::PageDefs:          return "pageDefs";
+    case MemoryCategory::DirDefs:           return "dirDefs";
+    case MemoryCategory::ConceptDefs:       return "conceptDefs";
+    case MemoryCategory::ModuleDefs:        return "moduleDefs";
+    case MemoryCategory::DefinitionAliases: return "definitionAliases";
+    case MemoryCategory::DefinitionData:    return "definitionData";
+    case MemoryCategory::DocAst:            return "docNodes";
+    case MemoryCategory::LookupCaches:      return "lookupCaches";
+    case MemoryCategory::CodeRecorder:      return "codeRecorder";
+    case MemoryCategory::DotGraphs:         return "dotNodes";
+    case MemoryCategory::Count:             break;
+  }
+  return "unknown";
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/** Subsystems for which the memory usage can be counted */
+enum class MemoryCategory
+{
+  EntryTree,          //!< Entry objects produced by the parsers
+  ClassDefs,          //!< class definitions
+  MemberDefs,         //!< member definitions
+  FileDefs,           //!< file definitions
+  NamespaceDefs,      //!< namespace definitions
+  GroupDefs,          //!< group definitions
+  PageDefs,           //!< page definitions
+  DirDefs,            //!< directory definitions
+  ConceptDefs,        //!< concept definitions
+  ModuleDefs,         //!< module definitions
+  DefinitionAliases,  //!< aliases of class, member, namespace and concept definitions
+  DefinitionData,     //!< data shared by all definitions (DefinitionImpl)
+  DocAst,             //!< nodes of parsed documentation blocks
+  LookupCaches,       //!< entries of the type and symbol lookup caches
+  CodeRecorder,       //!< calls recorded by OutputCodeRecorder
+  DotGraphs,          //!< nodes of dot graphs
+  Count
+};
+
+/** @brief Counters for the objects allocated by the subsystems listed in MemoryCategory.
+ *
+ *  Counting is off by default and is switched on with enableCounters() (see the
+ *  \c -d \c memory and \c --memory-report options). It must be switched on before
+ *  any of the counted objects are created, since objects created before that are
+ *  not counted when they are freed either.
+ *
+ *  The counters track the number of objects and their shallow size, i.e. the size of the
+ *  object itself without the memory owned by its members, so they show how the number
+ *  of objects of a subsystem develops rather than the exact memory it uses.
+ */
+namespace MemoryUsage
+{
+  struct Counters
+  {
+    uint64_t allocations = 0; //!< number of objects created
+    uint64_t frees       = 0; //!< number of objects destroyed
+    int64_t  bytes       = 0; //!< shallow size of the live objects
+    int64_t  peakBytes   = 0; //!< highest value of bytes
+  };
+
+  void enableCounters();
+  bool countersEnabled();
+  void allocated(MemoryCategory category,size_t size);
+  void freed(MemoryCategory category,size_t size);
+  Counters counters(MemoryCategory category);
+  const char *categoryName(MemoryCategory category);
+}
+
+/** @brief Base class that counts its instances in memory category \a C with the size of \a T.
+ *
+ *  Works for objects allocated in any way, including objects stored by value in a container.
+ *  \a T is normally the class itself, or the type that stores it, such as a variant.
+ */
+template<MemoryCategory C,class T>
+class MemoryCounted
+{
+  protected:
+    MemoryCounted()                      { MemoryUsage::allocated(C,sizeof(T)); }
+    MemoryCounted(const MemoryCounted &) { MemoryUsage::allocated(C,sizeof(T)); }
+    MemoryCounted(MemoryCounted &&)      { MemoryUsage::allocated(C,sizeof(T)); }
+    MemoryCounted &operator=(const MemoryCounted &) = default;
+    MemoryCounted &operator=(MemoryCounted &&)      = default;
+   ~MemoryCounted()                      { MemoryUsage::freed(C,sizeof(T)); }
+};
+
+/** @brief Base class that counts the heap allocations of a class hierarchy in memory category \a C.
+ *
+ *  Unlike MemoryCounted the actual size of the most derived class is counted, but only for
+ *  objects created with \c new (which includes std::make_unique, but not std::make_shared).
+ */
+template<MemoryCategory C>
+class MemoryTracked
+{
+  public:
+    static void *operator new(size_t size)
+    {
+      void *p = ::operator new(size);
+      MemoryUsage::allocated(C,size);
+      return p;
+    }
+    static void operator delete(void *p,size_t size)
+    {
+      MemoryUsage::freed(C,size);
+      ::operator delete(p);
+    }
+};
+
+#endif
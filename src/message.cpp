@@ -17,6 +17,14 @@
 #include <cstdlib>
 #include <mutex>
 #include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include "config.h"
 #include "debug.h"
@@ -25,6 +33,9 @@
 #include "doxygen.h"
 #include "fileinfo.h"
 #include "dir.h"
+#include "namedmutex.h"
+#include "version.h"
+#include "stringutil.h"
 
 // globals
 static QCString        g_warnFormat;
@@ -36,7 +47,397 @@ static WARN_AS_ERROR_t g_warnBehavior = WARN_AS_ERROR_t::NO;
 static QCString        g_warnlogFile;
 static bool            g_warnlogTemp = false;
 static std::atomic_bool g_warnStat = false;
-static std::mutex      g_mutex;
+static NamedMutex      g_mutex("message.cpp:g_mutex");
+static FILE *          g_structFile = nullptr;
+static bool            g_structSarif = false;
+static bool            g_structFirst = true;
+static bool            g_warnSorted = false;
+
+//---------------------------------------------------------------------------------------------
+
+namespace
+{
+
+/** A single warning or error message */
+struct Warning
+{
+  uint64_t    seq;       // order in which the messages were issued
+  bool        isError;
+  const char *category;  // "general", "undocumented", "incomplete_doc", "doc_error" or "error"
+  QCString    file;
+  int         line;
+  QCString    text;      // message text without prefix and location
+  QCString    formatted; // message as written to the warning log, including the newline
+};
+
+/** Warnings issued by one thread that are not yet processed by the writer */
+struct ThreadBuffer
+{
+  std::mutex           mutex; // only contended while the writer takes the warnings
+  std::vector<Warning> warnings;
+};
+
+const size_t kBatchSize = 256;
+
+std::atomic<bool>                            g_async { false }; // warnings go through the writer thread
+std::atomic<uint64_t>                        g_seq { 0 };
+std::mutex                                   g_buffersMutex;
+std::vector< std::shared_ptr<ThreadBuffer> > g_buffers;
+std::vector< std::shared_ptr<ThreadBuffer> > g_freeBuffers;
+std::mutex                                   g_pipeMutex;
+std::condition_variable                      g_pipeCond;
+std::condition_variable                      g_flushedCond;
+std::atomic<bool>                            g_batchReady { false };
+bool                                         g_stopWriter = false;
+uint64_t                                     g_flushRequested = 0;
+uint64_t                                     g_flushDone = 0;
+std::thread                                  g_writer;
+std::atomic<bool>                            g_writerRunning { false };
+// only accessed by the writer thread, or after it has finished
+std::unordered_set<std::string>              g_seen; // the messages written so far
+std::vector<Warning>                         g_collected;
+size_t                                       g_duplicates = 0;
+
+/** Owns the buffer of the current thread. A thread that finishes hands its buffer
+ *  back, so it can be reused by the workers of the next thread pool. Any warnings
+ *  still in the buffer are picked up by the writer as usual.
+ */
+struct ThreadSlot
+{
+  ThreadSlot()
+  {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    if (!g_freeBuffers.empty())
+    {
+      buffer = g_freeBuffers.back();
+      g_freeBuffers.pop_back();
+    }
+    else
+    {
+      buffer = std::make_shared<ThreadBuffer>();
+      g_buffers.push_back(buffer);
+    }
+  }
+ ~ThreadSlot()
+  {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    g_freeBuffers.push_back(buffer);
+  }
+  NON_COPYABLE(ThreadSlot)
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+ThreadBuffer &threadBuffer()
+{
+  static thread_local ThreadSlot slot;
+  return *slot.buffer;
+}
+
+/** Converts a file name into a URI as required by SARIF. */
+QCString fileToUri(const QCString &file)
+{
+  QCString path = substitute(file,"\\","/");
+  QCString result;
+  if (path.startsWith("/"))
+  {
+    result = "file://";
+  }
+  else if (path.length()>1 && path.at(1)==':')
+  {
+    result = "file:///";
+  }
+  static const char hex[] = "0123456789ABCDEF";
+  for (const char *p=path.data(); *p; p++)
+  {
+    unsigned char c = static_cast<unsigned char>(*p);
+    if (isalnum(c) || c=='/' || c=='-' || c=='_' || c=='.' || c=='~' || c==':')
+    {
+      result+=static_cast<char>(c);
+    }
+    else
+    {
+      result+='%';
+      result+=hex[c>>4];
+      result+=hex[c&0xF];
+    }
+  }
+  return result;
+}
+
+/** Writes the message \a w to the structured log, g_mutex should be locked */
+void writeStructured(const Warning &w)
+{
+  if (g_structFile==nullptr) return;
+  std::string out;
+  if (g_structSarif)
+  {
+    out+= g_structFirst ? "\n" : ",\n";
+    out+="{\"ruleId\":";
+    appendJsonString(out,w.category);
+    out+=",\"level\":";
+    out+= w.isError ? "\"error\"" : "\"warning\"";
+    out+=",\"message\":{\"text\":";
+    appendJsonString(out,w.text.view());
+    out+="}";
+    if (!w.file.isEmpty())
+    {
+      out+=",\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":";
+      appendJsonString(out,fileToUri(w.file).view());
+      out+="}";
+      if (w.line>0)
+      {
+        out+=",\"region\":{\"startLine\":"+std::to_string(w.line)+"}";
+      }
+      out+="}}]";
+    }
+    out+="}";
+  }
+  else
+  {
+    out+="{\"severity\":";
+    out+= w.isError ? "\"error\"" : "\"warning\"";
+    out+=",\"category\":";
+    appendJsonString(out,w.category);
+    if (!w.file.isEmpty())
+    {
+      out+=",\"file\":";
+      appendJsonString(out,w.file.view());
+      out+=",\"line\":"+std::to_string(w.line);
+    }
+    out+=",\"message\":";
+    appendJsonString(out,w.text.view());
+    out+="}\n";
+  }
+  g_structFirst=false;
+  fwrite(out.data(),1,out.length(),g_structFile);
+}
+
+/** Writes the message \a w to the warning log and the structured log, g_mutex should be locked */
+void writeWarning(const Warning &w)
+{
+  fwrite(w.formatted.data(),1,w.formatted.length(),g_warnFile);
+  writeStructured(w);
+}
+
+void openStructuredLog()
+{
+  QCString fileName = Config_getString(WARN_STRUCTURED_LOGFILE);
+  if (fileName.isEmpty()) return;
+  FileInfo fi(fileName.str());
+  Dir d(fi.dirPath().c_str());
+  if ((!d.exists() && !d.mkdir(fi.dirPath().c_str())) || !(g_structFile = Portable::fopen(fileName,"w")))
+  {
+    g_structFile = nullptr;
+    err("Cannot open '%s' for writing, 'WARN_STRUCTURED_LOGFILE' will not be written\n",fileName.data());
+    return;
+  }
+  g_structSarif = Config_getEnum(WARN_STRUCTURED_FORMAT)==WARN_STRUCTURED_FORMAT_t::SARIF;
+  g_structFirst = true;
+  if (g_structSarif)
+  {
+    std::string header = "{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"version\":\"2.1.0\","
+                         "\"runs\":[{\"tool\":{\"driver\":{\"name\":\"doxygen\",\"version\":";
+    appendJsonString(header,getDoxygenVersion());
+    header+=",\"informationUri\":\"https://www.doxygen.org\"}},\"results\":[";
+    fwrite(header.data(),1,header.length(),g_structFile);
+  }
+}
+
+void closeStructuredLog()
+{
+  std::lock_guard<NamedMutex> lock(g_mutex);
+  if (g_structFile==nullptr) return;
+  if (g_structSarif)
+  {
+    const char *footer = "\n]}]}\n";
+    fwrite(footer,1,strlen(footer),g_structFile);
+  }
+  Portable::fclose(g_structFile);
+  g_structFile = nullptr;
+}
+
+/** Takes the pending warnings of all threads and writes them in the order they were issued.
+ *  Identical warnings are written only once. When WARN_SORTED is set the warnings are
+ *  only collected, they are written sorted by stopPipeline().
+ *  Only called by the writer thread.
+ */
+void drainBuffers()
+{
+  std::vector<Warning> warnings;
+  {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    for (const auto &buf : g_buffers)
+    {
+      std::lock_guard<std::mutex> bufLock(buf->mutex);
+      if (warnings.empty())
+      {
+        warnings.swap(buf->warnings);
+      }
+      else
+      {
+        std::move(buf->warnings.begin(),buf->warnings.end(),std::back_inserter(warnings));
+        buf->warnings.clear();
+      }
+    }
+  }
+  if (warnings.empty()) return;
+  // each buffer is already in order, so only the warnings of different threads need to be merged
+  std::vector<Warning*> ordered;
+  ordered.reserve(warnings.size());
+  for (auto &w : warnings) ordered.push_back(&w);
+  std::sort(ordered.begin(),ordered.end(),
+            [](const auto &w1,const auto &w2) { return w1->seq<w2->seq; });
+  std::lock_guard<NamedMutex> lock(g_mutex);
+  for (auto w : ordered)
+  {
+    if (!g_seen.insert(w->formatted.str()).second)
+    {
+      g_duplicates++;
+    }
+    else if (g_warnSorted)
+    {
+      g_collected.push_back(std::move(*w));
+    }
+    else
+    {
+      writeWarning(*w);
+    }
+  }
+  if (!g_warnSorted)
+  {
+    fflush(g_warnFile);
+    if (g_structFile) fflush(g_structFile);
+  }
+}
+
+void writerLoop()
+{
+  for (;;)
+  {
+    std::unique_lock<std::mutex> lock(g_pipeMutex);
+    g_pipeCond.wait_for(lock,std::chrono::milliseconds(100),
+        []() { return g_stopWriter || g_flushRequested>g_flushDone || g_batchReady.load(); });
+    bool stop = g_stopWriter;
+    uint64_t requested = g_flushRequested;
+    g_batchReady = false;
+    lock.unlock();
+
+    drainBuffers();
+
+    lock.lock();
+    g_flushDone = requested;
+    g_flushedCond.notify_all();
+    if (stop) break;
+  }
+}
+
+void startPipeline()
+{
+  g_warnSorted = Config_getBool(WARN_SORTED);
+  g_stopWriter = false;
+  g_writerRunning = true;
+  g_async = true;
+  g_writer = std::thread(writerLoop);
+}
+
+/** Waits until the writer has written all warnings issued so far */
+void flushPipeline()
+{
+  if (!g_async) return;
+  std::unique_lock<std::mutex> lock(g_pipeMutex);
+  uint64_t requested = ++g_flushRequested;
+  g_pipeCond.notify_one();
+  g_flushedCond.wait(lock,[requested]() { return g_flushDone>=requested || !g_writerRunning; });
+}
+
+/** Writes all pending warnings and stops the writer thread. Warnings issued afterwards
+ *  are written directly.
+ */
+void stopPipeline()
+{
+  if (!g_writerRunning.exchange(false)) return;
+  {
+    std::lock_guard<std::mutex> lock(g_pipeMutex);
+    g_async = false;
+    g_stopWriter = true;
+  }
+  g_pipeCond.notify_one();
+  g_writer.join();
+
+  size_t duplicates = 0;
+  {
+    std::lock_guard<NamedMutex> lock(g_mutex);
+    if (g_warnSorted)
+    {
+      std::sort(g_collected.begin(),g_collected.end(),
+                [](const auto &w1,const auto &w2)
+                {
+                  if (w1.file!=w2.file) return w1.file<w2.file;
+                  if (w1.line!=w2.line) return w1.line<w2.line;
+                  return w1.formatted<w2.formatted;
+                });
+      for (const auto &w : g_collected)
+      {
+        writeWarning(w);
+      }
+      g_collected.clear();
+    }
+    fflush(g_warnFile);
+    duplicates = g_duplicates;
+    g_seen.clear();
+    g_duplicates = 0;
+  }
+  if (duplicates>0)
+  {
+    msg("Suppressed %zu duplicate warning(s)\n",duplicates);
+  }
+}
+
+/** Hands a message to the writer thread or, if it is not running, writes it directly.
+ *  The file name and plain text are only kept when they are needed for sorting or the
+ *  structured log.
+ */
+void emitWarning(bool isError,const char *category,const QCString &file,int line,
+                 const QCString &text,QCString &&formatted)
+{
+  bool structured = g_structFile!=nullptr;
+  Warning w { 0, isError, category,
+              structured || g_warnSorted ? file : QCString(), line,
+              structured ? text : QCString(),
+              std::move(formatted) };
+  if (g_async)
+  {
+    ThreadBuffer &buf = threadBuffer();
+    std::lock_guard<std::mutex> lock(buf.mutex);
+    if (g_async) // check again now that the writer cannot take the buffer
+    {
+      w.seq = g_seq++;
+      buf.warnings.push_back(std::move(w));
+      if (buf.warnings.size()>=kBatchSize && !g_batchReady.exchange(true))
+      {
+        g_pipeCond.notify_one();
+      }
+      return;
+    }
+  }
+  std::lock_guard<NamedMutex> lock(g_mutex);
+  writeWarning(w);
+}
+
+QCString vformat(const char *fmt,va_list args)
+{
+  va_list argsCopy;
+  va_copy(argsCopy, args);
+  size_t bufSize = vsnprintf(nullptr, 0, fmt, args);
+  QCString text(bufSize, QCString::ExplicitSize);
+  vsnprintf(text.rawData(), bufSize+1, fmt, argsCopy);
+  va_end(argsCopy);
+  return text;
+}
+
+} // namespace
+
+//---------------------------------------------------------------------------------------------
 
 void initWarningFormat()
 {
@@ -83,9 +484,19 @@ void initWarningFormat()
   {
     g_warningStr = g_errorStr;
   }
+  openStructuredLog();
+
+  // with WARN_AS_ERROR=YES doxygen stops at the first warning, so there is nothing to buffer
+  if (g_warnBehavior != WARN_AS_ERROR_t::YES)
+  {
+    startPipeline();
+  }
 
-  // make sure the g_warnFile is closed in case we call exit and it is still open
+  // make sure the pending warnings are written and the g_warnFile is closed in case we call
+  // exit and it is still open
   std::atexit([](){
+      stopPipeline();
+      closeStructuredLog();
       if (g_warnFile && g_warnFile!=stderr && g_warnFile!=stdout)
       {
         Portable::fclose(g_warnFile);
@@ -99,7 +510,7 @@ void msg(const char *fmt, ...)
 {
   if (!Config_getBool(QUIET))
   {
-    std::unique_lock<std::mutex> lock(g_mutex);
+    std::unique_lock<NamedMutex> lock(g_mutex);
     if (Debug::isFlagSet(Debug::Time))
     {
       printf("%.3f sec: ",(static_cast<double>(Debug::elapsedTime())));
@@ -111,11 +522,11 @@ void msg(const char *fmt, ...)
   }
 }
 
-static void format_warn(const QCString &file,int line,const QCString &text)
+static void format_warn(const char *category,const QCString &file,int line,const char *prefix,const QCString &text)
 {
   QCString fileSubst = file.isEmpty() ? "<unknown>" : file;
   QCString lineSubst; lineSubst.setNum(line);
-  QCString textSubst = text;
+  QCString textSubst = prefix ? QCString(prefix)+text : text;
   QCString versionSubst;
   // substitute markers by actual values
   QCString msgText =
@@ -138,11 +549,8 @@ static void format_warn(const QCString &file,int line,const QCString &text)
   }
   msgText += '\n';
 
-  {
-    std::unique_lock<std::mutex> lock(g_mutex);
-    // print resulting message
-    fwrite(msgText.data(),1,msgText.length(),g_warnFile);
-  }
+  // print resulting message
+  emitWarning(prefix==g_errorStr,category,file,line,text,std::move(msgText));
   if (g_warnBehavior == WARN_AS_ERROR_t::YES)
   {
     Doxygen::terminating=true;
@@ -156,7 +564,7 @@ static void handle_warn_as_error()
   if (g_warnBehavior == WARN_AS_ERROR_t::YES)
   {
     {
-      std::unique_lock<std::mutex> lock(g_mutex);
+      std::unique_lock<NamedMutex> lock(g_mutex);
       QCString msgText = " (warning treated as error, aborting now)\n";
       fwrite(msgText.data(),1,msgText.length(),g_warnFile);
     }
@@ -166,33 +574,18 @@ static void handle_warn_as_error()
   g_warnStat = true;
 }
 
-static void do_warn(bool enabled, const QCString &file, int line, const char *prefix, const char *fmt, va_list args)
+static void do_warn(bool enabled, const char *category, const QCString &file, int line, const char *prefix, const char *fmt, va_list args)
 {
   if (!enabled) return; // warning type disabled
 
-  va_list argsCopy;
-  va_copy(argsCopy, args);
-
-  size_t l=0;
-  if (prefix)
-  {
-    l=strlen(prefix);
-  }
-  // determine needed buffersize based on:
-  // format + arguments
-  // prefix
-  // 1 position for `\0`
-  size_t bufSize = vsnprintf(nullptr, 0, fmt, args) + l;
-  QCString text(bufSize, QCString::ExplicitSize);
-  if (prefix)
-  {
-    qstrncpy(text.rawData(),prefix,bufSize);
-  }
-  vsnprintf(text.rawData()+l, bufSize-l+1, fmt, argsCopy);
-  text[bufSize]='\0';
-  format_warn(file,line,text);
+  format_warn(category,file,line,prefix,vformat(fmt,args));
+}
 
-  va_end(argsCopy);
+static void do_warn_uncond(const char *category, const char *prefix, const char *fmt, va_list args)
+{
+  QCString text = vformat(fmt,args);
+  QCString msgText = QCString(prefix)+text;
+  emitWarning(prefix==g_errorStr,category,QCString(),0,text.stripWhiteSpace(),std::move(msgText));
 }
 
 QCString warn_line(const QCString &file,int line)
@@ -211,20 +604,20 @@ void warn_(const QCString &file,int line,const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  do_warn(Config_getBool(WARNINGS), file, line, g_warningStr, fmt, args);
+  do_warn(Config_getBool(WARNINGS), "general", file, line, g_warningStr, fmt, args);
   va_end(args);
 }
 
 void va_warn(const QCString &file,int line,const char *fmt,va_list args)
 {
-  do_warn(Config_getBool(WARNINGS), file, line, g_warningStr, fmt, args);
+  do_warn(Config_getBool(WARNINGS), "general", file, line, g_warningStr, fmt, args);
 }
 
 void warn_undoc_(const QCString &file,int line,const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  do_warn(Config_getBool(WARN_IF_UNDOCUMENTED), file, line, g_warningStr, fmt, args);
+  do_warn(Config_getBool(WARN_IF_UNDOCUMENTED), "undocumented", file, line, g_warningStr, fmt, args);
   va_end(args);
 }
 
@@ -232,7 +625,7 @@ void warn_incomplete_doc_(const QCString &file,int line,const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  do_warn(Config_getBool(WARN_IF_INCOMPLETE_DOC), file, line, g_warningStr, fmt, args);
+  do_warn(Config_getBool(WARN_IF_INCOMPLETE_DOC), "incomplete_doc", file, line, g_warningStr, fmt, args);
   va_end(args);
 }
 
@@ -240,7 +633,7 @@ void warn_doc_error_(const QCString &file,int line,const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  do_warn(Config_getBool(WARN_IF_DOC_ERROR), file, line, g_warningStr, fmt, args);
+  do_warn(Config_getBool(WARN_IF_DOC_ERROR), "doc_error", file, line, g_warningStr, fmt, args);
   va_end(args);
 }
 
@@ -248,7 +641,7 @@ void warn_uncond_(const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  vfprintf(g_warnFile, (QCString(g_warningStr) + fmt).data(), args);
+  do_warn_uncond("general", g_warningStr, fmt, args);
   va_end(args);
   handle_warn_as_error();
 }
@@ -257,7 +650,7 @@ void err_(const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  vfprintf(g_warnFile, (QCString(g_errorStr) + fmt).data(), args);
+  do_warn_uncond("error", g_errorStr, fmt, args);
   va_end(args);
   handle_warn_as_error();
 }
@@ -266,24 +659,27 @@ extern void err_full_(const QCString &file,int line,const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  do_warn(TRUE, file, line, g_errorStr, fmt, args);
+  do_warn(TRUE, "error", file, line, g_errorStr, fmt, args);
   va_end(args);
 }
 
 void term_(const char *fmt, ...)
 {
+  stopPipeline(); // the pending warnings precede the fatal error
   {
-    std::unique_lock<std::mutex> lock(g_mutex);
+    std::unique_lock<NamedMutex> lock(g_mutex);
     va_list args;
     va_start(args, fmt);
-    vfprintf(g_warnFile, (QCString(g_errorStr) + fmt).data(), args);
+    QCString text = vformat(fmt,args);
     va_end(args);
+    QCString msgText = QCString(g_errorStr)+text;
     if (g_warnFile != stderr)
     {
       size_t l = strlen(g_errorStr);
-      for (size_t i=0; i<l; i++) fprintf(g_warnFile, " ");
-      fprintf(g_warnFile, "%s\n", "Exiting...");
+      for (size_t i=0; i<l; i++) msgText+=' ';
+      msgText+="Exiting...\n";
     }
+    writeWarning(Warning{0,true,"error",QCString(),0,text.stripWhiteSpace(),msgText});
   }
   Doxygen::terminating=true;
   exit(1);
@@ -291,6 +687,7 @@ void term_(const char *fmt, ...)
 
 void warn_flush()
 {
+  flushPipeline();
   fflush(g_warnFile);
 }
 
@@ -298,6 +695,8 @@ void warn_flush()
 
 extern void finishWarnExit()
 {
+  stopPipeline();
+  closeStructuredLog();
   fflush(stdout);
   if (g_warnBehavior == WARN_AS_ERROR_t::FAIL_ON_WARNINGS_PRINT && g_warnlogFile != "-")
   {
@@ -30,6 +30,7 @@
 #include "classdef.h"
 #include "textstream.h"
 #include "trace.h"
+#include "shardmodel.h"
 
 class ModuleDefImpl;
 
@@ -1187,6 +1188,7 @@ void ModuleManager::createModuleDef(const QCString &fileName,int line,int column
 {
   AUTO_TRACE("{}:{}: Found module name='{}' partition='{}' exported='{}'",
       fileName,line,moduleName,partitionName,exported);
+  ShardModel::instance().recordModule(fileName,line,column,exported,moduleName,partitionName);
   ModuleDef::Type mt = exported ? ModuleDef::Type::Interface : ModuleDef::Type::Implementation;
   std::unique_ptr<ModuleDef> modDef = std::make_unique<ModuleDefImpl>(fileName,line,column,moduleName,mt,partitionName);
   auto mod = p->moduleFileMap.add(fileName,std::move(modDef));
@@ -1214,6 +1216,7 @@ void ModuleManager::clear()
 void ModuleManager::addHeader(const QCString &moduleFile,int line,const QCString &headerName,bool isSystem)
 {
   AUTO_TRACE("{}:{} headerName={} isSystem={}",moduleFile,line,headerName,isSystem);
+  ShardModel::instance().recordModuleHeader(moduleFile,line,headerName,isSystem);
   auto mod = p->moduleFileMap.find(moduleFile);
   if (mod)
   {
@@ -1231,6 +1234,7 @@ void ModuleManager::addImport(const QCString &moduleFile,int line,const QCString
 {
   AUTO_TRACE("{}:{} importName={},isExported={},partitionName={}",
       moduleFile,line,importName,isExported,partitionName);
+  ShardModel::instance().recordModuleImport(moduleFile,line,importName,isExported,partitionName);
   auto mod = p->moduleFileMap.find(moduleFile);
   if (mod) // import inside a module
   {
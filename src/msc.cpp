@@ -25,6 +25,7 @@
 #include "mscgen_api.h"
 #include "dir.h"
 #include "textstream.h"
+#include "outputarchive.h"
 
 static const int maxCmdLine = 40960;
 
@@ -198,6 +199,7 @@ void writeMscGraphFromFile(const QCString &inFile,const QCString &outDir,
     }
   }
 
+  addDiskFileToOutputArchive(imgName);
   int i=std::max(imgName.findRev('/'),imgName.findRev('\\'));
   if (i!=-1) // strip path
   {
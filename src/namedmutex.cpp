@@ -0,0 +1,100 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+#include "namedmutex.h"
+#include "message.h"
+
+namespace
+{
+
+std::atomic<bool> g_enabled { false };
+
+/** All named mutexes, most of them have static storage duration */
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<LockStatistics*> locks;
+};
+
+Registry &registry()
+{
+  static Registry r;
+  return r;
+}
+
+} // namespace
+
+LockStatistics::LockStatistics(const char *name) : m_name(name)
+{
+  Registry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.locks.push_back(this);
+}
+
+LockStatistics::~LockStatistics()
+{
+  Registry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.locks.erase(std::remove(r.locks.begin(),r.locks.end(),this),r.locks.end());
+}
+
+void LockStatistics::enable()
+{
+  g_enabled = true;
+}
+
+bool LockStatistics::isEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void LockStatistics::printAll()
+{
+  struct Line
+  {
+    const char *name;
+    uint64_t acquisitions;
+    uint64_t contentions;
+    uint64_t waitTime;
+  };
+  std::vector<Line> lines;
+  {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto &l : r.locks)
+    {
+      uint64_t acquisitions = l->m_acquisitions.load();
+      if (acquisitions>0)
+      {
+        lines.push_back(Line{ l->m_name, acquisitions, l->m_contentions.load(), l->m_waitTime.load() });
+      }
+    }
+  }
+  std::stable_sort(lines.begin(),lines.end(),
+                   [](const auto &l1,const auto &l2) { return l1.waitTime>l2.waitTime; });
+  msg("----------------------\n");
+  msg("Lock statistics (ordered by total time spent waiting):\n");
+  for (const auto &l : lines)
+  {
+    msg("  %-50s acquired=%" PRIu64 " contended=%" PRIu64 " (%.1f%%) waited=%.3f ms\n",
+        l.name,l.acquisitions,l.contentions,
+        100.0*static_cast<double>(l.contentions)/static_cast<double>(l.acquisitions),
+        static_cast<double>(l.waitTime)/1000000.0);
+  }
+}
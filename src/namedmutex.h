@@ -0,0 +1,113 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef NAMEDMUTEX_H
+#define NAMEDMUTEX_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "construct.h"
+
+/** @brief Lock statistics of a named mutex.
+ *
+ *  When profiling is enabled (see the \c -d \c locks option) every acquisition of a
+ *  NamedMutex or NamedRecursiveMutex is counted, and for the acquisitions that had to
+ *  wait for another thread to release the lock, the time spent waiting is recorded.
+ *  printAll() reports the statistics of all named mutexes, ordered by total waiting
+ *  time, which shows the locks that prevent doxygen from scaling with NUM_PROC_THREADS.
+ */
+class LockStatistics
+{
+  public:
+    /** Registers a mutex called \a name, which must be a string literal of the
+     *  form "<file>:<variable>", e.g. "util.cpp:g_usedNamesMutex".
+     */
+    explicit LockStatistics(const char *name);
+   ~LockStatistics();
+    NON_COPYABLE(LockStatistics)
+
+    static void enable();
+    static bool isEnabled();
+    /** Prints the statistics of all named mutexes that were acquired at least once */
+    static void printAll();
+
+    const char *name() const { return m_name; }
+
+  protected:
+    void acquired()
+    {
+      m_acquisitions.fetch_add(1,std::memory_order_relaxed);
+    }
+    void contended(std::chrono::steady_clock::duration wait)
+    {
+      m_contentions.fetch_add(1,std::memory_order_relaxed);
+      m_waitTime.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()),std::memory_order_relaxed);
+    }
+
+  private:
+    const char           *m_name;
+    std::atomic<uint64_t> m_acquisitions { 0 };
+    std::atomic<uint64_t> m_contentions  { 0 };
+    std::atomic<uint64_t> m_waitTime     { 0 }; // in ns
+};
+
+/** @brief Mutex of type \a M that records its lock statistics, see LockStatistics.
+ *
+ *  Can be used as a drop-in replacement of \a M with std::lock_guard and std::unique_lock.
+ */
+template<class M>
+class InstrumentedMutex : public LockStatistics
+{
+  public:
+    explicit InstrumentedMutex(const char *name) : LockStatistics(name) {}
+
+    void lock()
+    {
+      if (!isEnabled())
+      {
+        m_mutex.lock();
+        return;
+      }
+      if (!m_mutex.try_lock())
+      {
+        auto start = std::chrono::steady_clock::now();
+        m_mutex.lock();
+        contended(std::chrono::steady_clock::now()-start);
+      }
+      acquired();
+    }
+    bool try_lock()
+    {
+      bool result = m_mutex.try_lock();
+      if (result && isEnabled()) acquired();
+      return result;
+    }
+    void unlock()
+    {
+      m_mutex.unlock();
+    }
+
+  private:
+    M m_mutex;
+};
+
+using NamedMutex          = InstrumentedMutex<std::mutex>;
+using NamedRecursiveMutex = InstrumentedMutex<std::recursive_mutex>;
+
+#endif
@@ -0,0 +1,118 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** @brief Per thread pool of reusable objects of type T, such as parsers.
+ *
+ *  An object is obtained with acquire() and is returned to the pool of the
+ *  current thread when the returned pointer goes out of scope, so the next request
+ *  for the same \a key in that thread reuses it instead of creating a new one.
+ *  The caller is responsible for resetting the state of a reused object.
+ *
+ *  Objects in use are never shared, so nested use (e.g. a parser that needs
+ *  another parser of the same kind) simply results in an additional object.
+ */
+template<class T>
+class ObjectPool
+{
+  public:
+    /** Deleter that returns the object to the pool instead of deleting it */
+    struct Releaser
+    {
+      std::string key;
+      void operator()(T *obj) const { ObjectPool<T>::release(key,obj); }
+    };
+    using Ptr     = std::unique_ptr<T,Releaser>;
+    using Factory = std::function<std::unique_ptr<T>()>;
+
+    /** Returns an object for \a key from the pool of the current thread, or a new
+     *  object created by \a factory if the pool is empty. The flag \a reused is set
+     *  to indicate which of the two happened.
+     */
+    static Ptr acquire(const std::string &key,const Factory &factory,bool &reused)
+    {
+      Pool &p = pool();
+      auto it = p.freeLists.find(key);
+      if (it!=p.freeLists.end() && !it->second.empty())
+      {
+        T *obj = it->second.back().release();
+        it->second.pop_back();
+        counters().reused++;
+        reused = true;
+        return Ptr(obj,Releaser{key});
+      }
+      counters().created++;
+      reused = false;
+      return Ptr(factory().release(),Releaser{key});
+    }
+
+    /** Returns the number of objects created so far by all threads */
+    static size_t created() { return counters().created; }
+    /** Returns the number of times an object was reused so far by all threads */
+    static size_t reused()  { return counters().reused;  }
+
+  private:
+    static constexpr size_t maxFreePerKey = 8;
+
+    struct Pool
+    {
+      std::unordered_map< std::string, std::vector< std::unique_ptr<T> > > freeLists;
+      Pool()  { alive() = true;  }
+     ~Pool()  { alive() = false; }
+    };
+    struct Counters
+    {
+      std::atomic<size_t> created { 0 };
+      std::atomic<size_t> reused  { 0 };
+    };
+
+    static Pool &pool()
+    {
+      static thread_local Pool p;
+      return p;
+    }
+    static bool &alive()
+    {
+      static thread_local bool a = false;
+      return a;
+    }
+    static Counters &counters()
+    {
+      static Counters c;
+      return c;
+    }
+    static void release(const std::string &key,T *obj)
+    {
+      if (obj==nullptr) return;
+      std::unique_ptr<T> ptr(obj);
+      if (!alive()) return; // thread is shutting down, just delete the object
+      auto &freeList = pool().freeLists[key];
+      if (freeList.size()<maxFreePerKey)
+      {
+        freeList.push_back(std::move(ptr));
+      }
+    }
+};
+
+#endif
@@ -0,0 +1,393 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "outputarchive.h"
+#include "config.h"
+#include "containers.h"
+#include "datetime.h"
+#include "dir.h"
+#include "fileinfo.h"
+#include "message.h"
+#include "portable.h"
+
+// zip format constants, see the PKWARE APPNOTE.TXT specification
+static const uint32_t ZIP_LOCAL_HEADER_SIG       = 0x04034b50;
+static const uint32_t ZIP_CENTRAL_HEADER_SIG     = 0x02014b50;
+static const uint32_t ZIP64_END_OF_DIR_SIG       = 0x06064b50;
+static const uint32_t ZIP64_END_OF_DIR_LOC_SIG   = 0x07064b50;
+static const uint32_t ZIP_END_OF_DIR_SIG         = 0x06054b50;
+static const uint16_t ZIP_VERSION_DEFAULT        = 20;
+static const uint16_t ZIP_VERSION_ZIP64          = 45;
+static const uint16_t ZIP_FLAG_UTF8              = 0x0800;
+static const uint16_t ZIP_METHOD_STORED          = 0;
+static const uint32_t ZIP_MAX32                  = 0xFFFFFFFF;
+static const uint16_t ZIP_MAX16                  = 0xFFFF;
+
+static uint32_t crc32(const char *data,size_t len)
+{
+  static const std::array<uint32_t,256> table = []()
+  {
+    std::array<uint32_t,256> t;
+    for (uint32_t i=0;i<256;i++)
+    {
+      uint32_t c=i;
+      for (int k=0;k<8;k++)
+      {
+        c = (c&1) ? 0xEDB88320 ^ (c>>1) : c>>1;
+      }
+      t[i]=c;
+    }
+    return t;
+  }();
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i=0;i<len;i++)
+  {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc>>8);
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+static void put16(std::string &s,uint16_t v)
+{
+  s+=static_cast<char>(v&0xFF);
+  s+=static_cast<char>((v>>8)&0xFF);
+}
+
+static void put32(std::string &s,uint32_t v)
+{
+  put16(s,static_cast<uint16_t>(v&0xFFFF));
+  put16(s,static_cast<uint16_t>(v>>16));
+}
+
+static void put64(std::string &s,uint64_t v)
+{
+  put32(s,static_cast<uint32_t>(v&0xFFFFFFFF));
+  put32(s,static_cast<uint32_t>(v>>32));
+}
+
+struct ArchiveEntry
+{
+  std::string name;
+  uint32_t crc;
+  uint32_t size;
+  uint64_t offset;
+  bool     replaced;
+};
+
+struct OutputArchive::Private
+{
+  QCString dir;
+  QCString archiveName;
+  std::ofstream file;
+  uint64_t offset = 0;
+  uint16_t dosTime = 0;
+  uint16_t dosDate = 0;
+  std::vector<ArchiveEntry> entries;
+  std::unordered_map<std::string,size_t> entryIndex;
+  /** files written to disk, mapped to TRUE if they are kept on disk after archiving */
+  std::unordered_map<std::string,bool> diskFiles;
+  std::mutex mutex;
+  bool closed = false;
+
+  /** Appends an entry with name \a name to the archive, must be called with the mutex locked */
+  bool addEntry(const std::string &name,const char *data,size_t size)
+  {
+    if (closed || !file.is_open()) return false;
+    if (size>=ZIP_MAX32)
+    {
+      err("File %s is too large to be stored in archive %s\n",name.c_str(),qPrint(archiveName));
+      return false;
+    }
+    uint32_t crc = crc32(data,size);
+    std::string hdr;
+    put32(hdr,ZIP_LOCAL_HEADER_SIG);
+    put16(hdr,ZIP_VERSION_DEFAULT);
+    put16(hdr,ZIP_FLAG_UTF8);
+    put16(hdr,ZIP_METHOD_STORED);
+    put16(hdr,dosTime);
+    put16(hdr,dosDate);
+    put32(hdr,crc);
+    put32(hdr,static_cast<uint32_t>(size)); // compressed size
+    put32(hdr,static_cast<uint32_t>(size)); // uncompressed size
+    put16(hdr,static_cast<uint16_t>(name.length()));
+    put16(hdr,0); // extra field length
+    hdr+=name;
+    file.write(hdr.data(),static_cast<std::streamsize>(hdr.size()));
+    file.write(data,static_cast<std::streamsize>(size));
+    if (file.fail())
+    {
+      err("Failed to write to archive %s\n",qPrint(archiveName));
+      return false;
+    }
+
+    auto it = entryIndex.find(name);
+    if (it!=entryIndex.end()) // newer version of an existing file, the old entry is dropped
+    {
+      entries[it->second].replaced = true;
+      it->second = entries.size();
+    }
+    else
+    {
+      entryIndex.emplace(name,entries.size());
+    }
+    entries.push_back({name,crc,static_cast<uint32_t>(size),offset,false});
+    offset += hdr.size()+size;
+    return true;
+  }
+
+  static bool isBookkeepingFile(const FileInfo &fi)
+  {
+    // signatures, image maps and sources from which dot and plantuml images are reused
+    std::string ext = fi.extension(false);
+    return ext=="md5" || ext=="map" || ext=="dot" || ext=="pu" || fi.fileName()=="formula.repository";
+  }
+
+  /** Adds the registered files that were not added to the archive yet. The files
+   *  that are not kept on disk are stored in \a addedFiles.
+   */
+  void addDiskFiles(StringVector &addedFiles)
+  {
+    // sort the files, so the order of the entries does not depend on the order
+    // in which threads registered them
+    std::vector<std::pair<std::string,bool>> files(diskFiles.begin(),diskFiles.end());
+    std::sort(files.begin(),files.end());
+    for (const auto &[path,keepOnDisk] : files)
+    {
+      FileInfo fi(path);
+      std::string name = path.substr(dir.length()+1);
+      if (!fi.isFile() || isBookkeepingFile(fi) || entryIndex.find(name)!=entryIndex.end())
+      {
+        continue; // removed again, not part of the output, or added already
+      }
+      std::ifstream f = Portable::openInputStream(QCString(path),true);
+      if (!f.is_open())
+      {
+        err("Could not read file %s for adding it to archive %s\n",path.c_str(),qPrint(archiveName));
+        continue;
+      }
+      std::string contents(fi.size(),'\0');
+      f.read(&contents[0],static_cast<std::streamsize>(contents.size()));
+      if (addEntry(name,contents.data(),static_cast<size_t>(f.gcount())) && !keepOnDisk)
+      {
+        addedFiles.push_back(path);
+      }
+    }
+  }
+
+  void writeCentralDirectory()
+  {
+    std::string cd;
+    uint64_t numEntries = 0;
+    bool needZip64 = offset>=ZIP_MAX32;
+    for (const auto &e : entries)
+    {
+      if (e.replaced) continue;
+      bool zip64 = e.offset>=ZIP_MAX32;
+      put32(cd,ZIP_CENTRAL_HEADER_SIG);
+      put16(cd,(3<<8) | ZIP_VERSION_ZIP64); // made by: unix
+      put16(cd,zip64 ? ZIP_VERSION_ZIP64 : ZIP_VERSION_DEFAULT);
+      put16(cd,ZIP_FLAG_UTF8);
+      put16(cd,ZIP_METHOD_STORED);
+      put16(cd,dosTime);
+      put16(cd,dosDate);
+      put32(cd,e.crc);
+      put32(cd,e.size);
+      put32(cd,e.size);
+      put16(cd,static_cast<uint16_t>(e.name.length()));
+      put16(cd,zip64 ? 12 : 0); // extra field length
+      put16(cd,0); // comment length
+      put16(cd,0); // disk number
+      put16(cd,0); // internal attributes
+      put32(cd,0100644u<<16); // external attributes: regular file, rw-r--r--
+      put32(cd,zip64 ? ZIP_MAX32 : static_cast<uint32_t>(e.offset));
+      cd+=e.name;
+      if (zip64)
+      {
+        put16(cd,0x0001); // zip64 extended information
+        put16(cd,8);
+        put64(cd,e.offset);
+      }
+      numEntries++;
+    }
+    uint64_t cdOffset = offset;
+    uint64_t cdSize   = cd.size();
+    needZip64 = needZip64 || numEntries>=ZIP_MAX16 || cdSize>=ZIP_MAX32 || cdOffset+cdSize>=ZIP_MAX32;
+    if (needZip64)
+    {
+      uint64_t endOfDirOffset = cdOffset+cdSize;
+      put32(cd,ZIP64_END_OF_DIR_SIG);
+      put64(cd,44); // size of the remaining record
+      put16(cd,(3<<8) | ZIP_VERSION_ZIP64);
+      put16(cd,ZIP_VERSION_ZIP64);
+      put32(cd,0); // this disk
+      put32(cd,0); // disk with the central directory
+      put64(cd,numEntries);
+      put64(cd,numEntries);
+      put64(cd,cdSize);
+      put64(cd,cdOffset);
+      put32(cd,ZIP64_END_OF_DIR_LOC_SIG);
+      put32(cd,0); // disk with the zip64 end of central directory
+      put64(cd,endOfDirOffset);
+      put32(cd,1); // total number of disks
+    }
+    put32(cd,ZIP_END_OF_DIR_SIG);
+    put16(cd,0); // this disk
+    put16(cd,0); // disk with the central directory
+    put16(cd,needZip64 ? ZIP_MAX16 : static_cast<uint16_t>(numEntries));
+    put16(cd,needZip64 ? ZIP_MAX16 : static_cast<uint16_t>(numEntries));
+    put32(cd,needZip64 ? ZIP_MAX32 : static_cast<uint32_t>(cdSize));
+    put32(cd,needZip64 ? ZIP_MAX32 : static_cast<uint32_t>(cdOffset));
+    put16(cd,0); // comment length
+    file.write(cd.data(),static_cast<std::streamsize>(cd.size()));
+  }
+};
+
+OutputArchive::OutputArchive(const QCString &dir) : p(std::make_unique<Private>())
+{
+  p->dir = dir;
+  p->archiveName = dir+".zip";
+  p->file = Portable::openOutputStream(p->archiveName);
+  if (!p->file.is_open())
+  {
+    term("Could not open archive %s for writing\n",qPrint(p->archiveName));
+  }
+  // use the same time stamp for all entries, so the output is reproducible
+  // when SOURCE_DATE_EPOCH is set.
+  std::tm dt = getCurrentDateTime();
+  int year = std::max(dt.tm_year+1900,1980);
+  p->dosTime = static_cast<uint16_t>((dt.tm_hour<<11) | (dt.tm_min<<5) | (dt.tm_sec/2));
+  p->dosDate = static_cast<uint16_t>(((year-1980)<<9) | ((dt.tm_mon+1)<<5) | dt.tm_mday);
+}
+
+OutputArchive::~OutputArchive()
+{
+  close();
+}
+
+QCString OutputArchive::dir() const
+{
+  return p->dir;
+}
+
+QCString OutputArchive::archiveName() const
+{
+  return p->archiveName;
+}
+
+bool OutputArchive::addFile(const QCString &fileName,const std::string &contents)
+{
+  std::string name = fileName.mid(p->dir.length()+1).str();
+  std::lock_guard<std::mutex> lock(p->mutex);
+  return p->addEntry(name,contents.data(),contents.size());
+}
+
+void OutputArchive::addDiskFile(const QCString &fileName,bool keepOnDisk)
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  auto it = p->diskFiles.find(fileName.str());
+  if (it==p->diskFiles.end())
+  {
+    p->diskFiles.emplace(fileName.str(),keepOnDisk);
+  }
+  else if (keepOnDisk) // a file that is reused by later runs is never removed
+  {
+    it->second = true;
+  }
+}
+
+size_t OutputArchive::close()
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  if (p->closed) return 0;
+  StringVector addedFiles;
+  p->addDiskFiles(addedFiles);
+  p->writeCentralDirectory();
+  p->file.close();
+  p->closed = true;
+  // the archive now holds the only copy of these files
+  Dir d;
+  for (const auto &fn : addedFiles)
+  {
+    d.remove(fn);
+  }
+  return p->entryIndex.size();
+}
+
+//--------------------------------------------------------------------
+
+static std::vector< std::unique_ptr<OutputArchive> > g_outputArchives;
+
+// files that generators open for writing with Portable::openOutputStream()
+static void registerOutputStream(const QCString &fileName)
+{
+  addDiskFileToOutputArchive(fileName);
+}
+
+void initOutputArchives()
+{
+  if (Config_getBool(GENERATE_HTML) && Config_getBool(HTML_ARCHIVE))
+  {
+    g_outputArchives.push_back(std::make_unique<OutputArchive>(Config_getString(HTML_OUTPUT)));
+  }
+  if (Config_getBool(GENERATE_XML) && Config_getBool(XML_ARCHIVE))
+  {
+    g_outputArchives.push_back(std::make_unique<OutputArchive>(Config_getString(XML_OUTPUT)));
+  }
+  if (!g_outputArchives.empty())
+  {
+    Portable::setOutputStreamObserver(registerOutputStream);
+  }
+}
+
+void finalizeOutputArchives()
+{
+  Portable::setOutputStreamObserver(nullptr);
+  for (const auto &archive : g_outputArchives)
+  {
+    size_t numEntries = archive->close();
+    msg("Stored %zu files in archive %s\n",numEntries,qPrint(archive->archiveName()));
+  }
+  g_outputArchives.clear();
+}
+
+OutputArchive *outputArchiveForFile(const QCString &fileName)
+{
+  for (const auto &archive : g_outputArchives)
+  {
+    const QCString &dir = archive->dir();
+    if (fileName.length()>dir.length() && fileName.startsWith(dir) && fileName.at(dir.length())=='/')
+    {
+      return archive.get();
+    }
+  }
+  return nullptr;
+}
+
+void addDiskFileToOutputArchive(const QCString &fileName,bool keepOnDisk)
+{
+  OutputArchive *archive = outputArchiveForFile(fileName);
+  if (archive)
+  {
+    archive->addDiskFile(fileName,keepOnDisk);
+  }
+}
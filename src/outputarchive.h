@@ -0,0 +1,82 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef OUTPUTARCHIVE_H
+#define OUTPUTARCHIVE_H
+
+#include <memory>
+#include <string>
+
+#include "qcstring.h"
+#include "construct.h"
+
+/** @brief Zip archive that collects the files of an output directory.
+ *
+ *  Instead of creating a file for each page, the generated files are appended
+ *  to a single zip archive named after the output directory (e.g. `html.zip`).
+ *  The entries are stored without compression, so a web server can serve an
+ *  entry directly from its offset in the archive. Archives with more than 65535
+ *  entries or larger than 4GB use the zip64 extensions.
+ */
+class OutputArchive
+{
+  public:
+    /** Creates the archive for output directory \a dir */
+    explicit OutputArchive(const QCString &dir);
+   ~OutputArchive();
+    NON_COPYABLE(OutputArchive)
+
+    /** Returns the output directory collected by this archive */
+    QCString dir() const;
+    /** Returns the file name of the archive */
+    QCString archiveName() const;
+    /** Adds the file \a fileName, which must be located in the output directory,
+     *  with contents \a contents. If the file was already added, the new contents
+     *  replace the old ones. This method is thread safe.
+     */
+    bool addFile(const QCString &fileName,const std::string &contents);
+    /** Registers the file \a fileName that is written to disk instead of being passed
+     *  to addFile(), for instance an image produced by an external tool. The file is
+     *  added to the archive when the archive is closed. Unless \a keepOnDisk is TRUE
+     *  it is removed from the output directory afterwards; files that later runs
+     *  reuse, like dot images next to their \c .md5 signature, are kept.
+     *  This method is thread safe.
+     */
+    void addDiskFile(const QCString &fileName,bool keepOnDisk=false);
+    /** Adds the files registered with addDiskFile() that were not added yet, removes
+     *  the ones that are not kept from the output directory and writes the central
+     *  directory of the archive. Returns the number of entries.
+     */
+    size_t close();
+
+  private:
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+/** Opens an archive for each output directory for which archiving is enabled */
+void initOutputArchives();
+/** Completes and closes all archives opened by initOutputArchives() */
+void finalizeOutputArchives();
+/** Returns the archive collecting the output file \a fileName, or nullptr if the
+ *  file should be written to disk.
+ */
+OutputArchive *outputArchiveForFile(const QCString &fileName);
+/** Registers the file \a fileName written to disk with the archive collecting it,
+ *  if any. \sa OutputArchive::addDiskFile()
+ */
+void addDiskFileToOutputArchive(const QCString &fileName,bool keepOnDisk=false);
+
+#endif
@@ -23,6 +23,8 @@
 #include "outputgen.h"
 #include "message.h"
 #include "portable.h"
+#include "config.h"
+#include "util.h"
 
 OutputGenerator::OutputGenerator(const QCString &dir) : m_t(nullptr), m_dir(dir)
 {
@@ -33,6 +35,14 @@ void OutputGenerator::startPlainFile(const QCString &name)
 {
   //printf("startPlainFile(%s)\n",qPrint(name));
   m_fileName=m_dir+"/"+name;
+  if (bufferOutputFile(m_fileName))
+  {
+    // collect the output in memory, so it can be compared with the existing file
+    // or added to the output archive
+    m_contents.str(std::string());
+    m_t.setStream(&m_contents);
+    return;
+  }
   m_file = Portable::fopen(m_fileName.data(),"wb");
   if (m_file==nullptr)
   {
@@ -45,7 +55,16 @@ void OutputGenerator::endPlainFile()
 {
   m_t.flush();
   m_t.setStream(nullptr);
-  Portable::fclose(m_file);
+  if (m_file)
+  {
+    Portable::fclose(m_file);
+    m_file = nullptr;
+  }
+  else if (!writeFileContents(m_fileName,m_contents.str()))
+  {
+    term("Could not open file %s for writing\n",qPrint(m_fileName));
+  }
+  m_contents.str(std::string());
   m_fileName.clear();
 }
 
@@ -20,6 +20,7 @@
 #include <stack>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "types.h"
 #include "index.h"
@@ -114,6 +115,7 @@ class OutputGenerator
   private:
     QCString m_fileName;
     FILE *m_file = nullptr;
+    std::ostringstream m_contents; // used instead of m_file when bufferOutputFile() is true
 };
 
 
@@ -131,7 +131,7 @@ class OutputCodeRecorder : public OutputCodeIntf
     void replay(OutputCodeList &ol,int startLine,int endLine,bool showLineNumbers);
   private:
     void startNewLine(int lineNr);
-    struct CallInfo
+    struct CallInfo : public MemoryCounted<MemoryCategory::CodeRecorder,CallInfo>
     {
       using ConditionFunc = std::function<bool()>;
       using OutputFunc    = std::function<void(OutputCodeList*)>;
@@ -218,6 +218,18 @@ class OutputCodeList
       m_outputCodeList.clear();
     }
 
+    /** Returns true if the output of all enabled generators is discarded,
+     *  i.e. the code is only parsed to collect cross-references.
+     */
+    bool discardsOutput() const
+    {
+      for (const auto &e : m_outputCodeList)
+      {
+        if (e.enabled && e.intf->type()!=OutputType::Null) return false;
+      }
+      return true;
+    }
+
     // ---- OutputCodeIntf forwarding
 
     void codify(const QCString &s)
@@ -24,6 +24,7 @@
 #include "types.h"
 #include "containers.h"
 #include "construct.h"
+#include "objectpool.h"
 
 class Entry;
 class FileDef;
@@ -136,6 +137,9 @@ class CodeParserInterface
 using OutlineParserFactory = std::function<std::unique_ptr<OutlineParserInterface>()>;
 using CodeParserFactory    = std::function<std::unique_ptr<CodeParserInterface>()>;
 
+using OutlineParserPtr     = ObjectPool<OutlineParserInterface>::Ptr;
+using CodeParserPtr        = ObjectPool<CodeParserInterface>::Ptr;
+
 /** \brief Manages programming language parsers.
  *
  *  This class manages the language parsers in the system. One can
@@ -203,20 +207,29 @@ class ParserManager
     /** Gets the interface to the parser associated with a given \a extension.
      *  If there is no parser explicitly registered for the supplied extension,
      *  the interface to the default parser will be returned.
+     *  Parsers are taken from a per thread pool and returned to it when the
+     *  pointer goes out of scope.
      */
-    std::unique_ptr<OutlineParserInterface> getOutlineParser(const QCString &extension)
+    OutlineParserPtr getOutlineParser(const QCString &extension)
     {
-      return getParsers(extension).outlineParserFactory();
+      const ParserPair &pair = getParsers(extension);
+      bool reused = false;
+      return ObjectPool<OutlineParserInterface>::acquire(pair.parserName.str(),pair.outlineParserFactory,reused);
     }
 
     /** Gets the interface to the parser associated with a given \a extension.
      *  If there is no parser explicitly registered for the supplied extension,
      *  the interface to the default parser will be returned.
+     *  Parsers are taken from a per thread pool and returned to it when the
+     *  pointer goes out of scope. A reused parser is reset before it is returned.
      */
-    std::unique_ptr<CodeParserInterface> getCodeParser(const QCString &extension)
+    CodeParserPtr getCodeParser(const QCString &extension)
     {
-      auto factory = getCodeParserFactory(extension);
-      return factory();
+      const ParserPair &pair = getParsers(extension);
+      bool reused = false;
+      auto intf = ObjectPool<CodeParserInterface>::acquire(pair.parserName.str(),pair.codeParserFactory,reused);
+      if (reused) intf->resetCodeParserState();
+      return intf;
     }
 
     /** Get the factory for create code parser objects with a given \a extension. */
@@ -23,6 +23,7 @@
 #include "fileinfo.h"
 #include "dir.h"
 #include "indexlist.h"
+#include "outputarchive.h"
 
 QCString PlantumlManager::writePlantUMLSource(const QCString &outDirArg,const QCString &fileName,
                                               const QCString &content,OutputFormat format, const QCString &engine,
@@ -146,6 +147,8 @@ void PlantumlManager::generatePlantUMLOutput(const QCString &baseName,const QCSt
       break;
   }
 
+  // the image is reused by later runs as long as the .pu file is unchanged
+  addDiskFileToOutputArchive(baseName+imgName.mid(imgName.findRev('.')),true);
   Doxygen::indexList->addImageFile(imgName);
 }
 
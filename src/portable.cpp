@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <mutex>
@@ -12,10 +13,15 @@
 #undef UNICODE
 #define _WIN32_DCOM
 #include <windows.h>
+#include <psapi.h>
 #else
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
 #include <errno.h>
 extern char **environ;
 #endif
@@ -30,6 +36,7 @@ extern char **environ;
 
 #include "util.h"
 #include "dir.h"
+#include "timeline.h"
 #ifndef NODEBUG
 #include "debug.h"
 #endif
@@ -100,6 +107,48 @@ double Portable::getSysElapsedTime()
   return SysTimeKeeper::instance().elapsedTime();
 }
 
+/** Returns the current resident set size and its high-water mark of this process in bytes.
+ *  Returns FALSE if this is not supported. If only the high-water mark is known
+ *  \a rss is set to 0.
+ */
+bool Portable::getMemoryUsage(uint64_t &rss,uint64_t &peakRss)
+{
+  rss=0;
+  peakRss=0;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(),&pmc,sizeof(pmc)))
+  {
+    rss     = static_cast<uint64_t>(pmc.WorkingSetSize);
+    peakRss = static_cast<uint64_t>(pmc.PeakWorkingSetSize);
+    return true;
+  }
+  return false;
+#elif defined(__linux__)
+  // the values in /proc/self/status are in kB
+  FILE *f = ::fopen("/proc/self/status","r");
+  if (f==nullptr) return false;
+  char line[256];
+  while (fgets(line,sizeof(line),f))
+  {
+    unsigned long long value=0;
+    if      (sscanf(line,"VmRSS: %llu",&value)==1) rss     = value*1024;
+    else if (sscanf(line,"VmHWM: %llu",&value)==1) peakRss = value*1024;
+  }
+  ::fclose(f);
+  return peakRss>0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF,&usage)!=0) return false;
+#if defined(__APPLE__)
+  peakRss = static_cast<uint64_t>(usage.ru_maxrss);       // in bytes
+#else
+  peakRss = static_cast<uint64_t>(usage.ru_maxrss)*1024;  // in kB
+#endif
+  return true;
+#endif
+}
+
 //---------------------------------------------------------------------------------------------------------
 
 
@@ -107,6 +156,7 @@ int Portable::system(const QCString &command,const QCString &args,bool commandHa
 {
   if (command.isEmpty()) return 1;
   AutoTimeKeeper timeKeeper;
+  Timeline::Scope timelineScope("tool",command,args);
 
 #if defined(_WIN32) && !defined(__CYGWIN__)
   QCString commandCorrectedPath = substitute(command,'/','\\');
@@ -627,6 +677,175 @@ size_t Portable::recodeUtf8StringToW(const QCString &inputStr,uint16_t **outBuf)
   return len;
 }
 
+/** Maps the contents of file \a fileName read-only into memory.
+ *  Returns a pointer to the contents and sets \a size, or returns nullptr
+ *  if the file could not be mapped or is empty.
+ */
+const char *Portable::mapFile(const QCString &fileName,size_t &size)
+{
+  size = 0;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  uint16_t *fn = nullptr;
+  size_t fnLen = recodeUtf8StringToW(fileName,&fn);
+  HANDLE file = INVALID_HANDLE_VALUE;
+  if (fnLen!=(size_t)-1)
+  {
+    file = CreateFileW((wchar_t*)fn,GENERIC_READ,FILE_SHARE_READ,
+                       nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+  }
+  delete[] fn;
+  if (file==INVALID_HANDLE_VALUE) return nullptr;
+  LARGE_INTEGER fileSize;
+  const char *data = nullptr;
+  if (GetFileSizeEx(file,&fileSize) && fileSize.QuadPart>0)
+  {
+    HANDLE mapping = CreateFileMapping(file,nullptr,PAGE_READONLY,0,0,nullptr);
+    if (mapping)
+    {
+      data = static_cast<const char *>(MapViewOfFile(mapping,FILE_MAP_READ,0,0,0));
+      if (data) size = static_cast<size_t>(fileSize.QuadPart);
+      CloseHandle(mapping); // the view keeps the mapping alive
+    }
+  }
+  CloseHandle(file);
+  return data;
+#else
+  int fd = ::open(fileName.data(),O_RDONLY);
+  if (fd==-1) return nullptr;
+  struct stat st;
+  const char *data = nullptr;
+  if (fstat(fd,&st)==0 && S_ISREG(st.st_mode) && st.st_size>0)
+  {
+    void *p = mmap(nullptr,static_cast<size_t>(st.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+    if (p!=MAP_FAILED)
+    {
+      data = static_cast<const char *>(p);
+      size = static_cast<size_t>(st.st_size);
+    }
+  }
+  ::close(fd); // the mapping stays valid after closing the file
+  return data;
+#endif
+}
+
+/** Releases a mapping returned by mapFile() */
+void Portable::unmapFile(const char *data,size_t size)
+{
+  if (data==nullptr) return;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  (void)size;
+  UnmapViewOfFile(data);
+#else
+  munmap(const_cast<char *>(data),size);
+#endif
+}
+
+/** Creates file \a fileName if needed, extends it to at least \a offset + \a size bytes and
+ *  maps the \a size bytes at \a offset into memory for reading and writing. Changes to the
+ *  mapped memory are written to the file. The \a offset must be a multiple of 64KB.
+ *  Returns a pointer to the contents, or nullptr if the file could not be mapped.
+ *  Use unmapFile() to release the mapping.
+ */
+#if !defined(_WIN32) || defined(__CYGWIN__)
+// Allocates the disk blocks for size bytes at offset in the file fd, so writing to a
+// shared mapping of that range cannot fail with SIGBUS when the disk is full.
+static bool allocateFileSpace(int fd,off_t offset,off_t size,off_t fileSize)
+{
+#if defined(__APPLE__)
+  off_t end = offset+size;
+  if (fileSize<end)
+  {
+    fstore_t store = { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, end-fileSize, 0 };
+    if (fcntl(fd,F_PREALLOCATE,&store)==-1)
+    {
+      store.fst_flags = F_ALLOCATEALL; // no contiguous room, try fragmented
+      if (fcntl(fd,F_PREALLOCATE,&store)==-1) return false;
+    }
+  }
+  return fileSize>=end || ftruncate(fd,end)==0;
+#else
+  (void)fileSize;
+  int rc = 0;
+  while ((rc=posix_fallocate(fd,offset,size))==EINTR) {}
+  if (rc==0) return true;
+  if (rc!=EINVAL && rc!=EOPNOTSUPP) return false; // e.g. ENOSPC
+  // the file system does not support preallocation, write zeros instead
+  static const char zeros[65536] = {};
+  while (size>0)
+  {
+    ssize_t n = pwrite(fd,zeros,static_cast<size_t>(std::min<off_t>(size,sizeof(zeros))),offset);
+    if (n<0 && errno==EINTR) continue;
+    if (n<=0) return false;
+    offset+=n;
+    size-=n;
+  }
+  return true;
+#endif
+}
+
+static bool reserveFileSpace(int fd,off_t offset,off_t size)
+{
+  struct stat st;
+  if (fstat(fd,&st)!=0) return false;
+  if (allocateFileSpace(fd,offset,size,st.st_size)) return true;
+  // a failed allocation can leave part of the range allocated, give it back
+  if (st.st_size<offset+size && ftruncate(fd,st.st_size)!=0)
+  {
+    // the space is released when the file is removed
+  }
+  return false;
+}
+#endif
+
+char *Portable::mapWritableFile(const QCString &fileName,uint64_t offset,size_t size)
+{
+  if (size==0) return nullptr;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  uint16_t *fn = nullptr;
+  size_t fnLen = recodeUtf8StringToW(fileName,&fn);
+  HANDLE file = INVALID_HANDLE_VALUE;
+  if (fnLen!=(size_t)-1)
+  {
+    file = CreateFileW((wchar_t*)fn,GENERIC_READ|GENERIC_WRITE,FILE_SHARE_READ,
+                       nullptr,OPEN_ALWAYS,FILE_ATTRIBUTE_TEMPORARY,nullptr);
+  }
+  delete[] fn;
+  if (file==INVALID_HANDLE_VALUE) return nullptr;
+  char *data = nullptr;
+  LARGE_INTEGER fileSize;
+  LARGE_INTEGER end;
+  end.QuadPart = static_cast<LONGLONG>(offset+static_cast<uint64_t>(size));
+  // grow the file first (it is not sparse, so this allocates the clusters and fails
+  // when the disk is full); never shrink it
+  bool reserved = GetFileSizeEx(file,&fileSize) &&
+                  (fileSize.QuadPart>=end.QuadPart ||
+                   (SetFilePointerEx(file,end,nullptr,FILE_BEGIN) && SetEndOfFile(file)));
+  HANDLE mapping = reserved ? CreateFileMapping(file,nullptr,PAGE_READWRITE,0,0,nullptr) : nullptr;
+  if (mapping)
+  {
+    data = static_cast<char *>(MapViewOfFile(mapping,FILE_MAP_WRITE,
+                                             static_cast<DWORD>(offset>>32),static_cast<DWORD>(offset&0xffffffff),size));
+    CloseHandle(mapping); // the view keeps the mapping alive
+  }
+  CloseHandle(file);
+  return data;
+#else
+  int fd = ::open(fileName.data(),O_RDWR|O_CREAT,0600);
+  if (fd==-1) return nullptr;
+  char *data = nullptr;
+  if (reserveFileSpace(fd,static_cast<off_t>(offset),static_cast<off_t>(size)))
+  {
+    void *p = mmap(nullptr,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,static_cast<off_t>(offset));
+    if (p!=MAP_FAILED)
+    {
+      data = static_cast<char *>(p);
+    }
+  }
+  ::close(fd); // the mapping stays valid after closing the file
+  return data;
+#endif
+}
+
 //----------------------------------------------------------------------------------------
 // We need to do this part last as including filesystem.hpp earlier
 // causes the code above to fail to compile on Windows.
@@ -635,10 +854,19 @@ size_t Portable::recodeUtf8StringToW(const QCString &inputStr,uint16_t **outBuf)
 
 namespace fs = ghc::filesystem;
 
+// set before the output is generated, so it is not changed while other threads read it
+static void (*g_outputStreamObserver)(const QCString &) = nullptr;
+
+void Portable::setOutputStreamObserver(void (*observer)(const QCString &fileName))
+{
+  g_outputStreamObserver = observer;
+}
+
 std::ofstream Portable::openOutputStream(const QCString &fileName,bool append)
 {
   std::ios_base::openmode mode = std::ofstream::out | std::ofstream::binary;
   if (append) mode |= std::ofstream::app;
+  if (g_outputStreamObserver) g_outputStreamObserver(fileName);
 #if defined(__clang__) && defined(__MINGW32__)
   return std::ofstream(fs::path(fileName.str()).wstring(), mode);
 #else
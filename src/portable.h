@@ -33,6 +33,7 @@ namespace Portable
   FILE *         popen(const QCString &name,const QCString &type);
   int            pclose(FILE *stream);
   double         getSysElapsedTime();
+  bool           getMemoryUsage(uint64_t &rss,uint64_t &peakRss);
   bool           isAbsolutePath(const QCString &fileName);
   void           correct_path();
   void           setShortDir();
@@ -41,7 +42,11 @@ namespace Portable
   bool           checkForExecutable(const QCString &fileName);
   size_t         recodeUtf8StringToW(const QCString &inputStr,uint16_t **buf);
   std::ofstream  openOutputStream(const QCString &name,bool append=false);
+  void           setOutputStreamObserver(void (*observer)(const QCString &fileName));
   std::ifstream  openInputStream(const QCString &name,bool binary=false,bool openAtEnd=false);
+  const char *   mapFile(const QCString &fileName,size_t &size);
+  void           unmapFile(const char *data,size_t size);
+  char *         mapWritableFile(const QCString &fileName,uint64_t offset,size_t size);
 }
 
 
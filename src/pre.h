@@ -18,8 +18,10 @@
 #ifndef PRE_H
 #define PRE_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include "construct.h"
 
 class QCString;
@@ -31,8 +33,13 @@ class Preprocessor
    ~Preprocessor();
     NON_COPYABLE(Preprocessor)
 
-    void processFile(const QCString &fileName,const std::string &input,std::string &output);
+    void processFile(const QCString &fileName,std::string_view input,std::string &output);
     void addSearchDir(const QCString &dir);
+
+    /** Returns the number of function-like macro expansions taken from the memo table */
+    static uint64_t macroMemoHits();
+    /** Returns the number of function-like macro expansions that had to be computed */
+    static uint64_t macroMemoMisses();
  private:
    struct Private;
    std::unique_ptr<Private> p;
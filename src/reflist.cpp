@@ -20,6 +20,7 @@
 #include "util.h"
 #include "definition.h"
 #include "config.h"
+#include "shardmodel.h"
 
 RefList::RefList(const QCString &listName, const QCString &pageTitle, const QCString &secTitle) :
        m_listName(listName), m_fileName(convertNameToFile(listName,FALSE,TRUE)),
@@ -34,6 +35,7 @@ RefItem *RefList::add()
   RefItem *result = item.get();
   m_entries.push_back(std::move(item));
   m_lookup.insert({m_id,result});
+  ShardModel::instance().recordRefItem(result);
   return result;
 }
 
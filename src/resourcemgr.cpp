@@ -85,6 +85,15 @@ bool ResourceMgr::copyResourceAs(const QCString &name,const QCString &targetDir,
     switch (res->type)
     {
       case Resource::Verbatim:
+        if (!append)
+        {
+          std::string contents(reinterpret_cast<const char *>(res->data),res->size);
+          if (writeFileContents(pathName,contents))
+          {
+            return TRUE;
+          }
+        }
+        else
         {
           std::ofstream f = Portable::openOutputStream(pathName,append);
           bool ok=false;
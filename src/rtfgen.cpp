@@ -49,6 +49,7 @@
 #include "datetime.h"
 #include "outputlist.h"
 #include "moduledef.h"
+#include "namedmutex.h"
 
 //#define DBG_RTF(x) x;
 #define DBG_RTF(x)
@@ -2803,13 +2804,13 @@ void RTFGenerator::endParameterExtra(bool last,bool /* emptyList */, bool closeB
 
 //----------------------------------------------------------------------
 
-static std::mutex g_rtfFormatMutex;
+static NamedMutex g_rtfFormatMutex("rtfgen.cpp:g_rtfFormatMutex");
 static std::unordered_map<std::string,std::string> g_tagMap;
 static QCString g_nextTag( "AAAAAAAAAA" );
 
 QCString rtfFormatBmkStr(const QCString &name)
 {
-  std::lock_guard<std::mutex> lock(g_rtfFormatMutex);
+  std::lock_guard<NamedMutex> lock(g_rtfFormatMutex);
 
   // To overcome the 40-character tag limitation, we
   // substitute a short arbitrary string for the name
@@ -32,6 +32,7 @@
 #include "groupdef.h"
 #include "filedef.h"
 #include "portable.h"
+#include "namedmutex.h"
 
 
 // file format: (all multi-byte values are stored in big endian format)
@@ -47,7 +48,7 @@
 
 const size_t numIndexEntries = 256*256;
 
-static std::mutex g_searchIndexMutex;
+static NamedMutex g_searchIndexMutex("searchindex.cpp:g_searchIndexMutex");
 
 //--------------------------------------------------------------------
 
@@ -74,7 +75,7 @@ SearchIndex::SearchIndex()
 void SearchIndex::setCurrentDoc(const Definition *ctx,const QCString &anchor,bool isSourceFile)
 {
   if (ctx==nullptr) return;
-  std::lock_guard<std::mutex> lock(g_searchIndexMutex);
+  std::lock_guard<NamedMutex> lock(g_searchIndexMutex);
   assert(!isSourceFile || ctx->definitionType()==Definition::TypeFile);
   //printf("SearchIndex::setCurrentDoc(%s,%s,%s)\n",name,baseName,anchor);
   QCString url=isSourceFile ? (toFileDef(ctx))->getSourceFileBase() : ctx->getOutputFileBase();
@@ -235,7 +236,7 @@ void SearchIndex::addWordRec(const QCString &word,bool hiPriority,bool recurse)
 
 void SearchIndex::addWord(const QCString &word,bool hiPriority)
 {
-  std::lock_guard<std::mutex> lock(g_searchIndexMutex);
+  std::lock_guard<NamedMutex> lock(g_searchIndexMutex);
   addWordRec(word,hiPriority,FALSE);
 }
 
@@ -449,7 +450,7 @@ static QCString definitionToName(const Definition *ctx)
 
 void SearchIndexExternal::setCurrentDoc(const Definition *ctx,const QCString &anchor,bool isSourceFile)
 {
-  std::lock_guard<std::mutex> lock(g_searchIndexMutex);
+  std::lock_guard<NamedMutex> lock(g_searchIndexMutex);
   QCString extId = stripPath(Config_getString(EXTERNAL_SEARCH_ID));
   QCString url = isSourceFile ? (toFileDef(ctx))->getSourceFileBase() : ctx->getOutputFileBase();
   addHtmlExtensionIfMissing(url);
@@ -492,7 +493,7 @@ void SearchIndexExternal::setCurrentDoc(const Definition *ctx,const QCString &an
 
 void SearchIndexExternal::addWord(const QCString &word,bool hiPriority)
 {
-  std::lock_guard<std::mutex> lock(g_searchIndexMutex);
+  std::lock_guard<NamedMutex> lock(g_searchIndexMutex);
   if (word.isEmpty() || !isId(word[0]) || m_current==nullptr) return;
   GrowBuf *pText = hiPriority ? &m_current->importantText : &m_current->normalText;
   if (pText->getPos()>0) pText->addChar(' ');
@@ -773,7 +773,7 @@ void writeJavaScriptSearchIndex()
   std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
   if (numThreads>1) // multi threaded version
   {
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"search");
     std::vector< std::future<int> > results;
     for (auto &sii : g_searchIndexInfo)
     {
@@ -789,7 +789,7 @@ void writeJavaScriptSearchIndex()
           writeJavasScriptSearchDataPage(baseName,dataFileName,list);
           return p;
         };
-        results.emplace_back(threadPool.queue(processFile));
+        results.emplace_back(threadPool.queue(baseName,processFile));
         p++;
       }
     }
@@ -0,0 +1,1165 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "shardmodel.h"
+#include "anchor.h"
+#include "cite.h"
+#include "define.h"
+#include "docgroup.h"
+#include "doxygen.h"
+#include "entry.h"
+#include "filedef.h"
+#include "formula.h"
+#include "message.h"
+#include "moduledef.h"
+#include "portable.h"
+#include "reflist.h"
+#include "section.h"
+#include "version.h"
+
+// The shard files are written and read by the same doxygen binary, so values are
+// stored in the native byte order and the trivially copyable types as raw bytes.
+static const char shardMagic[] = "DOXYGEN-SHARD";
+static const int  shardFormat  = 2;
+
+//-----------------------------------------------------------------------------
+
+class ShardWriter
+{
+  public:
+    ShardWriter(std::string &buf) : m_buf(buf) {}
+    template<class T> void writeRaw(const T &v)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,"type must be trivially copyable");
+      m_buf.append(reinterpret_cast<const char *>(&v),sizeof(T));
+    }
+    void writeInt(int v)               { writeRaw(static_cast<int32_t>(v)); }
+    void writeSize(size_t v)           { writeRaw(static_cast<uint64_t>(v)); }
+    void writeBool(bool v)             { m_buf+=v ? '\1' : '\0'; }
+    void writeString(const std::string &s)
+    {
+      writeSize(s.length());
+      m_buf.append(s);
+    }
+    void writeString(const QCString &s) { writeString(s.str()); }
+  private:
+    std::string &m_buf;
+};
+
+class ShardReader
+{
+  public:
+    ShardReader(const char *data,size_t len) : m_p(data), m_end(data+len) {}
+    template<class T> void readRaw(T &v)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,"type must be trivially copyable");
+      if (!check(sizeof(T))) return;
+      std::memcpy(&v,m_p,sizeof(T));
+      m_p+=sizeof(T);
+    }
+    int readInt()
+    {
+      int32_t v=0;
+      readRaw(v);
+      return v;
+    }
+    size_t readSize()
+    {
+      uint64_t v=0;
+      readRaw(v);
+      return static_cast<size_t>(v);
+    }
+    bool readBool()
+    {
+      if (!check(1)) return false;
+      return *m_p++!=0;
+    }
+    std::string readStdString()
+    {
+      size_t len = readSize();
+      if (!check(len)) return std::string();
+      std::string s(m_p,len);
+      m_p+=len;
+      return s;
+    }
+    QCString readString() { return QCString(readStdString()); }
+    bool ok() const { return m_ok; }
+    const char *pos() const { return m_p; }
+    void skip(size_t len) { if (check(len)) m_p+=len; }
+  private:
+    bool check(size_t len)
+    {
+      if (!m_ok || static_cast<size_t>(m_end-m_p)<len)
+      {
+        m_ok=false;
+        return false;
+      }
+      return true;
+    }
+    const char *m_p;
+    const char *m_end;
+    bool m_ok = true;
+};
+
+//-----------------------------------------------------------------------------
+
+enum class ShardEventKind { Formula, RefItem, Anchor, Citation, Module, ModuleHeader, ModuleImport,
+                             MemberGroup, MemberGroupDoc, MemberGroupDocs };
+
+/** Call made by a parser to one of the global managers, in the order it was made. */
+struct ShardEvent
+{
+  ShardEventKind kind;
+  ShardEvent(ShardEventKind k,const std::string &v1=std::string(),
+             const std::string &v2=std::string(),const std::string &v3=std::string())
+    : kind(k), s1(v1), s2(v2), s3(v3) {}
+  std::string s1;
+  std::string s2;
+  std::string s3;
+  int  i1 = 0;
+  int  i2 = 0;
+  bool b  = false;
+  const RefItem *item = nullptr;
+  RefItemVector items;
+};
+
+/** State of the replay of a single file in the link step. */
+struct ShardReplayContext
+{
+  QCString fileName;
+  std::unordered_map<int,int> formulaMap;                  // shard id -> id
+  StringUnorderedMap xrefMap;                              // "list shardId" -> id, for the \xrefitem commands
+  StringUnorderedMap labelMap;                             // shard label -> label
+  std::unordered_map<std::string,RefItem*> refItems;       // "list shardId" -> item
+  std::unordered_map<std::string,const SectionInfo*> sections; // sections added for this file
+  std::unordered_map<int,int> memberGroupMap;              // shard id -> id
+
+  bool needsRemapping() const
+  {
+    return !formulaMap.empty() || !xrefMap.empty() || !labelMap.empty();
+  }
+  QCString remapText(const QCString &s) const;
+  QCString mapLabel(const QCString &label) const
+  {
+    auto it = labelMap.find(label.str());
+    return it!=labelMap.end() ? QCString(it->second) : label;
+  }
+};
+
+static bool isIdChar(char c)
+{
+  return (c>='a' && c<='z') || (c>='A' && c<='Z') || (c>='0' && c<='9') || c=='_' || c=='-';
+}
+
+// Renumbers the formulas, cross reference items and markdown anchors that appear in
+// the documentation text s.
+QCString ShardReplayContext::remapText(const QCString &s) const
+{
+  if (s.isEmpty() || !needsRemapping()) return s;
+  std::string text = s.str();
+  auto replaceNumbers = [&text](const std::string &prefix,auto mapNumber)
+  {
+    if (text.find(prefix)==std::string::npos) return;
+    std::string result;
+    size_t p=0, i=0;
+    while ((i=text.find(prefix,p))!=std::string::npos)
+    {
+      size_t ns = i+prefix.length();
+      size_t ne = ns;
+      while (ne<text.length() && text[ne]>='0' && text[ne]<='9') ne++;
+      std::string replacement;
+      if (ne>ns) replacement = mapNumber(i,text.substr(ns,ne-ns),ne);
+      result.append(text,p,ns-p);
+      if (!replacement.empty())
+      {
+        result+=replacement;
+        p=ne;
+      }
+      else
+      {
+        p=ns;
+      }
+    }
+    result.append(text,p,std::string::npos);
+    text=result;
+  };
+  if (!formulaMap.empty())
+  {
+    replaceNumbers("\\_form#",[this](size_t,const std::string &num,size_t) -> std::string
+    {
+      if (num.length()>9) return std::string();
+      auto it = formulaMap.find(std::stoi(num));
+      return it!=formulaMap.end() ? std::to_string(it->second) : std::string();
+    });
+  }
+  if (!labelMap.empty())
+  {
+    replaceNumbers("autotoc_md",[this,&text](size_t start,const std::string &num,size_t end) -> std::string
+    {
+      if ((start>0 && isIdChar(text[start-1])) || (end<text.length() && isIdChar(text[end])))
+      {
+        return std::string(); // part of a longer identifier
+      }
+      auto it = labelMap.find("autotoc_md"+num);
+      return it!=labelMap.end() ? it->second.substr(10) : std::string();
+    });
+  }
+  if (!xrefMap.empty() && text.find("\\xrefitem ")!=std::string::npos)
+  {
+    // the commands have the form "\xrefitem <listName> <id>."
+    std::string result;
+    size_t p=0, i=0;
+    const size_t prefixLen = 10;
+    while ((i=text.find("\\xrefitem ",p))!=std::string::npos)
+    {
+      size_t ls = i+prefixLen;
+      size_t le = text.find(' ',ls);
+      size_t ne = le;
+      if (le!=std::string::npos)
+      {
+        ne = le+1;
+        while (ne<text.length() && text[ne]>='0' && text[ne]<='9') ne++;
+      }
+      auto it = le!=std::string::npos && ne>le+1 && ne<text.length() && text[ne]=='.' ?
+                xrefMap.find(text.substr(ls,ne-ls)) : xrefMap.end();
+      if (it!=xrefMap.end())
+      {
+        result.append(text,p,le+1-p);
+        result+=it->second;
+        p=ne;
+      }
+      else
+      {
+        result.append(text,p,ls-p);
+        p=ls;
+      }
+    }
+    result.append(text,p,std::string::npos);
+    text=result;
+  }
+  return QCString(text);
+}
+
+//-----------------------------------------------------------------------------
+
+static void writeArgumentList(ShardWriter &w,const ArgumentList &al)
+{
+  w.writeSize(al.size());
+  for (const Argument &a : al)
+  {
+    w.writeString(a.attrib);
+    w.writeString(a.type);
+    w.writeString(a.canType);
+    w.writeString(a.name);
+    w.writeString(a.array);
+    w.writeString(a.defval);
+    w.writeString(a.docs);
+    w.writeString(a.typeConstraint);
+  }
+  w.writeBool(al.constSpecifier());
+  w.writeBool(al.volatileSpecifier());
+  w.writeBool(al.pureSpecifier());
+  w.writeString(al.trailingReturnType());
+  w.writeBool(al.isDeleted());
+  w.writeInt(static_cast<int>(al.refQualifier()));
+  w.writeBool(al.noParameters());
+}
+
+static void readArgumentList(ShardReader &r,ArgumentList &al,const ShardReplayContext &ctx)
+{
+  al.reset();
+  size_t n = r.readSize();
+  for (size_t i=0;i<n && r.ok();i++)
+  {
+    Argument a;
+    a.attrib         = r.readString();
+    a.type           = r.readString();
+    a.canType        = r.readString();
+    a.name           = r.readString();
+    a.array          = r.readString();
+    a.defval         = r.readString();
+    a.docs           = ctx.remapText(r.readString());
+    a.typeConstraint = r.readString();
+    al.push_back(a);
+  }
+  al.setConstSpecifier(r.readBool());
+  al.setVolatileSpecifier(r.readBool());
+  al.setPureSpecifier(r.readBool());
+  al.setTrailingReturnType(r.readString());
+  al.setIsDeleted(r.readBool());
+  al.setRefQualifier(static_cast<RefQualifierType>(r.readInt()));
+  al.setNoParameters(r.readBool());
+}
+
+static void writeSection(ShardWriter &w,const SectionInfo *si)
+{
+  w.writeString(si->label());
+  w.writeString(si->title());
+  w.writeInt(si->type().level());
+  w.writeString(si->ref());
+  w.writeInt(si->lineNr());
+  w.writeString(si->fileName());
+  w.writeInt(si->level());
+}
+
+// Adds a section read from a shard the way the comment scanner adds it while parsing.
+static const SectionInfo *readSection(ShardReader &r,ShardReplayContext &ctx)
+{
+  QCString label    = ctx.mapLabel(r.readString());
+  QCString title    = ctx.remapText(r.readString());
+  SectionType type  = SectionType(r.readInt());
+  QCString ref      = r.readString();
+  int lineNr        = r.readInt();
+  QCString fileName = r.readString();
+  int level         = r.readInt();
+  if (!r.ok()) return nullptr;
+
+  auto it = ctx.sections.find(label.str());
+  if (it!=ctx.sections.end()) return it->second; // already added for this file
+
+  SectionManager &sm = SectionManager::instance();
+  const SectionInfo *si = sm.find(label);
+  if (si)
+  {
+    if (!si->ref().isEmpty()) // we are from a tag file
+    {
+      si = sm.replace(label,fileName,lineNr,title,type,level,ref);
+    }
+    else
+    {
+      if (si->lineNr() != -1)
+      {
+        warn(fileName,lineNr,"multiple use of section label '%s', (first occurrence: %s, line %d)",
+            qPrint(label),qPrint(si->fileName()),si->lineNr());
+      }
+      else
+      {
+        warn(fileName,lineNr,"multiple use of section label '%s', (first occurrence: %s)",
+            qPrint(label),qPrint(si->fileName()));
+      }
+      si = nullptr;
+    }
+  }
+  else
+  {
+    si = sm.add(label,fileName,lineNr,title,type,level,ref);
+  }
+  ctx.sections.emplace(label.str(),si);
+  return si;
+}
+
+static void writeRefItems(ShardWriter &w,const RefItemVector &sli)
+{
+  w.writeSize(sli.size());
+  for (const RefItem *item : sli)
+  {
+    w.writeString(item->list()->listName());
+    w.writeInt(item->id());
+  }
+}
+
+static void readRefItems(ShardReader &r,RefItemVector &sli,const ShardReplayContext &ctx)
+{
+  size_t numItems = r.readSize();
+  for (size_t i=0;i<numItems && r.ok();i++)
+  {
+    std::string listName = r.readStdString();
+    int id = r.readInt();
+    auto it = ctx.refItems.find(listName+" "+std::to_string(id));
+    if (it!=ctx.refItems.end()) sli.push_back(it->second);
+  }
+}
+
+static void writeEntry(ShardWriter &w,const Entry *e)
+{
+  w.writeRaw(e->section);
+  w.writeString(e->type);
+  w.writeString(e->name);
+  w.writeBool(e->hasTagInfo);
+  if (e->hasTagInfo)
+  {
+    w.writeString(e->tagInfoData.tagName);
+    w.writeString(e->tagInfoData.fileName);
+    w.writeString(e->tagInfoData.anchor);
+  }
+  w.writeInt(static_cast<int>(e->protection));
+  w.writeInt(static_cast<int>(e->mtype));
+  w.writeRaw(e->spec);
+  w.writeInt(static_cast<int>(e->vhdlSpec));
+  w.writeInt(e->initLines);
+  w.writeBool(e->isStatic);
+  w.writeBool(e->explicitExternal);
+  w.writeBool(e->proto);
+  w.writeBool(e->subGrouping);
+  w.writeBool(e->exported);
+  w.writeRaw(e->commandOverrides);
+  w.writeInt(static_cast<int>(e->virt));
+  w.writeString(e->args);
+  w.writeString(e->bitfields);
+  writeArgumentList(w,e->argList);
+  w.writeSize(e->tArgLists.size());
+  for (const ArgumentList &al : e->tArgLists)
+  {
+    writeArgumentList(w,al);
+  }
+  w.writeString(e->program.str());
+  w.writeString(e->initializer.str());
+  w.writeString(e->includeFile);
+  w.writeString(e->includeName);
+  w.writeString(e->doc);
+  w.writeInt(e->docLine);
+  w.writeString(e->docFile);
+  w.writeString(e->brief);
+  w.writeInt(e->briefLine);
+  w.writeString(e->briefFile);
+  w.writeString(e->inbodyDocs);
+  w.writeInt(e->inbodyLine);
+  w.writeString(e->inbodyFile);
+  w.writeString(e->relates);
+  w.writeInt(static_cast<int>(e->relatesType));
+  w.writeString(e->read);
+  w.writeString(e->write);
+  w.writeString(e->inside);
+  w.writeString(e->exception);
+  writeArgumentList(w,e->typeConstr);
+  w.writeInt(e->bodyLine);
+  w.writeInt(e->bodyColumn);
+  w.writeInt(e->endBodyLine);
+  w.writeInt(e->mGrpId);
+  w.writeSize(e->extends.size());
+  for (const BaseInfo &bi : e->extends)
+  {
+    w.writeString(bi.name);
+    w.writeInt(static_cast<int>(bi.prot));
+    w.writeInt(static_cast<int>(bi.virt));
+  }
+  w.writeSize(e->groups.size());
+  for (const Grouping &g : e->groups)
+  {
+    w.writeString(g.groupname);
+    w.writeInt(static_cast<int>(g.pri));
+  }
+  w.writeSize(e->anchors.size());
+  for (const SectionInfo *si : e->anchors)
+  {
+    writeSection(w,si);
+  }
+  w.writeString(e->fileName);
+  w.writeInt(e->startLine);
+  w.writeInt(e->startColumn);
+  writeRefItems(w,e->sli);
+  w.writeInt(static_cast<int>(e->lang));
+  w.writeBool(e->hidden);
+  w.writeBool(e->artificial);
+  w.writeInt(static_cast<int>(e->groupDocType));
+  w.writeString(e->id);
+  w.writeRaw(e->localToc);
+  w.writeString(e->metaData);
+  w.writeString(e->req);
+  w.writeSize(e->qualifiers.size());
+  for (const auto &q : e->qualifiers)
+  {
+    w.writeString(q);
+  }
+  w.writeSize(e->children().size());
+  for (const auto &child : e->children())
+  {
+    writeEntry(w,child.get());
+  }
+}
+
+static void readEntry(ShardReader &r,Entry *e,ShardReplayContext &ctx)
+{
+  r.readRaw(e->section);
+  e->type = r.readString();
+  e->name = r.readString();
+  e->hasTagInfo = r.readBool();
+  if (e->hasTagInfo)
+  {
+    e->tagInfoData.tagName  = r.readString();
+    e->tagInfoData.fileName = r.readString();
+    e->tagInfoData.anchor   = r.readString();
+  }
+  e->protection = static_cast<Protection>(r.readInt());
+  e->mtype      = static_cast<MethodTypes>(r.readInt());
+  r.readRaw(e->spec);
+  e->vhdlSpec   = static_cast<VhdlSpecifier>(r.readInt());
+  e->initLines  = r.readInt();
+  e->isStatic         = r.readBool();
+  e->explicitExternal = r.readBool();
+  e->proto            = r.readBool();
+  e->subGrouping      = r.readBool();
+  e->exported         = r.readBool();
+  r.readRaw(e->commandOverrides);
+  e->virt      = static_cast<Specifier>(r.readInt());
+  e->args      = r.readString();
+  e->bitfields = r.readString();
+  readArgumentList(r,e->argList,ctx);
+  size_t numTArgLists = r.readSize();
+  for (size_t i=0;i<numTArgLists && r.ok();i++)
+  {
+    ArgumentList al;
+    readArgumentList(r,al,ctx);
+    e->tArgLists.push_back(al);
+  }
+  e->program     << r.readStdString();
+  e->initializer << r.readStdString();
+  e->includeFile = r.readString();
+  e->includeName = r.readString();
+  e->doc         = ctx.remapText(r.readString());
+  e->docLine     = r.readInt();
+  e->docFile     = r.readString();
+  e->brief       = ctx.remapText(r.readString());
+  e->briefLine   = r.readInt();
+  e->briefFile   = r.readString();
+  e->inbodyDocs  = ctx.remapText(r.readString());
+  e->inbodyLine  = r.readInt();
+  e->inbodyFile  = r.readString();
+  e->relates     = r.readString();
+  e->relatesType = static_cast<RelatesType>(r.readInt());
+  e->read        = r.readString();
+  e->write       = r.readString();
+  e->inside      = r.readString();
+  e->exception   = r.readString();
+  readArgumentList(r,e->typeConstr,ctx);
+  e->bodyLine    = r.readInt();
+  e->bodyColumn  = r.readInt();
+  e->endBodyLine = r.readInt();
+  int grpId      = r.readInt();
+  auto git       = ctx.memberGroupMap.find(grpId);
+  e->mGrpId      = git!=ctx.memberGroupMap.end() ? git->second : DOX_NOGROUP;
+  size_t numExtends = r.readSize();
+  for (size_t i=0;i<numExtends && r.ok();i++)
+  {
+    QCString name = r.readString();
+    Protection prot = static_cast<Protection>(r.readInt());
+    Specifier virt  = static_cast<Specifier>(r.readInt());
+    e->extends.emplace_back(name,prot,virt);
+  }
+  size_t numGroups = r.readSize();
+  for (size_t i=0;i<numGroups && r.ok();i++)
+  {
+    QCString name = r.readString();
+    Grouping::GroupPri_t pri = static_cast<Grouping::GroupPri_t>(r.readInt());
+    e->groups.emplace_back(name,pri);
+  }
+  size_t numAnchors = r.readSize();
+  for (size_t i=0;i<numAnchors && r.ok();i++)
+  {
+    const SectionInfo *si = readSection(r,ctx);
+    if (si) e->anchors.push_back(si);
+  }
+  e->fileName    = r.readString();
+  e->startLine   = r.readInt();
+  e->startColumn = r.readInt();
+  readRefItems(r,e->sli,ctx);
+  e->lang         = static_cast<SrcLangExt>(r.readInt());
+  e->hidden       = r.readBool();
+  e->artificial   = r.readBool();
+  e->groupDocType = static_cast<Entry::GroupDocType>(r.readInt());
+  e->id           = r.readString();
+  r.readRaw(e->localToc);
+  e->metaData     = r.readString();
+  e->req          = r.readString();
+  size_t numQualifiers = r.readSize();
+  for (size_t i=0;i<numQualifiers && r.ok();i++)
+  {
+    e->qualifiers.push_back(r.readStdString());
+  }
+  size_t numChildren = r.readSize();
+  for (size_t i=0;i<numChildren && r.ok();i++)
+  {
+    auto child = std::make_shared<Entry>();
+    readEntry(r,child.get(),ctx);
+    e->moveToSubEntryAndKeep(child);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+struct ShardModel::Private
+{
+  // recording
+  bool recording = false;
+  QCString currentFile;
+  std::vector<ShardEvent> events;
+  size_t sectionsBefore = 0;
+  StringUnorderedSet aliasesSeen;
+  std::string data;     // serialized files
+  size_t numFiles = 0;
+
+  // link step
+  std::vector<std::string> shards;                                   // contents of the shard files
+  std::unordered_map<std::string,std::pair<size_t,size_t>> fileMap;  // file name -> (shard, offset)
+};
+
+ShardModel::ShardModel() : p(std::make_unique<Private>()) {}
+
+ShardModel::~ShardModel() = default;
+
+ShardModel &ShardModel::instance()
+{
+  static ShardModel sm;
+  return sm;
+}
+
+QCString ShardModel::shardFileName(const QCString &outputDir,int index,int count)
+{
+  QCString name;
+  name.sprintf("/doxygen_shard_%d_of_%d.dat",index,count);
+  return outputDir+name;
+}
+
+bool ShardModel::isRecording() const
+{
+  return p->recording;
+}
+
+void ShardModel::beginFile(const QCString &fileName)
+{
+  p->recording      = true;
+  p->currentFile    = fileName;
+  p->sectionsBefore = SectionManager::instance().size();
+  p->events.clear();
+}
+
+void ShardModel::recordFormula(const std::string &text,int id)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::Formula,text);
+  ev.i1 = id;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordRefItem(const RefItem *item)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::RefItem);
+  ev.item = item;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordAnchor(const std::string &label,const std::string &anchor,bool reserved)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::Anchor,label,anchor);
+  ev.b = reserved;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordCitation(const QCString &label)
+{
+  if (!p->recording) return;
+  p->events.emplace_back(ShardEventKind::Citation,label.str());
+}
+
+void ShardModel::recordMemberGroup(int groupId,const QCString &header,const QCString &compoundName)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::MemberGroup,header.str(),compoundName.str());
+  ev.i1 = groupId;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordMemberGroupDoc(int groupId,const QCString &doc)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::MemberGroupDoc,doc.str());
+  ev.i1 = groupId;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordMemberGroupDocs(int groupId,const QCString &doc,const QCString &docFile,int docLine,
+                                       const RefItemVector &sli)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::MemberGroupDocs,doc.str(),docFile.str());
+  ev.i1 = groupId;
+  ev.i2 = docLine;
+  ev.items = sli;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordModule(const QCString &fileName,int line,int column,bool exported,
+                              const QCString &moduleName,const QCString &partitionName)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::Module,fileName.str(),moduleName.str(),partitionName.str());
+  ev.i1 = line;
+  ev.i2 = column;
+  ev.b  = exported;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordModuleHeader(const QCString &moduleFile,int line,const QCString &headerName,bool isSystem)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::ModuleHeader,moduleFile.str(),headerName.str());
+  ev.i1 = line;
+  ev.b  = isSystem;
+  p->events.push_back(ev);
+}
+
+void ShardModel::recordModuleImport(const QCString &moduleFile,int line,const QCString &importName,
+                                    bool isExported,const QCString &partitionName)
+{
+  if (!p->recording) return;
+  ShardEvent ev(ShardEventKind::ModuleImport,moduleFile.str(),importName.str(),partitionName.str());
+  ev.i1 = line;
+  ev.b  = isExported;
+  p->events.push_back(ev);
+}
+
+void ShardModel::endFile(const std::shared_ptr<Entry> &fileRoot,const FileDef *fd)
+{
+  p->recording = false;
+  std::string record;
+  ShardWriter w(record);
+  w.writeString(p->currentFile);
+
+  // calls to the global managers
+  w.writeSize(p->events.size());
+  for (const auto &ev : p->events)
+  {
+    w.writeInt(static_cast<int>(ev.kind));
+    if (ev.kind==ShardEventKind::RefItem)
+    {
+      // the item is stored as it is at the end of the file, since later
+      // documentation blocks of the same entry can extend its text
+      const RefItem *item = ev.item;
+      const RefList *list = item->list();
+      w.writeString(list->listName());
+      w.writeString(list->pageTitle());
+      w.writeString(list->sectionTitle());
+      w.writeInt(item->id());
+      w.writeString(item->text());
+      w.writeString(item->prefix());
+      w.writeString(item->name());
+      w.writeString(item->title());
+      w.writeString(item->args());
+      w.writeString(item->group());
+    }
+    else
+    {
+      w.writeString(ev.s1);
+      w.writeString(ev.s2);
+      w.writeString(ev.s3);
+      w.writeInt(ev.i1);
+      w.writeInt(ev.i2);
+      w.writeBool(ev.b);
+      if (ev.kind==ShardEventKind::MemberGroupDocs)
+      {
+        writeRefItems(w,ev.items);
+      }
+    }
+  }
+  p->events.clear();
+
+  // sections added while parsing the file, in the order they were added
+  SectionManager &sm = SectionManager::instance();
+  size_t numSections = sm.size()>p->sectionsBefore ? sm.size()-p->sectionsBefore : 0;
+  w.writeSize(numSections);
+  for (auto it = sm.begin()+static_cast<std::ptrdiff_t>(p->sectionsBefore); it!=sm.end(); ++it)
+  {
+    writeSection(w,it->get());
+  }
+
+  writeEntry(w,fileRoot.get());
+
+  // namespace aliases found in the file
+  std::vector< std::pair<std::string,std::string> > aliases;
+  for (const auto &[name,alias] : Doxygen::namespaceAliasMap)
+  {
+    if (p->aliasesSeen.insert(name).second) aliases.emplace_back(name,alias);
+  }
+  w.writeSize(aliases.size());
+  for (const auto &[name,alias] : aliases)
+  {
+    w.writeString(name);
+    w.writeString(alias);
+  }
+
+  // macro definitions found by the preprocessor
+  auto mit = Doxygen::macroDefinitions.find(p->currentFile.str());
+  w.writeBool(mit!=Doxygen::macroDefinitions.end());
+  if (mit!=Doxygen::macroDefinitions.end())
+  {
+    w.writeSize(mit->second.size());
+    for (const Define &def : mit->second)
+    {
+      w.writeString(def.name);
+      w.writeString(def.definition);
+      w.writeString(def.fileName);
+      w.writeString(def.args);
+      w.writeString(def.fileDef ? def.fileDef->absFilePath() : QCString());
+      w.writeInt(def.lineNr);
+      w.writeInt(def.columnNr);
+      w.writeInt(def.nargs);
+      w.writeBool(def.undef);
+      w.writeBool(def.varArgs);
+      w.writeBool(def.isPredefined);
+      w.writeBool(def.nonRecursive);
+      w.writeBool(def.expandAsDefined);
+    }
+    Doxygen::macroDefinitions.erase(mit); // not needed anymore in this process
+  }
+
+  // include relations found by the preprocessor
+  IncludeInfoList noIncludes;
+  const IncludeInfoList &includes = fd ? fd->includeFileList() : noIncludes;
+  w.writeSize(includes.size());
+  for (const IncludeInfo &ii : includes)
+  {
+    w.writeString(ii.fileDef ? ii.fileDef->absFilePath() : QCString());
+    w.writeString(ii.includeName);
+    w.writeInt(static_cast<int>(ii.kind));
+  }
+
+  ShardWriter fw(p->data);
+  fw.writeString(record);
+  p->numFiles++;
+}
+
+bool ShardModel::write(const QCString &fileName)
+{
+  std::string header;
+  ShardWriter w(header);
+  w.writeString(std::string(shardMagic));
+  w.writeInt(shardFormat);
+  w.writeString(getFullVersion());
+  w.writeSize(p->numFiles);
+
+  std::ofstream f = Portable::openOutputStream(fileName);
+  if (!f.is_open())
+  {
+    err("cannot open shard file %s for writing\n",qPrint(fileName));
+    return false;
+  }
+  f.write(header.data(),static_cast<std::streamsize>(header.size()));
+  f.write(p->data.data(),static_cast<std::streamsize>(p->data.size()));
+  if (!f.good())
+  {
+    err("failed to write shard file %s\n",qPrint(fileName));
+    return false;
+  }
+  msg("Wrote %zu parsed files to %s\n",p->numFiles,qPrint(fileName));
+  return true;
+}
+
+bool ShardModel::read(const QCString &fileName)
+{
+  std::ifstream f = Portable::openInputStream(fileName,true);
+  if (!f.is_open())
+  {
+    err("cannot open shard file %s for reading\n",qPrint(fileName));
+    return false;
+  }
+  std::string contents((std::istreambuf_iterator<char>(f)),std::istreambuf_iterator<char>());
+  p->shards.push_back(std::move(contents));
+  size_t shardIndex = p->shards.size()-1;
+  const std::string &data = p->shards.back();
+
+  ShardReader r(data.data(),data.size());
+  std::string magic   = r.readStdString();
+  int format          = r.readInt();
+  std::string version = r.readStdString();
+  if (!r.ok() || magic!=shardMagic || format!=shardFormat)
+  {
+    err("%s is not a shard file of this doxygen version\n",qPrint(fileName));
+    return false;
+  }
+  if (version!=getFullVersion())
+  {
+    err("shard file %s was written by doxygen version %s, but this is version %s\n",
+        qPrint(fileName),version.c_str(),getFullVersion().c_str());
+    return false;
+  }
+  size_t numFiles = r.readSize();
+  for (size_t i=0;i<numFiles && r.ok();i++)
+  {
+    size_t len = r.readSize();
+    size_t offset = static_cast<size_t>(r.pos()-data.data());
+    ShardReader fr(r.pos(),len);
+    std::string name = fr.readStdString();
+    r.skip(len);
+    if (fr.ok() && r.ok())
+    {
+      if (!p->fileMap.emplace(name,std::make_pair(shardIndex,offset)).second)
+      {
+        warn_uncond("file %s is present in more than one shard, using the first one.\n",name.c_str());
+      }
+    }
+  }
+  if (!r.ok())
+  {
+    err("shard file %s is truncated\n",qPrint(fileName));
+    return false;
+  }
+  msg("Read %zu parsed files from %s\n",numFiles,qPrint(fileName));
+  return true;
+}
+
+bool ShardModel::contains(const QCString &fileName) const
+{
+  return p->fileMap.find(fileName.str())!=p->fileMap.end();
+}
+
+std::shared_ptr<Entry> ShardModel::replayFile(const QCString &fileName,FileDef *fd)
+{
+  auto fit = p->fileMap.find(fileName.str());
+  if (fit==p->fileMap.end()) return nullptr;
+  const std::string &data = p->shards[fit->second.first];
+  size_t offset = fit->second.second;
+  ShardReader lr(data.data()+offset-sizeof(uint64_t),sizeof(uint64_t));
+  size_t len = lr.readSize();
+  ShardReader r(data.data()+offset,len);
+
+  ShardReplayContext ctx;
+  ctx.fileName = r.readString();
+
+  // replay the calls to the global managers in their original order, so the
+  // numbers handed out are the same as when all files are parsed by one process
+  std::vector< std::pair<RefItem*,QCString> > itemTexts;
+  std::vector<ShardEvent> groupDocs;
+  size_t numEvents = r.readSize();
+  for (size_t i=0;i<numEvents && r.ok();i++)
+  {
+    ShardEventKind kind = static_cast<ShardEventKind>(r.readInt());
+    if (kind==ShardEventKind::RefItem)
+    {
+      QCString listName  = r.readString();
+      QCString pageTitle = r.readString();
+      QCString secTitle  = r.readString();
+      int shardId        = r.readInt();
+      RefList *refList = RefListManager::instance().add(listName,pageTitle,secTitle);
+      RefItem *item = refList->add();
+      QCString anchorLabel;
+      anchorLabel.sprintf("_%s%06d",listName.data(),item->id());
+      QCString shardAnchorLabel;
+      shardAnchorLabel.sprintf("_%s%06d",listName.data(),shardId);
+      item->setAnchor(anchorLabel);
+      itemTexts.emplace_back(item,r.readString());
+      item->setPrefix(r.readString());
+      item->setName(r.readString());
+      item->setTitle(r.readString());
+      item->setArgs(r.readString());
+      item->setGroup(r.readString());
+      std::string key = listName.str()+" "+std::to_string(shardId);
+      ctx.refItems.emplace(key,item);
+      if (item->id()!=shardId)
+      {
+        ctx.xrefMap.emplace(key,std::to_string(item->id()));
+        ctx.labelMap.emplace(shardAnchorLabel.str(),anchorLabel.str());
+      }
+    }
+    else
+    {
+      std::string s1 = r.readStdString();
+      std::string s2 = r.readStdString();
+      std::string s3 = r.readStdString();
+      int  i1 = r.readInt();
+      int  i2 = r.readInt();
+      bool b  = r.readBool();
+      RefItemVector items;
+      if (kind==ShardEventKind::MemberGroupDocs)
+      {
+        readRefItems(r,items,ctx);
+      }
+      switch (kind)
+      {
+        case ShardEventKind::Formula:
+          {
+            int id = FormulaManager::instance().addFormula(s1);
+            if (id!=i1) ctx.formulaMap.emplace(i1,id);
+          }
+          break;
+        case ShardEventKind::Anchor:
+          if (b)
+          {
+            AnchorGenerator::instance().reserve(s2);
+          }
+          else
+          {
+            std::string anchor = AnchorGenerator::instance().generate(s1);
+            if (anchor!=s2)
+            {
+              if (QCString(s2).startsWith("autotoc_md") && QCString(anchor).startsWith("autotoc_md"))
+              {
+                ctx.labelMap.emplace(s2,anchor);
+              }
+              else
+              {
+                warn_uncond("the id '%s' generated in %s for heading '%s' differs from the id '%s' generated by "
+                            "a build that parses all input files at once.\n",
+                            s2.c_str(),qPrint(ctx.fileName),s1.c_str(),anchor.c_str());
+              }
+            }
+          }
+          break;
+        case ShardEventKind::Citation:
+          CitationManager::instance().insert(QCString(s1));
+          break;
+        case ShardEventKind::MemberGroup:
+          {
+            // groups of the same scope with the same header are shared between files,
+            // so look the group up again instead of using the shard's id
+            auto info = std::make_unique<MemberGroupInfo>();
+            info->header       = s1;
+            info->compoundName = s2;
+            ctx.memberGroupMap.emplace(i1,DocGroup::findOrAddMemberGroup(std::move(info)));
+          }
+          break;
+        case ShardEventKind::MemberGroupDoc:
+        case ShardEventKind::MemberGroupDocs:
+          {
+            auto git = ctx.memberGroupMap.find(i1);
+            if (git!=ctx.memberGroupMap.end())
+            {
+              ShardEvent ev(kind,s1,s2);
+              ev.i1 = git->second;
+              ev.i2 = i2;
+              ev.items = std::move(items);
+              groupDocs.push_back(std::move(ev));
+            }
+          }
+          break;
+        case ShardEventKind::Module:
+          ModuleManager::instance().createModuleDef(QCString(s1),i1,i2,b,QCString(s2),QCString(s3));
+          break;
+        case ShardEventKind::ModuleHeader:
+          ModuleManager::instance().addHeader(QCString(s1),i1,QCString(s2),b);
+          break;
+        case ShardEventKind::ModuleImport:
+          ModuleManager::instance().addImport(QCString(s1),i1,QCString(s2),b,QCString(s3));
+          break;
+        case ShardEventKind::RefItem:
+          break;
+      }
+    }
+  }
+  for (const auto &[item,text] : itemTexts)
+  {
+    item->setText(ctx.remapText(text));
+  }
+  // the documentation of the member groups can refer to items added later in the file
+  for (const ShardEvent &ev : groupDocs)
+  {
+    auto it = Doxygen::memberGroupInfoMap.find(ev.i1);
+    if (it==Doxygen::memberGroupInfoMap.end()) continue;
+    MemberGroupInfo *info = it->second.get();
+    info->doc = ctx.remapText(QCString(ev.s1));
+    if (ev.kind==ShardEventKind::MemberGroupDocs)
+    {
+      info->docFile = ev.s2;
+      info->docLine = ev.i2;
+      info->setRefItems(ev.items);
+    }
+  }
+
+  size_t numSections = r.readSize();
+  for (size_t i=0;i<numSections && r.ok();i++)
+  {
+    readSection(r,ctx);
+  }
+
+  std::shared_ptr<Entry> fileRoot = std::make_shared<Entry>();
+  readEntry(r,fileRoot.get(),ctx);
+  fileRoot->setFileDef(fd);
+
+  size_t numAliases = r.readSize();
+  for (size_t i=0;i<numAliases && r.ok();i++)
+  {
+    std::string name  = r.readStdString();
+    std::string alias = r.readStdString();
+    Doxygen::namespaceAliasMap.insert({name,alias});
+  }
+
+  if (r.readBool())
+  {
+    DefineList defines;
+    size_t numDefines = r.readSize();
+    for (size_t i=0;i<numDefines && r.ok();i++)
+    {
+      Define def;
+      def.name       = r.readString();
+      def.definition = r.readString();
+      def.fileName   = r.readString();
+      def.args       = r.readString();
+      QCString defFileName = r.readString();
+      if (!defFileName.isEmpty())
+      {
+        bool ambig = false;
+        def.fileDef = findFileDef(Doxygen::inputNameLinkedMap,defFileName,ambig);
+      }
+      def.lineNr          = r.readInt();
+      def.columnNr        = r.readInt();
+      def.nargs           = r.readInt();
+      def.undef           = r.readBool();
+      def.varArgs         = r.readBool();
+      def.isPredefined    = r.readBool();
+      def.nonRecursive    = r.readBool();
+      def.expandAsDefined = r.readBool();
+      defines.push_back(def);
+    }
+    Doxygen::macroDefinitions.emplace(ctx.fileName.str(),std::move(defines));
+  }
+
+  size_t numIncludes = r.readSize();
+  for (size_t i=0;i<numIncludes && r.ok();i++)
+  {
+    QCString toFileName  = r.readString();
+    QCString includeName = r.readString();
+    IncludeKind kind     = static_cast<IncludeKind>(r.readInt());
+    FileDef *toFd = nullptr;
+    if (!toFileName.isEmpty())
+    {
+      bool ambig = false;
+      toFd = findFileDef(Doxygen::inputNameLinkedMap,toFileName,ambig);
+    }
+    if (fd)
+    {
+      fd->addIncludeDependency(toFd,includeName,kind);
+      if (toFd)
+      {
+        toFd->addIncludedByDependency(fd,fd->docName(),kind);
+      }
+    }
+  }
+
+  if (!r.ok())
+  {
+    err("the parse results of %s in the shard file are corrupt\n",qPrint(fileName));
+  }
+  return fileRoot;
+}
+
+void ShardModel::clear()
+{
+  p->recording = false;
+  p->events.clear();
+  p->aliasesSeen.clear();
+  p->data.clear();
+  p->data.shrink_to_fit();
+  p->numFiles = 0;
+  p->shards.clear();
+  p->fileMap.clear();
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef SHARDMODEL_H
+#define SHARDMODEL_H
+
+#include <memory>
+#include <string>
+
+#include "qcstring.h"
+#include "construct.h"
+#include "reflist.h"
+
+class Entry;
+class FileDef;
+
+/** @brief Intermediate model of the parsed input files of a sharded build.
+ *
+ *  With \c --shard \c i/n a doxygen process only parses its part of the input files and
+ *  writes the resulting Entry trees to a shard file in the output directory. Besides the
+ *  trees the shard records, per input file, everything the parsers add to global state:
+ *  sections, cross reference items, formulas, citations, markdown anchors, member groups,
+ *  C++20 module declarations, namespace aliases, macro definitions and include relations.
+ *
+ *  With \c --link-shards \c n all shard files are read and the files are replayed in the
+ *  order of the input files, so formulas, cross reference items, anchors and member groups
+ *  get the same numbers as in a build that parses all files in a single process. Numbers that appear
+ *  in the documentation text (\c \\_form\#, \c \\xrefitem and \c autotoc_md) are renumbered
+ *  accordingly.
+ */
+class ShardModel
+{
+  public:
+    static ShardModel &instance();
+
+    //! @name recording in a shard process
+    //! @{
+    /** Returns TRUE while the parse results of a file are being recorded. */
+    bool isRecording() const;
+    /** Starts recording the parse results of \a fileName. */
+    void beginFile(const QCString &fileName);
+    /** Stores the Entry tree \a fileRoot and the recorded results of file \a fd. */
+    void endFile(const std::shared_ptr<Entry> &fileRoot,const FileDef *fd);
+    void recordFormula(const std::string &text,int id);
+    void recordRefItem(const RefItem *item);
+    void recordAnchor(const std::string &label,const std::string &anchor,bool reserved);
+    void recordCitation(const QCString &label);
+    void recordMemberGroup(int groupId,const QCString &header,const QCString &compoundName);
+    void recordMemberGroupDoc(int groupId,const QCString &doc);
+    void recordMemberGroupDocs(int groupId,const QCString &doc,const QCString &docFile,int docLine,
+                               const RefItemVector &sli);
+    void recordModule(const QCString &fileName,int line,int column,bool exported,
+                      const QCString &moduleName,const QCString &partitionName);
+    void recordModuleHeader(const QCString &moduleFile,int line,const QCString &headerName,bool isSystem);
+    void recordModuleImport(const QCString &moduleFile,int line,const QCString &importName,
+                            bool isExported,const QCString &partitionName);
+    /** Writes the recorded files to \a fileName. Returns FALSE on failure. */
+    bool write(const QCString &fileName);
+    //! @}
+
+    //! @name link step
+    //! @{
+    /** Reads the shard file \a fileName. Returns FALSE on failure. */
+    bool read(const QCString &fileName);
+    /** Returns TRUE if one of the shard files read contains \a fileName. */
+    bool contains(const QCString &fileName) const;
+    /** Rebuilds the Entry tree of \a fileName for file \a fd and applies the recorded
+     *  results to the global state.
+     */
+    std::shared_ptr<Entry> replayFile(const QCString &fileName,FileDef *fd);
+    //! @}
+
+    /** Frees all recorded data. */
+    void clear();
+
+    static QCString shardFileName(const QCString &outputDir,int index,int count);
+
+  private:
+    ShardModel();
+   ~ShardModel();
+    NON_COPYABLE(ShardModel)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
@@ -0,0 +1,212 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef STATICMAP_H
+#define STATICMAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+/** @brief Key/value pair used to define a StaticMap. */
+template<class V>
+struct StaticMapEntry
+{
+  std::string_view key;
+  V value;
+};
+
+/** @brief Read-only map from strings to values of type \a V, built at compile time.
+ *
+ *  The map uses a perfect hash (hash and displace): the keys are first divided
+ *  over buckets, and for every bucket a displacement is searched that gives all
+ *  its keys a slot of their own. A lookup therefore computes one hash of the key,
+ *  reads one displacement and does at most one string comparison, without
+ *  allocating memory.
+ *
+ *  The map refers to the array of entries it was built from, which must have static
+ *  storage duration. If a key occurs more than once, the first entry is used.
+ *
+ *  Use makeStaticMap() to create a map from a C array or a std::array of entries:
+ *  \code
+ *  static constexpr StaticMapEntry<int> g_entries[] = { { "one", 1 }, { "two", 2 } };
+ *  static constexpr auto g_map = makeStaticMap(g_entries);
+ *  \endcode
+ */
+template<class V,size_t N>
+class StaticMap
+{
+  public:
+    constexpr explicit StaticMap(const StaticMapEntry<V> *entries) : m_entries(entries)
+    {
+      // compute the hash of each key once and count the keys per bucket
+      std::array<uint64_t,N> hashes {};
+      std::array<uint32_t,NumBuckets+1> start {};
+      for (size_t i=0;i<N;i++)
+      {
+        hashes[i] = hash(entries[i].key);
+        start[bucket(hashes[i])+1]++;
+      }
+      size_t maxSize = 0;
+      for (size_t b=0;b<NumBuckets;b++)
+      {
+        if (start[b+1]>maxSize) maxSize=start[b+1];
+        start[b+1]+=start[b];
+      }
+      // order the keys by bucket
+      std::array<uint32_t,N> order {};
+      std::array<uint32_t,NumBuckets> fill {};
+      for (size_t i=0;i<N;i++)
+      {
+        size_t b = bucket(hashes[i]);
+        order[start[b]+fill[b]++] = static_cast<uint32_t>(i);
+      }
+      // place the largest buckets first, they are the hardest to fit
+      for (size_t size=maxSize;size>0;size--)
+      {
+        for (size_t b=0;b<NumBuckets;b++)
+        {
+          if (start[b+1]-start[b]==size)
+          {
+            placeBucket(entries,hashes,order,start[b],start[b+1],b);
+          }
+        }
+      }
+    }
+
+    /** Returns a pointer to the value for \a key, or nullptr if the key is not in the map. */
+    constexpr const V *find(std::string_view key) const
+    {
+      uint64_t h = hash(key);
+      uint32_t index = m_slots[slot(h,m_displacements[bucket(h)])];
+      if (index!=0 && m_entries[index-1].key==key)
+      {
+        return &m_entries[index-1].value;
+      }
+      return nullptr;
+    }
+
+    /** Returns the value for \a key, or \a defValue if the key is not in the map. */
+    constexpr V value(std::string_view key,V defValue) const
+    {
+      const V *v = find(key);
+      return v ? *v : defValue;
+    }
+
+    /** Returns the entries the map was built from, in their original order. */
+    constexpr const StaticMapEntry<V> *begin() const { return m_entries;   }
+    constexpr const StaticMapEntry<V> *end()   const { return m_entries+N; }
+
+  private:
+    static constexpr size_t roundUpPow2(size_t n)
+    {
+      size_t r=1;
+      while (r<n) r<<=1;
+      return r;
+    }
+    static constexpr size_t NumSlots   = roundUpPow2(N+N/4+1);
+    static constexpr size_t NumBuckets = roundUpPow2(N/4+1);
+
+    /** FNV-1a hash */
+    static constexpr uint64_t hash(std::string_view s)
+    {
+      uint64_t h = 0xcbf29ce484222325ULL;
+      for (char c : s)
+      {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+      }
+      return h;
+    }
+    static constexpr size_t bucket(uint64_t h)
+    {
+      return static_cast<size_t>(h>>40) & (NumBuckets-1);
+    }
+    /** Returns the slot for a key with hash \a h in a bucket with displacement \a d */
+    static constexpr size_t slot(uint64_t h,uint32_t d)
+    {
+      h ^= d*0x9e3779b97f4a7c15ULL;
+      h ^= h>>33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h>>33;
+      return static_cast<size_t>(h) & (NumSlots-1);
+    }
+
+    constexpr void placeBucket(const StaticMapEntry<V> *entries,const std::array<uint64_t,N> &hashes,
+                               const std::array<uint32_t,N> &order,size_t first,size_t last,size_t b)
+    {
+      for (uint32_t d=0;d<maxDisplacement;d++)
+      {
+        bool ok=true;
+        for (size_t i=first;i<last && ok;i++)
+        {
+          uint32_t k = order[i];
+          size_t s = slot(hashes[k],d);
+          ok = m_slots[s]==0;
+          for (size_t j=first;j<i && ok;j++) // check against the other keys in the bucket
+          {
+            uint32_t kj = order[j];
+            if (entries[kj].key==entries[k].key) break; // duplicate key, it will be skipped
+            ok = slot(hashes[kj],d)!=s;
+          }
+        }
+        if (ok)
+        {
+          m_displacements[b] = d;
+          for (size_t i=first;i<last;i++)
+          {
+            uint32_t k = order[i];
+            size_t s = slot(hashes[k],d);
+            // keep the first of a duplicate key (the keys are ordered by index within a bucket)
+            if (m_slots[s]==0) m_slots[s] = k+1;
+          }
+          return;
+        }
+      }
+      throw std::logic_error("StaticMap: no perfect hash found");
+    }
+
+    static constexpr uint32_t maxDisplacement = 1u<<16;
+    const StaticMapEntry<V> *m_entries;
+    std::array<uint32_t,NumSlots>   m_slots {};         // index+1 into m_entries, 0 for an empty slot
+    std::array<uint32_t,NumBuckets> m_displacements {};
+};
+
+/** Returns a StaticMap for the array \a entries, see StaticMap. */
+template<class V,size_t N>
+constexpr StaticMap<V,N> makeStaticMap(const StaticMapEntry<V> (&entries)[N])
+{
+  return StaticMap<V,N>(entries);
+}
+
+/** Returns a StaticMap for the array \a entries, see StaticMap. */
+template<class V,size_t N>
+constexpr StaticMap<V,N> makeStaticMap(const std::array<StaticMapEntry<V>,N> &entries)
+{
+  return StaticMap<V,N>(entries.data());
+}
+
+/** Returns the length of the longest key in \a entries. */
+template<class V,size_t N>
+constexpr size_t maxStaticMapKeyLength(const StaticMapEntry<V> (&entries)[N])
+{
+  size_t result=0;
+  for (size_t i=0;i<N;i++) if (entries[i].key.length()>result) result=entries[i].key.length();
+  return result;
+}
+
+#endif
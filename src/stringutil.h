@@ -93,4 +93,38 @@ inline void addTerminalCharIfMissing(std::string &s,char c)
   }
 }
 
+/** Appends \a s to \a out as a quoted JSON string, escaping quotes, backslashes and
+ *  control characters.
+ */
+inline void appendJsonString(std::string &out,std::string_view s)
+{
+  static const char hex[] = "0123456789abcdef";
+  out+='"';
+  for (char ch : s)
+  {
+    unsigned char c = static_cast<unsigned char>(ch);
+    switch (c)
+    {
+      case '"':  out+="\\\""; break;
+      case '\\': out+="\\\\"; break;
+      case '\n': out+="\\n";  break;
+      case '\r': out+="\\r";  break;
+      case '\t': out+="\\t";  break;
+      default:
+        if (c<0x20)
+        {
+          out+="\\u00";
+          out+=hex[c>>4];
+          out+=hex[c&0xF];
+        }
+        else
+        {
+          out+=ch;
+        }
+        break;
+    }
+  }
+  out+='"';
+}
+
 #endif // STRINGUTIL_H
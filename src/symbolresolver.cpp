@@ -24,8 +24,12 @@
 #include "config.h"
 #include "defargs.h"
 #include "trace.h"
+#include "namedmutex.h"
 
-#if !ENABLE_SYMBOLRESOLVER_TRACING
+#if ENABLE_SYMBOLRESOLVER_TRACING
+#undef  TRACE_SUBSYSTEM
+#define TRACE_SUBSYSTEM Trace::SymbolResolver
+#else
 #undef  AUTO_TRACE
 #undef  AUTO_TRACE_ADD
 #undef  AUTO_TRACE_EXIT
@@ -34,8 +38,8 @@
 #define AUTO_TRACE_EXIT(...) (void)0
 #endif
 
-static std::mutex g_cacheMutex;
-static std::recursive_mutex g_cacheTypedefMutex;
+static NamedMutex g_cacheMutex("symbolresolver.cpp:g_cacheMutex");
+static NamedRecursiveMutex g_cacheTypedefMutex("symbolresolver.cpp:g_cacheTypedefMutex");
 
 //--------------------------------------------------------------------------------------
 
@@ -856,7 +860,7 @@ const ClassDef *SymbolResolver::Private::newResolveTypedef(
                   const ArgumentList *actTemplParams)                  // in
 {
   AUTO_TRACE("md={}",md->qualifiedName());
-  std::lock_guard<std::recursive_mutex> lock(g_cacheTypedefMutex);
+  std::lock_guard<NamedRecursiveMutex> lock(g_cacheTypedefMutex);
   bool isCached = md->isTypedefValCached(); // value already cached
   if (isCached)
   {
@@ -26,6 +26,9 @@
 #include <utility>
 #include <vector>
 
+#include "qcstring.h"
+#include "timeline.h"
+
 /// Class managing a pool of worker threads.
 /// Work can be queued by passing a function to queue(). A future will be
 /// returned that can be used to obtain the result of the function after execution.
@@ -44,11 +47,15 @@
 ///   printf("Result %d:\n", f.get());
 /// }
 /// @endcode
+///
+/// When the timeline is enabled (see the \c --timeline option) each task is recorded
+/// as an event of the \a category passed to the constructor. A task queued with
+/// a name is shown with that name, other tasks with the name of the category.
 class ThreadPool
 {
   public:
     /// start N threads in the thread pool.
-    ThreadPool(std::size_t N=1)
+    ThreadPool(std::size_t N=1,const char *category="task") : m_category(category)
     {
       for (std::size_t i = 0; i < N; ++i)
       {
@@ -75,6 +82,15 @@ class ThreadPool
     /// A future of the return type of the function is returned to capture the result.
     template<class F, typename ...Args>
     auto queue(F&& f, Args&&... args) -> std::future<decltype(f(args...))>
+    {
+      return queue(QCString(m_category),std::forward<F>(f),std::forward<Args>(args)...);
+    }
+
+    /// Queue the callable function \a f for the threads to execute as a task
+    /// called \a name in the timeline.
+    /// A future of the return type of the function is returned to capture the result.
+    template<class F, typename ...Args>
+    auto queue(const QCString &name, F&& f, Args&&... args) -> std::future<decltype(f(args...))>
     {
       // We wrap the function object into a packaged task, splitting
       // execution from the return value.
@@ -83,7 +99,15 @@ class ThreadPool
       // to a std::function.
       using RetType = decltype(f(args...));
       auto ptr = std::make_shared< std::packaged_task<RetType()> >(std::forward<F>(f), std::forward<Args>(args)...);
-      auto taskFunc = [ptr]() { if (ptr->valid()) (*ptr)(); };
+      const char *category = m_category;
+      auto taskFunc = [ptr,category,name]()
+      {
+        if (ptr->valid())
+        {
+          Timeline::Scope scope(category,name);
+          (*ptr)();
+        }
+      };
 
       auto r=ptr->get_future(); // get the return value before we hand off the task
       {
@@ -136,6 +160,9 @@ class ThreadPool
       }
     }
 
+    // the category of the tasks in the timeline
+    const char *m_category;
+
     // the mutex, condition variable and deque form a single
     // thread-safe triggered queue of tasks:
     std::mutex m_mutex;
@@ -0,0 +1,209 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "timeline.h"
+#include "message.h"
+#include "portable.h"
+#include "stringutil.h"
+
+namespace
+{
+
+/** A single recorded event */
+struct Event
+{
+  char        phase;     // 'X' for a complete event, 'C' for a counter
+  const char *category;
+  QCString    name;
+  QCString    detail;
+  uint64_t    start;
+  uint64_t    duration;
+  std::vector< std::pair<const char *,uint64_t> > values; // counter values
+};
+
+/** Events recorded by one thread */
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(int t) : tid(t) {}
+  int tid;
+  std::mutex mutex; // only contended while writing the timeline
+  std::vector<Event> events;
+};
+
+std::atomic<bool>                          g_enabled { false };
+std::chrono::steady_clock::time_point      g_startTime;
+QCString                                   g_fileName;
+std::mutex                                 g_buffersMutex;
+std::vector< std::shared_ptr<ThreadBuffer> > g_buffers;
+std::set<int>                              g_freeTids;
+int                                        g_nextTid = 0;
+
+/** Owns the buffer of the current thread. A thread that finishes hands back its thread
+ *  id, so the workers of consecutive thread pools are shown on the same rows, but the
+ *  buffer itself is kept until the timeline is written.
+ */
+struct ThreadSlot
+{
+  ThreadSlot()
+  {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    int tid = g_nextTid;
+    if (!g_freeTids.empty())
+    {
+      tid = *g_freeTids.begin();
+      g_freeTids.erase(g_freeTids.begin());
+    }
+    else
+    {
+      g_nextTid++;
+    }
+    buffer = std::make_shared<ThreadBuffer>(tid);
+    g_buffers.push_back(buffer);
+  }
+ ~ThreadSlot()
+  {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    g_freeTids.insert(buffer->tid);
+  }
+  NON_COPYABLE(ThreadSlot)
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+ThreadBuffer &threadBuffer()
+{
+  static thread_local ThreadSlot slot;
+  return *slot.buffer;
+}
+
+void writeString(std::ofstream &t,std::string_view s)
+{
+  std::string out;
+  appendJsonString(out,s);
+  t << out;
+}
+
+} // namespace
+
+void Timeline::enable(const QCString &fileName)
+{
+  g_fileName  = fileName;
+  g_startTime = std::chrono::steady_clock::now();
+  g_enabled   = true;
+  threadBuffer(); // make sure the main thread gets the first thread id
+}
+
+bool Timeline::isEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t Timeline::now()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now()-g_startTime).count());
+}
+
+uint64_t Timeline::beginEvent()
+{
+  threadBuffer();
+  return now();
+}
+
+void Timeline::addEvent(const char *category,const QCString &name,uint64_t start,uint64_t end,
+                        const QCString &detail)
+{
+  if (!isEnabled()) return;
+  ThreadBuffer &buf = threadBuffer();
+  std::lock_guard<std::mutex> lock(buf.mutex);
+  buf.events.push_back(Event{'X',category,name,detail,start,end>start ? end-start : 0,{}});
+}
+
+void Timeline::addCounter(const char *name,std::initializer_list< std::pair<const char *,uint64_t> > values)
+{
+  if (!isEnabled()) return;
+  ThreadBuffer &buf = threadBuffer();
+  std::lock_guard<std::mutex> lock(buf.mutex);
+  buf.events.push_back(Event{'C',"counter",name,QCString(),now(),0,values});
+}
+
+void Timeline::write()
+{
+  if (!isEnabled()) return;
+  std::ofstream t = Portable::openOutputStream(g_fileName);
+  if (!t.is_open())
+  {
+    err("Could not open file %s for writing the timeline\n",qPrint(g_fileName));
+    return;
+  }
+  uint32_t pid = Portable::pid();
+  t << "{\"traceEvents\":[\n";
+  t << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid << ",\"tid\":0,\"args\":{\"name\":\"doxygen\"}}";
+  std::lock_guard<std::mutex> lock(g_buffersMutex);
+  for (int tid=0; tid<g_nextTid; tid++)
+  {
+    QCString threadName = tid==0 ? QCString("main") : QCString("worker ")+QCString().setNum(tid);
+    t << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"args\":{\"name\":";
+    writeString(t,threadName.view());
+    t << "}}";
+  }
+  size_t numEvents = 0;
+  for (const auto &buf : g_buffers)
+  {
+    std::lock_guard<std::mutex> bufLock(buf->mutex);
+    for (const auto &e : buf->events)
+    {
+      t << ",\n{\"ph\":\"" << e.phase << "\",\"cat\":";
+      writeString(t,e.category);
+      t << ",\"name\":";
+      writeString(t,e.name.view());
+      t << ",\"pid\":" << pid << ",\"tid\":" << buf->tid << ",\"ts\":" << e.start;
+      if (e.phase=='X')
+      {
+        t << ",\"dur\":" << e.duration;
+        if (!e.detail.isEmpty())
+        {
+          t << ",\"args\":{\"detail\":";
+          writeString(t,e.detail.view());
+          t << "}";
+        }
+      }
+      else
+      {
+        t << ",\"args\":{";
+        bool first=true;
+        for (const auto &[key,value] : e.values)
+        {
+          if (!first) t << ",";
+          writeString(t,key);
+          t << ":" << value;
+          first=false;
+        }
+        t << "}";
+      }
+      t << "}";
+      numEvents++;
+    }
+  }
+  t << "\n]}\n";
+  msg("Written timeline with %zu events to %s\n",numEvents,qPrint(g_fileName));
+}
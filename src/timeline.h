@@ -0,0 +1,98 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+#include "qcstring.h"
+#include "construct.h"
+
+/** @brief Recorder for a timeline of a doxygen run in the Chrome trace event format.
+ *
+ *  When enabled (see the \c --timeline option) the serial phases of a run, the tasks
+ *  executed by the thread pools and the invocations of external tools are recorded as
+ *  events with a start time, a duration and the thread that executed them. Counters,
+ *  such as the hits and misses of the caches, can be added as well. The resulting JSON
+ *  file can be loaded in \c chrome://tracing or https://ui.perfetto.dev to find tasks
+ *  that take much longer than the others and threads that are waiting for work.
+ *
+ *  Events are collected in a buffer per thread, so recording does not contend with
+ *  other threads. When the timeline is not enabled, recording an event only costs
+ *  a check of a flag.
+ */
+namespace Timeline
+{
+  /** Starts recording, the events are written to \a fileName by write(). */
+  void enable(const QCString &fileName);
+  bool isEnabled();
+
+  /** Returns the time in microseconds since the recording started. */
+  uint64_t now();
+
+  /** Returns now() after assigning the current thread its row in the timeline, to be
+   *  used as the start of an event that is added when it ends.
+   */
+  uint64_t beginEvent();
+
+  /** Records an event of \a category called \a name that ran from \a start till \a end
+   *  on the current thread. The optional \a detail is shown with the event.
+   */
+  void addEvent(const char *category,const QCString &name,uint64_t start,uint64_t end,
+                const QCString &detail=QCString());
+
+  /** Records the current \a values of counter \a name. The names of the values
+   *  must be string literals.
+   */
+  void addCounter(const char *name,std::initializer_list< std::pair<const char *,uint64_t> > values);
+
+  /** Writes all recorded events to the file passed to enable(). */
+  void write();
+
+  /** @brief Records an event for the lifetime of the object. */
+  class Scope
+  {
+    public:
+      Scope(const char *category,const QCString &name,const QCString &detail=QCString())
+      {
+        if (isEnabled())
+        {
+          m_category = category;
+          m_name     = name;
+          m_detail   = detail;
+          m_start    = beginEvent();
+        }
+      }
+     ~Scope()
+      {
+        if (m_category)
+        {
+          addEvent(m_category,m_name,m_start,now(),m_detail);
+        }
+      }
+      NON_COPYABLE(Scope)
+    private:
+      const char *m_category = nullptr;
+      QCString    m_name;
+      QCString    m_detail;
+      uint64_t    m_start    = 0;
+  };
+}
+
+#endif
@@ -27,8 +27,9 @@
 #include "filedef.h"
 #include "doxygen.h"
 #include "config.h"
+#include "namedmutex.h"
 
-static std::mutex                                                g_tooltipsMutex;
+static NamedMutex                                                g_tooltipsMutex("tooltip.cpp:g_tooltipsMutex");
 static std::unordered_map<int, std::unordered_set<std::string> > g_tooltipsWrittenPerFile;
 
 class TooltipManager::Private
@@ -88,7 +89,7 @@ void TooltipManager::addTooltip(const Definition *d)
 void TooltipManager::writeTooltips(OutputCodeList &ol)
 {
   // critical section
-  std::lock_guard<std::mutex> lock(g_tooltipsMutex);
+  std::lock_guard<NamedMutex> lock(g_tooltipsMutex);
 
   int id = ol.id();
   auto it = g_tooltipsWrittenPerFile.find(id);
@@ -13,12 +13,56 @@
  *
  */
 
+#include <map>
+
 #include "trace.h"
 #include "spdlog/sinks/basic_file_sink.h" // support for basic file logging
 #include "spdlog/sinks/stdout_sinks.h"
 
 std::shared_ptr<spdlog::logger> g_tracer;
 
+uint32_t Trace::g_mask       = Trace::All;
+uint32_t Trace::g_sampleRate = 1;
+
+bool Trace::setMask(const QCString &subsystems)
+{
+  static const std::map<std::string,uint32_t> names =
+  {
+    { "general",        General        },
+    { "symbolresolver", SymbolResolver },
+    { "markdown",       Markdown       },
+    { "docparser",      DocParser      },
+    { "all",            All            }
+  };
+  uint32_t mask = 0;
+  bool ok = true;
+  QCString list = subsystems.lower();
+  int p=0, i=0;
+  while (p<=static_cast<int>(list.length()))
+  {
+    i = list.find(',',p);
+    if (i==-1) i=static_cast<int>(list.length());
+    QCString name = list.mid(p,i-p).stripWhiteSpace();
+    auto it = names.find(name.str());
+    if (it!=names.end())
+    {
+      mask |= it->second;
+    }
+    else if (!name.isEmpty())
+    {
+      ok = false;
+    }
+    p=i+1;
+  }
+  g_mask = mask;
+  return ok;
+}
+
+void Trace::setSampleRate(uint32_t n)
+{
+  g_sampleRate = n>0 ? n : 1;
+}
+
 void initTracing(const QCString &logFile, bool timing)
 {
   if (!logFile.isEmpty())
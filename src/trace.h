@@ -17,18 +17,30 @@
 #define TRACE_H
 
 #ifndef ENABLE_TRACING
-#ifndef NDEBUG
+#if defined(TRACING_LEVEL)
+#define ENABLE_TRACING (TRACING_LEVEL>0)
+#elif !defined(NDEBUG)
 #define ENABLE_TRACING 1
 #else
 #define ENABLE_TRACING 0
 #endif
 #endif
 
-// Since some modules produce a huge amount of tracing we disable those traces by default.
-// Set of or more of the following to 1 to enable the relevant tracing
-#define ENABLE_SYMBOLRESOLVER_TRACING 0
-#define ENABLE_MARKDOWN_TRACING       0
-#define ENABLE_DOCPARSER_TRACING      0
+// Compile-time tracing level:
+//  0: no tracing code is compiled in
+//  1: tracing in all modules, except for the hot paths below (default if ENABLE_TRACING is set)
+//  2: also tracing in the hot paths (cmake option enable_hotpath_tracing)
+// Tracing that is compiled in is only done for the subsystems selected at runtime
+// (see Trace::setMask()), so the hot paths can be compiled in without slowing down
+// a run that does not trace them.
+#ifndef TRACING_LEVEL
+#define TRACING_LEVEL ENABLE_TRACING
+#endif
+
+// Since some modules produce a huge amount of tracing they are only compiled in at level 2.
+#define ENABLE_SYMBOLRESOLVER_TRACING (TRACING_LEVEL>=2)
+#define ENABLE_MARKDOWN_TRACING       (TRACING_LEVEL>=2)
+#define ENABLE_DOCPARSER_TRACING      (TRACING_LEVEL>=2)
 
 
 #if ENABLE_TRACING
@@ -42,6 +54,9 @@
 #include "spdlog/spdlog.h"
 #pragma pop_macro("warn")
 
+#include <atomic>
+#include <cstdint>
+
 #include "types.h"
 #include "qcstring.h"
 #include "construct.h"
@@ -53,6 +68,49 @@ void exitTracing();
 
 namespace Trace
 {
+  /** Subsystems that can be traced independently. A module selects its subsystem
+   *  by redefining TRACE_SUBSYSTEM after including this file.
+   */
+  enum Subsystem : uint32_t
+  {
+    General        = 0x1,
+    SymbolResolver = 0x2,
+    Markdown       = 0x4,
+    DocParser      = 0x8,
+    All            = 0xF
+  };
+
+  extern uint32_t g_mask;
+  extern uint32_t g_sampleRate;
+
+  /** Selects the subsystems to trace from a comma separated list of names.
+   *  Returns FALSE if the list contains an unknown name.
+   */
+  bool setMask(const QCString &subsystems);
+  /** Only traces one in \a n calls of each AUTO_TRACE in the hot path subsystems. */
+  void setSampleRate(uint32_t n);
+
+  inline bool isEnabled(uint32_t subsystem)
+  {
+    return g_tracer && (g_mask & subsystem)!=0;
+  }
+
+  /** State of a single AUTO_TRACE call site, used to decide if a call is traced. */
+  class Site
+  {
+    public:
+      constexpr explicit Site(uint32_t subsystem) : m_subsystem(subsystem) {}
+      bool sample()
+      {
+        if (!isEnabled(m_subsystem)) return false;
+        if (g_sampleRate<=1 || m_subsystem==General) return true;
+        return m_count.fetch_add(1,std::memory_order_relaxed)%g_sampleRate==0;
+      }
+    private:
+      uint32_t m_subsystem;
+      std::atomic<uint32_t> m_count { 0 };
+  };
+
   inline QCString trunc(const QCString &s,size_t numChars=15)
   {
     QCString result;
@@ -71,42 +129,49 @@ namespace Trace
   }
 }
 
+/** The subsystem the traces of a module belong to */
+#ifndef TRACE_SUBSYSTEM
+#define TRACE_SUBSYSTEM Trace::General
+#endif
+
 #if ENABLE_TRACING
-#define TRACE(...) if (g_tracer) SPDLOG_LOGGER_TRACE(g_tracer,__VA_ARGS__)
+#define TRACE(...) if (Trace::isEnabled(TRACE_SUBSYSTEM)) SPDLOG_LOGGER_TRACE(g_tracer,__VA_ARGS__)
 #else
 #define TRACE(...) (void)0
 #endif
 
-/** Helper class to trace an entry statement at creation and another one at destruction. */
+/** Helper class to trace an entry statement at creation and another one at destruction.
+ *  Whether the call is traced is decided once at creation by the \a site of the call.
+ *  Only if it is, \a enterFunc is called to evaluate and format the entry statement.
+ */
 class AutoTrace
 {
   public:
-    explicit AutoTrace(spdlog::source_loc loc) : m_loc(loc)
+    template<class EnterFunc>
+    AutoTrace(Trace::Site &site,spdlog::source_loc loc,EnterFunc &&enterFunc)
+      : m_loc(loc), m_active(site.sample())
     {
-      if (g_tracer)
-      {
-        g_tracer->log(m_loc,spdlog::level::trace,">");
-      }
+      if (m_active) enterFunc(*this);
+    }
+    void enter()
+    {
+      g_tracer->log(m_loc,spdlog::level::trace,">");
     }
     template<typename... Args>
-    explicit AutoTrace(spdlog::source_loc loc,
-                       const std::string &fmt, Args&&...args) : m_loc(loc)
+    void enter(const std::string &fmt, Args&&...args)
     {
-      if (g_tracer)
+      if (fmt.empty())
       {
-        if (fmt.empty())
-        {
-          g_tracer->log(m_loc,spdlog::level::trace,">");
-        }
-        else
-        {
-          g_tracer->log(m_loc,spdlog::level::trace,"> "+fmt,std::forward<Args>(args)...);
-        }
+        g_tracer->log(m_loc,spdlog::level::trace,">");
+      }
+      else
+      {
+        g_tracer->log(m_loc,spdlog::level::trace,"> "+fmt,std::forward<Args>(args)...);
       }
     }
    ~AutoTrace()
     {
-      if (g_tracer)
+      if (m_active && g_tracer)
       {
         if (m_exitMessage.empty())
         {
@@ -120,6 +185,8 @@ class AutoTrace
     }
     NON_COPYABLE(AutoTrace)
 
+    bool isActive() const { return m_active; }
+
     template<typename... Args>
     void add(spdlog::source_loc loc,
              const std::string &fmt, Args&&...args)
@@ -136,13 +203,16 @@ class AutoTrace
     }
   private:
    spdlog::source_loc m_loc;
+   bool m_active;
    std::string m_exitMessage;
 };
 
 #if ENABLE_TRACING
-#define AUTO_TRACE(...)      AutoTrace trace_{spdlog::source_loc{__FILE__,__LINE__,SPDLOG_FUNCTION},__VA_ARGS__}
-#define AUTO_TRACE_ADD(...)  trace_.add(spdlog::source_loc{__FILE__,__LINE__,SPDLOG_FUNCTION},__VA_ARGS__)
-#define AUTO_TRACE_EXIT(...) trace_.setExit(__VA_ARGS__)
+#define AUTO_TRACE(...)      AutoTrace trace_([]() -> Trace::Site & { static Trace::Site site_(TRACE_SUBSYSTEM); return site_; }(), \
+                                              spdlog::source_loc{__FILE__,__LINE__,SPDLOG_FUNCTION},                      \
+                                              [&](AutoTrace &t_) { t_.enter(__VA_ARGS__); })
+#define AUTO_TRACE_ADD(...)  do { if (trace_.isActive()) trace_.add(spdlog::source_loc{__FILE__,__LINE__,SPDLOG_FUNCTION},__VA_ARGS__); } while(0)
+#define AUTO_TRACE_EXIT(...) do { if (trace_.isActive()) trace_.setExit(__VA_ARGS__); } while(0)
 #else
 #define AUTO_TRACE(...)      (void)0
 #define AUTO_TRACE_ADD(...)  (void)0
@@ -22,6 +22,7 @@
 #include <assert.h>
 
 #include <mutex>
+#include <atomic>
 #include <unordered_set>
 #include <codecvt>
 #include <algorithm>
@@ -69,6 +70,7 @@
 #include "htmlentity.h"
 #include "symbolresolver.h"
 #include "fileinfo.h"
+#include "fssnapshot.h"
 #include "dir.h"
 #include "utf8.h"
 #include "textstream.h"
@@ -77,6 +79,10 @@
 #include "moduledef.h"
 #include "trace.h"
 #include "stringutil.h"
+#include "outputarchive.h"
+#include "contentstore.h"
+#include "dot.h"
+#include "namedmutex.h"
 
 #define ENABLE_TRACINGSUPPORT 0
 
@@ -1796,7 +1802,7 @@ static QCString extractCanonicalArgType(const Definition *d,const FileDef *fs,co
   return extractCanonicalType(d,fs,type,lang);
 }
 
-static std::mutex g_matchArgsMutex;
+static NamedMutex g_matchArgsMutex("util.cpp:g_matchArgsMutex");
 
 // a bit of debug support for matchArguments
 #define MATCH
@@ -3231,7 +3237,7 @@ void generateFileRef(OutputList &ol,const QCString &name,const QCString &text)
 //----------------------------------------------------------------------
 
 /** Cache element for the file name to FileDef mapping cache. */
-struct FindFileCacheElem
+struct FindFileCacheElem : public MemoryCounted<MemoryCategory::LookupCaches,FindFileCacheElem>
 {
   FindFileCacheElem(FileDef *fd,bool ambig) : fileDef(fd), isAmbig(ambig) {}
   FileDef *fileDef;
@@ -3240,7 +3246,7 @@ struct FindFileCacheElem
 
 static Cache<std::string,FindFileCacheElem> g_findFileDefCache(5000);
 
-static std::mutex g_findFileDefMutex;
+static NamedMutex g_findFileDefMutex("util.cpp:g_findFileDefMutex");
 
 FileDef *findFileDef(const FileNameLinkedMap *fnMap,const QCString &n,bool &ambig)
 {
@@ -3254,7 +3260,7 @@ FileDef *findFileDef(const FileNameLinkedMap *fnMap,const QCString &n,bool &ambi
   QCString key = addr;
   key+=n;
 
-  std::lock_guard<std::mutex> lock(g_findFileDefMutex);
+  std::lock_guard<NamedMutex> lock(g_findFileDefMutex);
   FindFileCacheElem *cachedResult = g_findFileDefCache.find(key.str());
   //printf("key=%s cachedResult=%p\n",qPrint(key),cachedResult);
   if (cachedResult)
@@ -3829,7 +3835,7 @@ QCString unescapeCharsInString(const QCString &s)
 }
 
 static std::unordered_map<std::string,int> g_usedNames;
-static std::mutex g_usedNamesMutex;
+static NamedMutex g_usedNamesMutex("util.cpp:g_usedNamesMutex");
 static int g_usedNamesCount=1;
 
 
@@ -3846,7 +3852,7 @@ QCString convertNameToFile(const QCString &name,bool allowDots,bool allowUndersc
   QCString result;
   if (shortNames) // use short names only
   {
-    std::lock_guard<std::mutex> lock(g_usedNamesMutex);
+    std::lock_guard<NamedMutex> lock(g_usedNamesMutex);
     auto kv = g_usedNames.find(name.str());
     uint32_t num=0;
     if (kv!=g_usedNames.end())
@@ -3917,35 +3923,43 @@ QCString determineAbsoluteIncludeName(const QCString &curFile,const QCString &in
 {
   bool searchIncludes = Config_getBool(SEARCH_INCLUDES);
   QCString absIncFileName = incFileName;
-  FileInfo fi(curFile.str());
-  if (fi.exists())
+  FileSystemSnapshot &fss = FileSystemSnapshot::instance();
+  if (fss.exists(curFile.str()))
   {
-    QCString absName = QCString(fi.dirPath(TRUE))+"/"+incFileName;
-    FileInfo fi2(absName.str());
-    if (fi2.exists())
+    FileInfo fi(curFile.str());
+    std::string curDir = fi.dirPath(TRUE);
+    // the result only depends on the directory of the current file, so it can be shared
+    std::string key = "abs\n"+curDir+"\n"+incFileName.str();
+    std::string result;
+    if (fss.findInclude(key,result))
     {
-      absIncFileName=fi2.absFilePath();
+      return result.empty() ? absIncFileName : QCString(result);
+    }
+    QCString absName = QCString(curDir)+"/"+incFileName;
+    if (fss.exists(absName.str()))
+    {
+      result=FileInfo(absName.str()).absFilePath();
     }
     else if (searchIncludes) // search in INCLUDE_PATH as well
     {
       const StringVector &includePath = Config_getList(INCLUDE_PATH);
       for (const auto &incPath : includePath)
       {
-        FileInfo fi3(incPath);
-        if (fi3.exists() && fi3.isDir())
+        if (fss.isDir(incPath))
         {
-          absName = QCString(fi3.absFilePath())+"/"+incFileName;
+          absName = QCString(FileInfo(incPath).absFilePath())+"/"+incFileName;
           //printf("trying absName=%s\n",qPrint(absName));
-          FileInfo fi4(absName.str());
-          if (fi4.exists())
+          if (fss.exists(absName.str()))
           {
-            absIncFileName=fi4.absFilePath();
+            result=FileInfo(absName.str()).absFilePath();
             break;
           }
           //printf( "absIncFileName = %s\n", qPrint(absIncFileName) );
         }
       }
     }
+    fss.insertInclude(key,result);
+    if (!result.empty()) absIncFileName=result;
     //printf( "absIncFileName = %s\n", qPrint(absIncFileName) );
   }
   return absIncFileName;
@@ -5783,14 +5797,19 @@ static void transcodeCharacterBuffer(const QCString &fileName,std::string &conte
   portable_iconv_close(cd);
 }
 
-//! read a file name \a fileName and optionally filter and transcode it
+//! read a file name \a fileName and optionally filter and transcode it.
+//! The result is kept in the ContentStore so the file is only read and filtered once.
 bool readInputFile(const QCString &fileName,std::string &contents,bool filter,bool isSourceCode)
 {
   // try to open file
   FileInfo fi(fileName.str());
   if (!fi.exists()) return FALSE;
-  QCString filterName = getFileFilter(fileName,isSourceCode);
-  if (filterName.isEmpty() || !filter)
+  QCString filterName = filter ? getFileFilter(fileName,isSourceCode) : QCString();
+  if (ContentStore::instance().find(fileName,filterName,contents))
+  {
+    return true;
+  }
+  if (filterName.isEmpty())
   {
     std::ifstream f = Portable::openInputStream(fileName,true);
     if (!f.is_open())
@@ -5859,9 +5878,45 @@ bool readInputFile(const QCString &fileName,std::string &contents,bool filter,bo
   }
 
   filterCRLF(contents);
+  ContentStore::instance().insert(fileName,filterName,contents);
   return true;
 }
 
+MappedInputFile::~MappedInputFile()
+{
+  close();
+}
+
+void MappedInputFile::close()
+{
+  Portable::unmapFile(m_data,m_size);
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool MappedInputFile::open(const QCString &fileName)
+{
+  close();
+  FileInfo fi(fileName.str());
+  if (!fi.exists() || !getFileFilter(fileName,false).isEmpty()) return false;
+  QCString encoding = getEncoding(fi);
+  if (!encoding.isEmpty() && qstricmp(encoding.data(),"UTF-8")!=0) return false; // needs transcoding
+  m_data = Portable::mapFile(fileName,m_size);
+  if (m_data==nullptr) return false;
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(m_data);
+  bool usable =
+    p[m_size-1]=='\n' &&                                              // no terminating newline to add
+    !(m_size>=2 && ((p[0]==0xFF && p[1]==0xFE) || (p[0]==0xFE && p[1]==0xFF))) && // no UCS-2 BOM
+    !(m_size>=3 && p[0]==0xEF && p[1]==0xBB && p[2]==0xBF) &&          // no UTF-8 BOM
+    memchr(m_data,'\r',m_size)==nullptr &&                             // no line endings to convert
+    memchr(m_data,'\0',m_size)==nullptr;                               // no NUL characters to replace
+  if (!usable)
+  {
+    close();
+  }
+  return usable;
+}
+
 // Replace %word by word in title
 QCString filterTitle(const QCString &title)
 {
@@ -6119,9 +6174,96 @@ bool copyFile(const QCString &src,const QCString &dest)
     err("could not copy file %s to %s\n",qPrint(src),qPrint(dest));
     return false;
   }
+  addDiskFileToOutputArchive(dest);
+  return true;
+}
+
+static std::atomic<size_t> g_outputFilesWritten;
+static std::atomic<size_t> g_outputFilesUnchanged;
+
+/** Returns TRUE if file \a fileName exists and its contents equal \a contents. */
+static bool fileHasContents(const QCString &fileName,const std::string &contents)
+{
+  FileInfo fi(fileName.str());
+  if (!fi.exists() || !fi.isFile() || fi.size()!=contents.size()) return false;
+  std::ifstream f = Portable::openInputStream(fileName,true);
+  if (!f.is_open()) return false;
+  const size_t blockSize = 64*1024;
+  std::vector<char> block(std::min(blockSize,contents.size()));
+  size_t pos=0;
+  while (pos<contents.size())
+  {
+    size_t len = std::min(blockSize,contents.size()-pos);
+    if (!f.read(block.data(),static_cast<std::streamsize>(len)) ||
+        memcmp(block.data(),contents.data()+pos,len)!=0)
+    {
+      return false;
+    }
+    pos+=len;
+  }
+  return true;
+}
+
+bool bufferOutputFile(const QCString &fileName)
+{
+  return Config_getBool(KEEP_UNCHANGED_FILES) || outputArchiveForFile(fileName)!=nullptr;
+}
+
+bool writeFileIfChanged(const QCString &fileName,const std::string &contents)
+{
+  if (Config_getBool(KEEP_UNCHANGED_FILES) && fileHasContents(fileName,contents))
+  {
+    g_outputFilesUnchanged++;
+    return true;
+  }
+  std::ofstream f = Portable::openOutputStream(fileName);
+  if (!f.is_open())
+  {
+    err("Cannot open file %s for writing!\n",qPrint(fileName));
+    return false;
+  }
+  f.write(contents.data(),static_cast<std::streamsize>(contents.size()));
+  g_outputFilesWritten++;
   return true;
 }
 
+bool writeFileContents(const QCString &fileName,const std::string &contents)
+{
+  bool patched = Config_getBool(HAVE_DOT) && DotManager::instance()->hasFilePatcher(fileName);
+  OutputArchive *archive = outputArchiveForFile(fileName);
+  if (archive)
+  {
+    // files that get image maps or figures inserted after running dot are
+    // written to disk and added to the archive once they are patched
+    if (!patched)
+    {
+      return archive->addFile(fileName,contents);
+    }
+    archive->addDiskFile(fileName);
+  }
+  else if (patched && Config_getBool(KEEP_UNCHANGED_FILES))
+  {
+    // the file on disk is the patched version of the previous run, so store the
+    // unpatched contents as input for DotFilePatcher, which compares its result
+    // with the existing file
+    std::ofstream f = Portable::openOutputStream(fileName+".tmp");
+    if (!f.is_open())
+    {
+      err("Cannot open file %s.tmp for writing!\n",qPrint(fileName));
+      return false;
+    }
+    f.write(contents.data(),static_cast<std::streamsize>(contents.size()));
+    return true;
+  }
+  return writeFileIfChanged(fileName,contents);
+}
+
+void getOutputFileCounts(size_t &written,size_t &unchanged)
+{
+  written   = g_outputFilesWritten;
+  unchanged = g_outputFilesUnchanged;
+}
+
 /** Returns the line number of the line following the line with the marker.
  *  \sa routine extractBlock
  */
@@ -387,6 +387,33 @@ void stackTrace();
 
 bool readInputFile(const QCString &fileName,std::string &contents,
                    bool filter=TRUE,bool isSourceCode=FALSE);
+
+/** @brief Contents of an input file that is mapped into memory.
+ *
+ *  Files that need no input filter, no character transcoding and no line
+ *  ending conversion are used as is, without reading them into a string.
+ */
+class MappedInputFile
+{
+  public:
+    MappedInputFile() = default;
+   ~MappedInputFile();
+    NON_COPYABLE(MappedInputFile)
+
+    /** Maps \a fileName into memory. Returns FALSE if the file could not be mapped
+     *  or if its contents would be changed by readInputFile(), in which case
+     *  readInputFile() should be used instead. A mapped file always ends with a newline.
+     *  The contents are not added to the ContentStore; since they are identical to the
+     *  file on disk a later readInputFile() call can cheaply read them again.
+     */
+    bool open(const QCString &fileName);
+    std::string_view contents() const { return std::string_view(m_data,m_size); }
+
+  private:
+    void close();
+    const char *m_data = nullptr;
+    size_t      m_size = 0;
+};
 QCString filterTitle(const QCString &title);
 
 bool patternMatch(const FileInfo &fi,const StringVector &patList);
@@ -419,6 +446,28 @@ QCString replaceColorMarkers(const QCString &str);
 
 bool copyFile(const QCString &src,const QCString &dest);
 
+/** Writes \a contents to the file \a fileName. When \c KEEP_UNCHANGED_FILES is enabled
+ *  and the file already has the same contents, it is left untouched so its
+ *  modification time is preserved. If the file belongs to an output directory that
+ *  is collected in an archive, the contents are added to the archive instead.
+ *  Returns FALSE if the file could not be written.
+ */
+bool writeFileContents(const QCString &fileName,const std::string &contents);
+
+/** Writes \a contents to the file \a fileName, unless \c KEEP_UNCHANGED_FILES is enabled
+ *  and the file already has the same contents. Unlike writeFileContents() the file
+ *  is never added to an archive or staged for patching.
+ */
+bool writeFileIfChanged(const QCString &fileName,const std::string &contents);
+
+/** Returns TRUE if the contents of output file \a fileName should be collected in
+ *  memory and written using writeFileContents(), instead of being streamed to disk.
+ */
+bool bufferOutputFile(const QCString &fileName);
+
+/** Returns the number of files written and left unchanged by writeFileContents(). */
+void getOutputFileCounts(size_t &written,size_t &unchanged);
+
 int lineBlock(const QCString &text,const QCString &marker);
 
 bool isURL(const QCString &url);
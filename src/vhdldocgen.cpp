@@ -63,6 +63,7 @@
 #include "plantuml.h"
 #include "textstream.h"
 #include "moduledef.h"
+#include "namedmutex.h"
 
 //#define DEBUGFLOW
 #define theTranslator_vhdlType theTranslator->trVhdlType
@@ -209,7 +210,7 @@ ClassDef* VhdlDocGen::getPackageName(const QCString & name)
   return getClass(name);
 }
 
-static std::recursive_mutex                        g_vhdlMutex;
+static NamedRecursiveMutex                         g_vhdlMutex("vhdldocgen.cpp:g_vhdlMutex");
 static std::map<std::string,const MemberDef*>      g_varMap;
 static std::vector<ClassDef*>                      g_classList;
 static std::map<ClassDef*,std::vector<ClassDef*> > g_packages;
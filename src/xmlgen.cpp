@@ -14,6 +14,7 @@
  */
 
 #include <stdlib.h>
+#include <sstream>
 
 #include "textstream.h"
 #include "xmlgen.h"
@@ -51,6 +52,7 @@
 #include "portable.h"
 #include "outputlist.h"
 #include "moduledef.h"
+#include "construct.h"
 
 // no debug info
 #define XML_DB(x) do {} while(0)
@@ -61,6 +63,55 @@
 
 //------------------
 
+/** Output file of the XML generator. When bufferOutputFile() is true, the
+ *  contents are collected in memory and passed to writeFileContents() when the
+ *  file is closed, otherwise they are streamed to the file directly.
+ */
+class XMLOutputFile
+{
+  public:
+    explicit XMLOutputFile(const QCString &fileName) { open(fileName); }
+   ~XMLOutputFile() { close(); }
+    NON_COPYABLE(XMLOutputFile)
+
+    void open(const QCString &fileName)
+    {
+      close();
+      m_fileName = fileName;
+      m_buffered = bufferOutputFile(fileName);
+      if (m_buffered)
+      {
+        m_contents.str(std::string());
+      }
+      else
+      {
+        m_file = Portable::openOutputStream(fileName);
+      }
+    }
+    void close()
+    {
+      if (m_buffered && !m_fileName.isEmpty())
+      {
+        writeFileContents(m_fileName,m_contents.str());
+      }
+      else if (m_file.is_open())
+      {
+        m_file.close();
+      }
+      m_fileName.clear();
+    }
+    bool is_open() const { return m_buffered || m_file.is_open(); }
+    std::ostream *stream() { return m_buffered ? static_cast<std::ostream*>(&m_contents) : &m_file; }
+
+  private:
+    QCString m_fileName;
+    bool m_buffered = false;
+    std::ofstream m_file;
+    std::ostringstream m_contents;
+};
+
+//------------------
+
 static std::map<MemberListType,std::string> g_xmlSectionMap =
 {
   { MemberListType_pubTypes,"public-type" },
@@ -166,12 +217,13 @@ static void writeCombineScript()
 {
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/combine.xslt";
-  std::ofstream t = Portable::openOutputStream(fileName);
-  if (!t.is_open())
+  XMLOutputFile f(fileName);
+  if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
+  std::ostream &t = *f.stream();
 
   t <<
   "<!-- XSLT script to combine the generated output into a single file. \n"
@@ -1456,13 +1508,13 @@ static void generateXMLForClass(const ClassDef *cd,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+ classOutputFileBase(cd)+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
 
   writeXMLHeader(t);
   t << "  <compounddef id=\""
@@ -1627,13 +1679,13 @@ static void generateXMLForConcept(const ConceptDef *cd,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+cd->getOutputFileBase()+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
   writeXMLHeader(t);
   t << "  <compounddef id=\"" << cd->getOutputFileBase()
     << "\" kind=\"concept\">\n";
@@ -1672,13 +1724,13 @@ static void generateXMLForModule(const ModuleDef *mod,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+mod->getOutputFileBase()+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
   writeXMLHeader(t);
   t << "  <compounddef id=\"" << mod->getOutputFileBase()
     << "\" kind=\"module\">\n";
@@ -1737,13 +1789,13 @@ static void generateXMLForNamespace(const NamespaceDef *nd,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+nd->getOutputFileBase()+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
 
   writeXMLHeader(t);
   t << "  <compounddef id=\"" << nd->getOutputFileBase()
@@ -1815,13 +1867,13 @@ static void generateXMLForFile(FileDef *fd,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+fd->getOutputFileBase()+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
 
   writeXMLHeader(t);
   t << "  <compounddef id=\"" << fd->getOutputFileBase()
@@ -1927,13 +1979,13 @@ static void generateXMLForGroup(const GroupDef *gd,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+gd->getOutputFileBase()+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
 
   writeXMLHeader(t);
   t << "  <compounddef id=\""
@@ -1984,13 +2036,13 @@ static void generateXMLForDir(DirDef *dd,TextStream &ti)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+dd->getOutputFileBase()+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
 
   writeXMLHeader(t);
   t << "  <compounddef id=\""
@@ -2037,13 +2089,13 @@ static void generateXMLForPage(PageDef *pd,TextStream &ti,bool isExample)
 
   QCString outputDirectory = Config_getString(XML_OUTPUT);
   QCString fileName=outputDirectory+"/"+pageName+".xml";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
-  TextStream t(&f);
+  TextStream t(f.stream());
 
   writeXMLHeader(t);
   t << "  <compounddef id=\"" << pageName;
@@ -2171,14 +2223,14 @@ void generateXML()
   ResourceMgr::instance().copyResource("index.xsd",outputDirectory);
 
   QCString fileName=outputDirectory+"/compound.xsd";
-  std::ofstream f = Portable::openOutputStream(fileName);
+  XMLOutputFile f(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
   {
-    TextStream t(&f);
+    TextStream t(f.stream());
 
     // write compound.xsd, but replace special marker with the entities
     QCString compound_xsd = ResourceMgr::instance().getAsString("compound.xsd");
@@ -2207,14 +2259,14 @@ void generateXML()
   f.close();
 
   fileName=outputDirectory+"/doxyfile.xsd";
-  f = Portable::openOutputStream(fileName);
+  f.open(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
     return;
   }
   {
-    TextStream t(&f);
+    TextStream t(f.stream());
 
     // write doxyfile.xsd, but replace special marker with the entities
     QCString doxyfile_xsd = ResourceMgr::instance().getAsString("doxyfile.xsd");
@@ -2243,7 +2295,7 @@ void generateXML()
   f.close();
 
   fileName=outputDirectory+"/Doxyfile.xml";
-  f = Portable::openOutputStream(fileName);
+  f.open(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing\n",fileName.data());
@@ -2251,13 +2303,13 @@ void generateXML()
   }
   else
   {
-    TextStream t(&f);
+    TextStream t(f.stream());
     Config::writeXMLDoxyfile(t);
   }
   f.close();
 
   fileName=outputDirectory+"/index.xml";
-  f = Portable::openOutputStream(fileName);
+  f.open(fileName);
   if (!f.is_open())
   {
     err("Cannot open file %s for writing!\n",qPrint(fileName));
@@ -2265,7 +2317,7 @@ void generateXML()
   }
   else
   {
-    TextStream t(&f);
+    TextStream t(f.stream());
 
     // write index header
     t << "<?xml version='1.0' encoding='UTF-8' standalone='no'?>\n";
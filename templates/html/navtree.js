@@ -72,6 +72,17 @@ function initNavTree(toroot,relpath) {
     return Cookie.readSetting(NAVPATH_COOKIE_NAME,'');
   }
 
+  // returns the index of the navtreeindex file holding the entries for page url,
+  // must match navIndexShard() in ftvhelp.cpp (32-bit FNV-1a of the UTF-8 page name)
+  const navTreeShard = function(url) {
+    const bytes = new TextEncoder().encode(url.split('#')[0]);
+    let h = 0x811c9dc5;
+    for (let i=0;i<bytes.length;i++) {
+      h = Math.imul(h^bytes[i],0x01000193)>>>0;
+    }
+    return h % NAVTREEINDEXSHARDS;
+  }
+
   const getScript = function(scriptName,func) {
     const head = document.getElementsByTagName("head")[0];
     const script = document.createElement('script');
@@ -384,10 +395,7 @@ function initNavTree(toroot,relpath) {
       glowEffect(anchor.parent(),1000); // line number
       hash=''; // strip line number anchors
     }
-    const url=root+hash;
-    let i=-1;
-    while (NAVTREEINDEX[i+1]<=url) i++;
-    if (i==-1) { i=0; root=NAVTREE[0][1]; } // fallback: show index
+    const i=navTreeShard(root);
     if (navTreeSubIndices[i]) {
       gotoNode(o,i,root,hash,relpath)
     } else {
@@ -0,0 +1,16 @@
+// objective: test that a comment block whose parsing stops early does not affect the next one
+// check: class_truncated.xml
+// check: class_normal.xml
+
+/** \section
+ *  Title
+ *
+ *  This paragraph is never parsed.
+ */
+class Truncated {};
+
+/** A plain class.
+ *
+ *  More details about this class.
+ */
+class Normal {};
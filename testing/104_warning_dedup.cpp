@@ -0,0 +1,14 @@
+// objective: test that an identical warning is reported only once
+// check: namespacens.xml
+// warnings: warnings.log
+// config: XML_NS_MEMB_FILE_SCOPE=YES
+
+/** @file */
+
+/** @brief A namespace. */
+namespace ns {
+
+/** @brief Uses @ref no_such_label for details. */
+void func();
+
+}
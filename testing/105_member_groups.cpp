@@ -0,0 +1,26 @@
+// objective: test member groups of a namespace that is spread over several input files
+// input: more_105_b.cpp
+// check: namespacens.xml
+
+/** @brief A namespace with member groups. */
+namespace ns {
+
+/** \name Conversion functions
+ *  \{
+ */
+
+/** Converts to text. */
+void toText();
+
+/** \} */
+
+/** \name Checks
+ *  \{
+ */
+
+/** Checks the input. */
+void checkInput();
+
+/** \} */
+
+}
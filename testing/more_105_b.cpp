@@ -0,0 +1,21 @@
+namespace ns {
+
+/** \name Conversion functions
+ *  \{
+ */
+
+/** Converts from text. */
+void fromText();
+
+/** \} */
+
+/** @{ */
+
+/** Resets the state. */
+void resetState();
+/** Clears the state. */
+void clearState();
+
+/** @} */
+
+}
@@ -84,6 +84,16 @@ class Tester:
                 return (True,'Difference between generated output and reference:\n%s' % diff)
         return (False,'')
 
+    def write_warnings(self,warn_file):
+        # write the warnings in canonical form, i.e. with file names relative to the input directory
+        warnings = xopen(self.test_out + "/warnings.log",'r',encoding='ISO-8859-1').read()
+        for inputdir in (os.path.realpath(self.args.inputdir),os.path.abspath(self.args.inputdir)):
+            warnings = warnings.replace(inputdir.replace('\\','/')+'/','')
+        out_file='%s/%s' % (self.test_out,warn_file)
+        with xopen(out_file,'w') as f:
+            print(warnings,end='',file=f)
+        return out_file
+
     def cleanup_xmllint(self,errmsg):
         msg = errmsg.split('\n')
         rtnmsg = ""
@@ -180,6 +190,9 @@ class Tester:
                 print('CREATE_SUBDIRS=YES', file=f)
             if (self.args.clang):
                 print('CLANG_ASSISTED_PARSING=YES', file=f)
+            if (self.args.shards):
+                # the shard files are written to the output directory
+                print('OUTPUT_DIRECTORY=%s' % self.test_out, file=f)
             if (self.args.cfgs):
                 for cfg in self.args.cfgs:
                     if cfg[0].find('=') == -1:
@@ -200,9 +213,23 @@ class Tester:
         if (self.args.noredir):
             redir=''
 
-        if os.system('%s %s %s/Doxyfile %s' % (self.args.doxygen,self.args.doxygen_dbg,self.test_out,redir))!=0:
-            print('Error: failed to run %s on %s/Doxyfile' % (self.args.doxygen,self.test_out))
-            sys.exit(1)
+        if (self.args.shards):
+            # parse the input in shards and link them, each run overwrites the warnings log,
+            # so collect the warnings of the runs in order
+            runs = ['--shard %d/%d' % (i,self.args.shards) for i in range(self.args.shards)]
+            runs.append('--link-shards %d' % self.args.shards)
+        else:
+            runs = ['']
+        warnings = ''
+        for run in runs:
+            if os.system('%s %s %s %s/Doxyfile %s' % (self.args.doxygen,self.args.doxygen_dbg,run,self.test_out,redir))!=0:
+                print('Error: failed to run %s %s on %s/Doxyfile' % (self.args.doxygen,run,self.test_out))
+                sys.exit(1)
+            if len(runs)>1 and os.path.isfile(self.test_out + "/warnings.log"):
+                warnings += xopen(self.test_out + "/warnings.log",'r',encoding='ISO-8859-1').read()
+        if len(runs)>1:
+            with xopen(self.test_out + "/warnings.log",'w',encoding='ISO-8859-1') as f:
+                print(warnings,end='',file=f)
 
 
     def check_link_rtf_file(self,fil):
@@ -263,6 +290,8 @@ class Tester:
                 out_file='%s/%s' % (self.test_out,check)
                 with xopen(out_file,'w') as f:
                     print(data,file=f)
+        if 'warnings' in self.config:
+            self.write_warnings(self.config['warnings'][0])
         shutil.rmtree(self.test_out+'/out',ignore_errors=True)
         os.remove(self.test_out+'/Doxyfile')
         return True
@@ -523,10 +552,18 @@ class Tester:
             elif not self.args.keep:
                 shutil.rmtree(latex_output,ignore_errors=True)
 
-        warnings = xopen(self.test_out + "/warnings.log",'r',encoding='ISO-8859-1').read()
-        failed_warn =  len(warnings)!=0
-        if failed_warn:
-            msg += (warnings,)
+        if 'warnings' in self.config:
+            warn_file = self.config['warnings'][0]
+            out_file = self.write_warnings(warn_file)
+            ref_file='%s/%s/%s' % (self.args.inputdir,self.test_id,warn_file)
+            (failed_warn,warn_msg) = self.compare_ok(out_file,ref_file,self.test_name)
+            if failed_warn:
+                msg += (warn_msg,)
+        else:
+            warnings = xopen(self.test_out + "/warnings.log",'r',encoding='ISO-8859-1').read()
+            failed_warn =  len(warnings)!=0
+            if failed_warn:
+                msg += (warnings,)
 
         if failed_warn or failed_xml or failed_html or failed_qhp or failed_latex or failed_docbook or failed_rtf or failed_xmlxsd:
             testmgr.ok(False,self.test_name,msg)
@@ -663,6 +700,9 @@ def main():
         action="store_true")
     parser.add_argument('--keep',help='keep result directories',
         action="store_true")
+    parser.add_argument('--shards',default=0,type=int,help=
+        'parse the input with the given number of --shard runs and combine them '
+        'with --link-shards, the output is compared with the same reference files')
     parser.add_argument('--cfg',nargs='+',dest='cfgs',action='append',help=
         'run test with extra doxygen configuration settings '
         '(the option may be specified multiple times)')
@@ -676,6 +716,8 @@ def main():
         args.xml=True
     if (not args.updateref is None) and (args.ids is None) and (args.all is None):
         parser.error('--updateref requires either --id or --all')
+    if args.updateref and args.shards:
+        parser.error('--updateref cannot be combined with --shards')
 
     starting_directory = os.getcwd()
     os.chdir(args.inputdir)